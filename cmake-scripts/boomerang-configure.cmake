@@ -13,6 +13,10 @@ option(BOOMERANG_BUILD_GUI              "Build the GUI. Requires Qt5Widgets." ON
 option(BOOMERANG_BUILD_CLI              "Build the command line interface." ON)
 option(BOOMERANG_BUILD_UNIT_TESTS       "Build the unit tests. Requires Qt5Test." OFF)
 
+if (BOOMERANG_BUILD_UNIT_TESTS)
+    option(BOOMERANG_BUILD_BENCHMARKS "Build the benchmarks. Requires Python 3." OFF)
+endif (BOOMERANG_BUILD_UNIT_TESTS)
+
 if (BOOMERANG_BUILD_CLI)
     option(BOOMERANG_BUILD_REGRESSION_TESTS "Build the regression tests. Requires Python 3." OFF)
 endif (BOOMERANG_BUILD_CLI)
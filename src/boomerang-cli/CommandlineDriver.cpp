@@ -10,14 +10,29 @@
 #include "CommandlineDriver.h"
 
 #include "boomerang/core/Settings.h"
+#include "boomerang/core/plugin/Plugin.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/ifc/ISymbolProvider.h"
 #include "boomerang/util/CFGDotWriter.h"
+#include "boomerang/util/log/FileLogSink.h"
 #include "boomerang/util/log/Log.h"
 
 #include <QCoreApplication>
 #include <QTextStream>
 
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <map>
+
+#ifndef _WIN32
+#    include <sys/resource.h>
+#    include <sys/wait.h>
+
+#    include <cerrno>
+#    include <csignal>
+#    include <unistd.h>
+#endif
 
 
 Q_DECLARE_METATYPE(Address)
@@ -26,9 +41,13 @@ Q_DECLARE_METATYPE(Address)
 CommandlineDriver::CommandlineDriver(QObject *_parent)
     : QObject(_parent)
     , m_project(new Project())
-    , m_kill_timer(this)
 {
-    this->connect(&m_kill_timer, &QTimer::timeout, this, &CommandlineDriver::onCompilationTimeout);
+}
+
+
+CommandlineDriver::~CommandlineDriver()
+{
+    stopWatchdog();
 }
 
 
@@ -42,6 +61,7 @@ static void help()
 "Usage:\n"
 "  boomerang-cli [ switches ] [ -- ] program\n"
 "  boomerang-cli -i [ command_file ]\n"
+"  boomerang-cli [ switches ] --batch ( <directory> | - )\n"
 "  boomerang-cli ( -h | --help | --version )\n"
 "\n"
 "\n"
@@ -55,9 +75,35 @@ static void help()
 "  -e <addr>        : Decode or decompile the procedure beginning at addr, and callees\n"
 "  -E <addr>        : Equivalent to -nc -e <addr>\n"
 "  -ic              : Decode through type 0 Indirect Calls\n"
-"  -S <min>         : Stop decompilation after specified number of minutes\n"
+"  -S <min>         : Stop analysing procedures after <min> minutes and generate code\n"
+"                     for what has been decompiled so far; exit if decompilation takes\n"
+"                     more than twice as long\n"
+"  --proc-time <s>  : Stop analysing a single procedure after <s> seconds (0 = no limit)\n"
+"  --proc-passes <n>: Stop analysing a single procedure after <n> passes (0 = no limit)\n"
+"  --proc-stmts <n> : Only do basic analysis for procedures with more than <n> statements\n"
+"                     (0 = no limit)\n"
+"  --tier <n>       : Analysis tier: 0 = only lift, SSA and propagation for quick results\n"
+"                     (refine single procedures in interactive mode), 1 = full (default)\n"
 "  -t               : Trace (print address of) every instruction decoded\n"
 "  -a               : Assume ABI compliance\n"
+"  --proof-steps <n>: Give up proving a preservation after <n> steps (0 = no limit)\n"
+"  --stream         : Generate code for procedures as soon as they are decompiled,\n"
+"                     freeing their IR. Reduces memory usage; implies -nR\n"
+"  --threads <n>    : Use <n> threads for the late analysis of procedures\n"
+"                     (default: number of hardware threads)\n"
+"  --insn-retention <keep|decompiled|lifted>\n"
+"                   : When to free the decoded machine instructions of a procedure\n"
+"                     (default keep). Freed instructions are decoded again on demand\n"
+"\n"
+"Batch mode\n"
+"  --batch <dir>    : Decompile all files in <dir>. Output for each file is written to\n"
+"                     a subdirectory of the output directory named after the file\n"
+"  --batch -        : Like --batch <dir>, but read the paths of the files from stdin\n"
+"                     (one per line) until stdin is closed\n"
+"  --jobs <n>       : Decompile up to <n> files at the same time (default 1)\n"
+"  --job-mem <MiB>  : Abort a job if it uses more than <MiB> MiB of memory (0 = no limit)\n"
+"                     -S applies to each job separately in batch mode; jobs exceeding\n"
+"                     twice the time given by -S are aborted\n"
 "\n"
 "Output\n"
 "  --version        : Print version information and exit\n"
@@ -363,6 +409,159 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
 
             continue;
         }
+        else if (arg == "--proof-steps") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            bool converted                           = false;
+            m_project->getSettings()->proofStepLimit = args[i].toInt(&converted, 0);
+
+            if (!converted || m_project->getSettings()->proofStepLimit < 0) {
+                std::cerr << "'--proof-steps': Bad argument '" << args[i].toStdString()
+                          << "' (try --help)." << std::endl;
+                return 1;
+            }
+
+            continue;
+        }
+        else if (arg == "--stream") {
+            m_project->getSettings()->streamDecompilation = true;
+            m_project->getSettings()->removeReturns       = false;
+            continue;
+        }
+        else if (arg == "--tier") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            if (args[i] == "0") {
+                m_project->getSettings()->decompileTier = DecompileTier::Quick;
+            }
+            else if (args[i] == "1") {
+                m_project->getSettings()->decompileTier = DecompileTier::Full;
+            }
+            else {
+                std::cerr << "'--tier': Bad argument '" << args[i].toStdString()
+                          << "' (try --help)." << std::endl;
+                return 1;
+            }
+
+            continue;
+        }
+        else if (arg == "--threads") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            bool converted = false;
+            const int num  = args[i].toInt(&converted, 0);
+
+            if (!converted || num < 1) {
+                std::cerr << "'--threads': Bad argument '" << args[i].toStdString()
+                          << "' (try --help)." << std::endl;
+                return 1;
+            }
+
+            m_project->getSettings()->numThreads = num;
+            continue;
+        }
+        else if (arg == "--insn-retention") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            if (args[i] == "keep") {
+                m_project->getSettings()->insnRetention = InsnRetention::Keep;
+            }
+            else if (args[i] == "decompiled") {
+                m_project->getSettings()->insnRetention = InsnRetention::AfterDecompile;
+            }
+            else if (args[i] == "lifted") {
+                m_project->getSettings()->insnRetention = InsnRetention::AfterLift;
+            }
+            else {
+                std::cerr << "'--insn-retention': Bad argument '" << args[i].toStdString()
+                          << "' (try --help)." << std::endl;
+                return 1;
+            }
+
+            continue;
+        }
+        else if (arg == "--batch") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            m_batchSource = args[i];
+            continue;
+        }
+        else if (arg == "--jobs") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            bool converted    = false;
+            m_numBatchWorkers = args[i].toInt(&converted, 0);
+
+            if (!converted || m_numBatchWorkers < 1) {
+                std::cerr << "'--jobs': Bad argument '" << args[i].toStdString()
+                          << "' (try --help)." << std::endl;
+                return 1;
+            }
+
+            continue;
+        }
+        else if (arg == "--job-mem") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            bool converted = false;
+            m_jobMemLimit  = args[i].toInt(&converted, 0);
+
+            if (!converted || m_jobMemLimit < 0) {
+                std::cerr << "'--job-mem': Bad argument '" << args[i].toStdString()
+                          << "' (try --help)." << std::endl;
+                return 1;
+            }
+
+            continue;
+        }
+        else if (arg == "--proc-time" || arg == "--proc-passes" || arg == "--proc-stmts") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            bool converted  = false;
+            const int limit = args[i].toInt(&converted, 0);
+
+            if (!converted || limit < 0) {
+                std::cerr << "'" << arg.toStdString() << "': Bad argument '"
+                          << args[i].toStdString() << "' (try --help)." << std::endl;
+                return 1;
+            }
+
+            if (arg == "--proc-time") {
+                m_project->getSettings()->procTimeLimit = limit;
+            }
+            else if (arg == "--proc-passes") {
+                m_project->getSettings()->procPassLimit = limit;
+            }
+            else {
+                m_project->getSettings()->procStmtLimit = limit;
+            }
+
+            continue;
+        }
         else if (arg == "-S") {
             if (++i == args.size()) {
                 help();
@@ -378,6 +577,7 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
                 return 1;
             }
 
+            m_project->getSettings()->decompileTimeLimit = 60 * std::max(minsToStopAfter, 0);
             continue;
         }
         else if (arg == "--") {
@@ -435,6 +635,14 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
     if (interactiveMode) {
         return interactiveMain();
     }
+    else if (isBatchMode()) {
+        if (binaryPath != "") {
+            help();
+            return 1;
+        }
+
+        return 0;
+    }
     else if (binaryPath == "") {
         help();
         return 1;
@@ -442,8 +650,6 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
 
     if (minsToStopAfter > 0) {
         LOG_MSG("Stopping decompile after %1 minutes", minsToStopAfter);
-        m_kill_timer.setSingleShot(true);
-        m_kill_timer.start(1000 * 60 * minsToStopAfter);
     }
 
     m_pathToBinary = binaryPath;
@@ -486,21 +692,310 @@ int CommandlineDriver::interactiveMain()
 
 int CommandlineDriver::decompile()
 {
+    if (isBatchMode()) {
+        return decompileBatch();
+    }
+
     Log::getOrCreateLog().addDefaultLogSinks(
         m_project->getSettings()->getOutputDirectory().absolutePath());
+    Log::getOrCreateLog().setAsync(true);
     m_project->loadPlugins();
 
     QDir wd       = m_project->getSettings()->getWorkingDirectory();
     QFileInfo inf = QFileInfo(wd.absoluteFilePath(m_pathToBinary));
 
-    return decompile(inf.absoluteFilePath(), inf.baseName());
+    if (minsToStopAfter > 0) {
+        // Give the decompiler time to generate code for what it has decompiled so far
+        startWatchdog(std::chrono::minutes(2 * minsToStopAfter));
+    }
+
+    const int result = decompile(inf.absoluteFilePath(), inf.baseName());
+    stopWatchdog();
+    return result;
+}
+
+
+void CommandlineDriver::startWatchdog(std::chrono::seconds timeout)
+{
+    stopWatchdog();
+    m_watchdogStopped = false;
+
+    m_watchdog = std::thread([this, timeout]() {
+        std::unique_lock<std::mutex> lock(m_watchdogMutex);
+
+        if (m_watchdogCond.wait_for(lock, timeout, [this]() { return m_watchdogStopped; })) {
+            return;
+        }
+
+        LOG_ERROR("Decompilation timed out, Boomerang will now exit");
+        Log::getOrCreateLog().flush();
+        std::_Exit(1);
+    });
+}
+
+
+void CommandlineDriver::stopWatchdog()
+{
+    if (!m_watchdog.joinable()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_watchdogMutex);
+        m_watchdogStopped = true;
+    }
+
+    m_watchdogCond.notify_all();
+    m_watchdog.join();
+}
+
+
+int CommandlineDriver::decompileBatch()
+{
+    const QDir outputDir = m_project->getSettings()->getOutputDirectory();
+
+    // The background thread of the asynchronous log writer does not survive fork(),
+    // so the batch log is written synchronously. Workers switch to their own log file.
+    Log::getOrCreateLog().addDefaultLogSinks(outputDir.absolutePath());
+    m_project->loadPlugins();
+
+    if (m_batchSource != "-") {
+        const QDir batchDir(
+            m_project->getSettings()->getWorkingDirectory().absoluteFilePath(m_batchSource));
+
+        if (!batchDir.exists()) {
+            LOG_ERROR("Batch directory '%1' does not exist", batchDir.absolutePath());
+            return 1;
+        }
+
+        for (const QFileInfo &inf : batchDir.entryInfoList(QDir::Files, QDir::Name)) {
+            m_batchDirJobs.append(inf.absoluteFilePath());
+        }
+    }
+
+    if (minsToStopAfter > 0) {
+        LOG_MSG("Stopping each job after %1 minutes", minsToStopAfter);
+    }
+
+    int numSucceeded = 0;
+    int numFailed    = 0;
+    QString binaryPath;
+
+#ifndef _WIN32
+    std::map<pid_t, QString> runningJobs;
+
+    // Wait until one of the workers exits
+    auto waitForWorker = [&]() {
+        int status = 0;
+        auto it    = runningJobs.end();
+
+        // Children that are not batch workers do not free a slot
+        while (it == runningJobs.end()) {
+            pid_t pid = -1;
+
+            do {
+                pid = waitpid(-1, &status, 0);
+            } while (pid == -1 && errno == EINTR);
+
+            if (pid == -1) {
+                LOG_ERROR("Lost track of %1 batch jobs", runningJobs.size());
+                numFailed += static_cast<int>(runningJobs.size());
+                runningJobs.clear();
+                return;
+            }
+
+            it = runningJobs.find(pid);
+        }
+
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+            LOG_MSG("Finished '%1'", it->second);
+            numSucceeded++;
+        }
+        else if (WIFSIGNALED(status) && WTERMSIG(status) == SIGALRM) {
+            LOG_WARN("Decompiling '%1' timed out", it->second);
+            numFailed++;
+        }
+        else if (WIFSIGNALED(status)) {
+            LOG_WARN("Decompiling '%1' was aborted by signal %2", it->second, WTERMSIG(status));
+            numFailed++;
+        }
+        else {
+            LOG_WARN("Decompiling '%1' failed with exit code %2", it->second,
+                     WEXITSTATUS(status));
+            numFailed++;
+        }
+
+        runningJobs.erase(it);
+    };
+
+    preloadLibraryCatalogues();
+
+    while (getNextBatchJob(binaryPath)) {
+        if (static_cast<int>(runningJobs.size()) >= m_numBatchWorkers) {
+            waitForWorker();
+        }
+
+        const QString jobOutputDir = getJobOutputDir(outputDir, binaryPath);
+
+        Log::getOrCreateLog().flush();
+        std::cout.flush();
+
+        const pid_t pid = fork();
+        if (pid == 0) {
+            // worker process
+            if (m_jobMemLimit > 0) {
+                const rlim_t limit = static_cast<rlim_t>(m_jobMemLimit) * 1024 * 1024;
+                const rlimit memLimit{ limit, limit };
+                setrlimit(RLIMIT_AS, &memLimit);
+            }
+
+            if (minsToStopAfter > 0) {
+                // The decompiler stops analysing procedures after minsToStopAfter by itself;
+                // this only catches jobs that get stuck in a single analysis step or in code
+                // generation.
+                alarm(2 * 60 * minsToStopAfter);
+            }
+
+            QDir().mkpath(jobOutputDir);
+
+            Log &log = Log::getOrCreateLog();
+            log.removeAllSinks();
+            log.addLogSink(std::make_unique<FileLogSink>(
+                QFileInfo(QDir(jobOutputDir), "boomerang.log").absoluteFilePath()));
+            log.setAsync(true);
+
+            const int result = runBatchJob(binaryPath, jobOutputDir);
+
+            log.setAsync(false);
+            log.flush();
+            _exit(result);
+        }
+        else if (pid == -1) {
+            LOG_ERROR("Cannot start worker process for '%1'", binaryPath);
+            numFailed++;
+            continue;
+        }
+
+        LOG_MSG("Decompiling '%1' (pid %2)", binaryPath, pid);
+        runningJobs[pid] = binaryPath;
+    }
+
+    while (!runningJobs.empty()) {
+        waitForWorker();
+    }
+#else
+    if (m_numBatchWorkers > 1 || m_jobMemLimit > 0) {
+        LOG_WARN("Worker processes are not supported on this platform; "
+                 "decompiling files sequentially without memory limit");
+    }
+
+    Log::getOrCreateLog().setAsync(true);
+
+    while (getNextBatchJob(binaryPath)) {
+        const QString jobOutputDir = getJobOutputDir(outputDir, binaryPath);
+        QDir().mkpath(jobOutputDir);
+
+        LOG_MSG("Decompiling '%1'", binaryPath);
+
+        if (runBatchJob(binaryPath, jobOutputDir) == 0) {
+            LOG_MSG("Finished '%1'", binaryPath);
+            numSucceeded++;
+        }
+        else {
+            LOG_WARN("Decompiling '%1' failed", binaryPath);
+            numFailed++;
+        }
+
+        m_project->unloadBinaryFile();
+    }
+#endif
+
+    LOG_MSG("Batch finished: %1 of %2 files decompiled successfully", numSucceeded,
+            numSucceeded + numFailed);
+
+    return numFailed == 0 ? 0 : 1;
+}
+
+
+bool CommandlineDriver::getNextBatchJob(QString &binaryPath)
+{
+    if (m_batchSource != "-") {
+        if (m_batchDirJobs.isEmpty()) {
+            return false;
+        }
+
+        binaryPath = m_batchDirJobs.takeFirst();
+        return true;
+    }
+
+    // QTextStream reads ahead, so the same stream has to be used for all jobs
+    static QTextStream queue(stdin);
+
+    while (!queue.atEnd()) {
+        const QString line = queue.readLine().trimmed();
+
+        if (line.isEmpty() || line.startsWith('#')) {
+            continue;
+        }
+
+        const QDir wd = m_project->getSettings()->getWorkingDirectory();
+        binaryPath    = QFileInfo(wd.absoluteFilePath(line)).absoluteFilePath();
+        return true;
+    }
+
+    return false;
+}
+
+
+void CommandlineDriver::preloadLibraryCatalogues()
+{
+    Plugin *plugin = m_project->getPluginManager()->getPluginByName("C Symbol Provider plugin");
+    if (!plugin) {
+        return;
+    }
+
+    LOG_MSG("Reading library signatures...");
+
+    ISymbolProvider *prov = plugin->getIfc<ISymbolProvider>();
+    const QDir dataDir    = m_project->getSettings()->getDataDirectory();
+
+    for (Machine machine : { Machine::X86, Machine::PPC, Machine::ST20 }) {
+        std::set<QString> catalogs;
+
+        for (LoadFmt format : { LoadFmt::ELF, LoadFmt::PE, LoadFmt::EXE, LoadFmt::MACHO,
+                                LoadFmt::LX, LoadFmt::ST20 }) {
+            for (const QString &catalog : Prog::getDefaultLibraryCatalogues(machine, format)) {
+                catalogs.insert(catalog);
+            }
+        }
+
+        for (const QString &catalog : catalogs) {
+            prov->preloadLibraryCatalog(machine, dataDir.absoluteFilePath(catalog));
+        }
+    }
 }
 
 
-void CommandlineDriver::onCompilationTimeout()
+QString CommandlineDriver::getJobOutputDir(const QDir &outputDir, const QString &binaryPath)
 {
-    LOG_WARN("Compilation timed out, Boomerang will now exit");
-    exit(1);
+    const QString fileName = QFileInfo(binaryPath).fileName();
+    QString dirName        = fileName;
+
+    for (int i = 2; m_jobDirNames.find(dirName) != m_jobDirNames.end(); ++i) {
+        dirName = QString("%1-%2").arg(fileName).arg(i);
+    }
+
+    m_jobDirNames.insert(dirName);
+    return outputDir.absoluteFilePath(dirName);
+}
+
+
+int CommandlineDriver::runBatchJob(const QString &binaryPath, const QString &outputDir)
+{
+    m_project->getSettings()->setOutputDirectory(outputDir + "/");
+
+    const QFileInfo inf(binaryPath);
+    return decompile(inf.absoluteFilePath(), inf.baseName());
 }
 
 
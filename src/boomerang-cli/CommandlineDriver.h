@@ -14,8 +14,15 @@
 
 #include "boomerang/core/Project.h"
 
+#include <QDir>
 #include <QObject>
-#include <QTimer>
+#include <QStringList>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
 
 
 class CommandlineDriver : public QObject
@@ -24,6 +31,7 @@ class CommandlineDriver : public QObject
 
 public:
     explicit CommandlineDriver(QObject *parent = nullptr);
+    ~CommandlineDriver() override;
 
 public:
     /**
@@ -41,6 +49,10 @@ public:
      */
     int decompile();
 
+    /// \returns true if \ref decompile will process a batch of binary files
+    /// instead of a single binary file.
+    bool isBatchMode() const { return !m_batchSource.isEmpty(); }
+
     /**
      * Displays a command line and processes the commands entered.
      *
@@ -70,14 +82,65 @@ private:
      */
     int decompile(const QString &fname, const QString &pname);
 
-public slots:
-    void onCompilationTimeout();
+    /**
+     * Decompile all binary files of the batch queue (see \ref m_batchSource).
+     * Plugins (including the instruction dictionaries of the decoders) and parsed
+     * library signatures are loaded only once and reused for all jobs.
+     * On POSIX systems each job runs in its own worker process, so a job that crashes,
+     * times out or exceeds its memory limit does not affect other jobs.
+     *
+     * \returns Zero if all jobs succeeded, nonzero otherwise.
+     */
+    int decompileBatch();
+
+    /**
+     * Get the next binary file from the batch queue.
+     * \returns false if the queue is exhausted.
+     */
+    bool getNextBatchJob(QString &binaryPath);
+
+    /**
+     * Parse the default library signature catalogs of all supported machines,
+     * so that the workers of a batch inherit the parsed signature files
+     * without the parent having to load the binary files.
+     */
+    void preloadLibraryCatalogues();
+
+    /// \returns the output directory for the batch job decompiling \p binaryPath.
+    /// The directory is named after the binary file, and is numbered if several jobs
+    /// decompile files with the same name.
+    QString getJobOutputDir(const QDir &outputDir, const QString &binaryPath);
+
+    /// Decompile the binary file of a single batch job, writing the output to \p outputDir.
+    /// \returns Zero on success, nonzero on failure.
+    int runBatchJob(const QString &binaryPath, const QString &outputDir);
+
+    /**
+     * Start a thread that exits the program if \ref stopWatchdog is not called
+     * within \p timeout. This is the hard stop for -S; the decompiler itself stops
+     * analysing procedures after the time given by -S (see Settings::decompileTimeLimit),
+     * but it cannot interrupt a single analysis step or code generation.
+     */
+    void startWatchdog(std::chrono::seconds timeout);
+    void stopWatchdog();
 
 private:
     std::unique_ptr<Project> m_project;
     std::unique_ptr<Console> m_console;
 
-    QTimer m_kill_timer;
     int minsToStopAfter = 0;
     QString m_pathToBinary;
+
+    /// Directory containing the binary files to decompile in batch mode,
+    /// or "-" to read the paths of the binary files from stdin (one per line).
+    QString m_batchSource;
+    QStringList m_batchDirJobs; ///< Remaining jobs if m_batchSource is a directory
+    int m_numBatchWorkers = 1;  ///< Maximum number of jobs running at the same time
+    int m_jobMemLimit     = 0;  ///< Address space limit per job in MiB (0 = no limit)
+    std::set<QString> m_jobDirNames; ///< Names of the output directories used by batch jobs
+
+    std::thread m_watchdog;
+    std::mutex m_watchdogMutex;
+    std::condition_variable m_watchdogCond;
+    bool m_watchdogStopped = false; ///< Set by stopWatchdog(), guarded by m_watchdogMutex
 };
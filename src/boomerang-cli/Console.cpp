@@ -44,6 +44,7 @@ Console::Console(Project *project)
     m_commandTypes["help"]      = CT_help;
     m_commandTypes["replay"]    = CT_replay;
     m_commandTypes["print"]     = CT_print;
+    m_commandTypes["refine"]    = CT_refine;
 }
 
 
@@ -159,6 +160,7 @@ CommandStatus Console::processCommand(const QString &command, const QStringList
     switch (commandNameToType(command)) {
     case CT_decode: return handleDecode(args);
     case CT_decompile: return handleDecompile(args);
+    case CT_refine: return handleRefine(args);
     case CT_codegen: return handleCodegen(args);
     case CT_replay: return handleReplay(args);
     case CT_move: return handleMove(args);
@@ -259,6 +261,48 @@ CommandStatus Console::handleDecompile(const QStringList &args)
 }
 
 
+CommandStatus Console::handleRefine(const QStringList &args)
+{
+    if (args.empty()) {
+        std::cerr << "Wrong number of arguments for command; Expected at least 1, got 0."
+                  << std::endl;
+        return CommandStatus::ParseError;
+    }
+    else if (!m_project->isBinaryLoaded()) {
+        std::cerr << "Cannot refine: Need to 'decode' a program first.\n";
+        return CommandStatus::Failure;
+    }
+
+    Prog *prog = m_project->getProg();
+    assert(prog != nullptr);
+
+    ProcSet procSet;
+
+    for (const QString &procName : args) {
+        Function *proc = prog->getFunctionByName(procName);
+
+        if (proc == nullptr) {
+            std::cerr << "Cannot find function '" << procName.toStdString() << "'\n";
+            return CommandStatus::Failure;
+        }
+        else if (proc->isLib()) {
+            std::cerr << "Cannot refine library function '" << procName.toStdString() << "'\n";
+            return CommandStatus::Failure;
+        }
+
+        procSet.insert(static_cast<UserProc *>(proc));
+    }
+
+    for (UserProc *userProc : procSet) {
+        if (!m_project->refineProc(userProc)) {
+            return CommandStatus::Failure;
+        }
+    }
+
+    return CommandStatus::Success;
+}
+
+
 CommandStatus Console::handleCodegen(const QStringList &args)
 {
     Prog *prog = m_project->getProg();
@@ -871,6 +915,8 @@ CommandStatus Console::handleHelp(const QStringList &args)
            "  decode <file>                      : Loads and decodes the specified binary.\n"
            "  decompile [<proc1> [<proc2>...]]   : Decompiles the program or specified "
            "function(s).\n"
+           "  refine <proc1> [<proc2>...]        : Decompiles the specified function(s) again with "
+           "all analyses.\n"
            "  codegen [<module1> [<module2>...]] : Generates code for the program or a specified "
            "module.\n"
            "  info prog                          : Print information about the program.\n"
@@ -42,7 +42,8 @@ enum CommandType
     CT_info      = 11,
     CT_exit      = 12,
     CT_help      = 13,
-    CT_replay    = 14
+    CT_replay    = 14,
+    CT_refine    = 15
 };
 
 
@@ -81,6 +82,7 @@ private:
 private:
     CommandStatus handleDecode(const QStringList &args);
     CommandStatus handleDecompile(const QStringList &args);
+    CommandStatus handleRefine(const QStringList &args);
     CommandStatus handleCodegen(const QStringList &args);
     CommandStatus handleReplay(const QStringList &args);
     CommandStatus handleMove(const QStringList &args);
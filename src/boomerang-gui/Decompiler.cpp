@@ -25,7 +25,7 @@
 #include "boomerang/ssl/type/NamedType.h"
 #include "boomerang/util/log/Log.h"
 
-#include <QThread>
+#include <QMutexLocker>
 
 
 Decompiler::Decompiler()
@@ -246,11 +246,12 @@ void Decompiler::onDecompileDebugPoint(UserProc *proc, const char *description)
     LOG_VERBOSE("%1: %2", proc->getName(), description);
 
     if (m_debugging) {
+        QMutexLocker lock(&m_debugMutex);
         m_waiting = true;
         emit debugPointHit(proc->getName(), description);
 
         while (m_waiting) {
-            QThread::yieldCurrentThread();
+            m_debugResumed.wait(&m_debugMutex);
         }
     }
 }
@@ -258,7 +259,9 @@ void Decompiler::onDecompileDebugPoint(UserProc *proc, const char *description)
 
 void Decompiler::stopWaiting()
 {
+    QMutexLocker lock(&m_debugMutex);
     m_waiting = false;
+    m_debugResumed.wakeAll();
 }
 
 
@@ -297,6 +300,19 @@ void Decompiler::renameProc(const QString &oldName, const QString &newName)
 }
 
 
+void Decompiler::refineProc(const QString &name)
+{
+    Function *proc = m_project.getProg() ? m_project.getProg()->getFunctionByName(name) : nullptr;
+
+    if (!proc || proc->isLib()) {
+        LOG_WARN("Cannot refine procedure '%1'", name);
+        return;
+    }
+
+    m_project.refineProc(static_cast<UserProc *>(proc));
+}
+
+
 void Decompiler::getCompoundMembers(const QString &name, QTableWidget *tbl)
 {
     auto ty = NamedType::getNamedType(name);
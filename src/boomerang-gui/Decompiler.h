@@ -12,9 +12,11 @@
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Watcher.h"
 
+#include <QMutex>
 #include <QObject>
 #include <QString>
 #include <QTableWidget>
+#include <QWaitCondition>
 
 
 class Module;
@@ -91,6 +93,10 @@ public:
     QString getSigFilePath(const QString &name);
     QString getClusterFile(const QString &name);
     void renameProc(const QString &oldName, const QString &newName);
+
+    /// Decompile a single procedure again with all analyses enabled.
+    void refineProc(const QString &name);
+
     void getCompoundMembers(const QString &name, QTableWidget *tbl);
 
     void setDebugEnabled(bool debug) { m_debugging = debug; }
@@ -104,6 +110,9 @@ protected:
     bool m_debugging = false;
     bool m_waiting   = false;
 
+    QMutex m_debugMutex;           ///< Protects m_waiting
+    QWaitCondition m_debugResumed; ///< Signalled when m_waiting is reset
+
     Project m_project;
 
     std::vector<Address> m_userEntrypoints;
@@ -15,6 +15,7 @@
 #include "boomerang-gui/ui_About.h"
 #include "boomerang-gui/ui_MainWindow.h"
 
+#include "boomerang/core/EventBus.h"
 #include "boomerang/ifc/ITypeRecovery.h"
 
 #include <QDesktopServices>
@@ -38,6 +39,10 @@ MainWindow::MainWindow(QWidget *_parent)
 
     m_decompilerThread.start();
 
+    m_decompiler->getProject()->getEventBus()->setListening(true);
+    connect(&m_eventTimer, &QTimer::timeout, this, &MainWindow::processDecompilerEvents);
+    m_eventTimer.start(100);
+
     connect(m_decompiler, &Decompiler::moduleCreated, this, &MainWindow::showNewCluster);
     connect(m_decompiler, &Decompiler::functionAddedToModule, this,
             &MainWindow::showNewProcInCluster);
@@ -137,6 +142,7 @@ MainWindow::MainWindow(QWidget *_parent)
 
 MainWindow::~MainWindow()
 {
+    m_eventTimer.stop();
     m_decompilerThread.quit();
     m_decompilerThread.wait();
 
@@ -655,6 +661,26 @@ void MainWindow::showNewProcInCluster(const QString &name, const QString &module
 }
 
 
+void MainWindow::processDecompilerEvents()
+{
+    m_decompiler->getProject()->getEventBus()->drain([this](const DecompEvent &event) {
+        switch (event.kind) {
+        case DecompEvent::Kind::DecodeProgress:
+        case DecompEvent::Kind::EndDecode:
+            statusBar()->showMessage(
+                tr("Decoded %1 instructions (%2 bytes)").arg(event.count).arg(event.numBytes));
+            break;
+
+        case DecompEvent::Kind::BadDecode:
+            statusBar()->showMessage(tr("Invalid instruction at %1").arg(event.addr.toString()));
+            break;
+
+        default: break;
+        }
+    });
+}
+
+
 void MainWindow::showDebuggingPoint(const QString &name, const QString &description)
 {
     QString msg = "debugging ";
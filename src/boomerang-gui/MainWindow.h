@@ -14,6 +14,7 @@
 
 #include <QMainWindow>
 #include <QThread>
+#include <QTimer>
 
 #include <map>
 #include <set>
@@ -115,6 +116,9 @@ public slots:
     void closeCurrentTab();
     void currentTabTextChanged();
 
+    /// Show progress reported on the event bus of the decompiler.
+    void processDecompilerEvents();
+
 protected:
     void showInitPage();
     void saveSettings();
@@ -127,6 +131,7 @@ private:
 
     QThread m_decompilerThread;
     Decompiler *m_decompiler = nullptr;
+    QTimer m_eventTimer; ///< Polls the event bus of the decompiler
 
     bool m_loadingSettings   = false;
     int m_numDecompiledProcs = 0;
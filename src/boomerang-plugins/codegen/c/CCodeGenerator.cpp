@@ -11,11 +11,13 @@
 
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
+#include "boomerang/db/Global.h"
 #include "boomerang/db/IRFragment.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/module/Module.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/db/signature/Signature.h"
+#include "boomerang/decomp/ProcFinalizer.h"
 #include "boomerang/passes/PassManager.h"
 #include "boomerang/ssl/RTL.h"
 #include "boomerang/ssl/Register.h"
@@ -53,6 +55,47 @@ CCodeGenerator::CCodeGenerator(Project *project)
 void CCodeGenerator::generateCode(const Prog *prog, Module *cluster, UserProc *proc,
                                   bool /*intermixRTL*/)
 {
+    if (proc != nullptr) {
+        // Only declare the procedures needed by proc, and only once per output file.
+        // Code for proc is appended to the output of its module.
+        Module *module                       = proc->getModule();
+        std::set<const UserProc *> &declared = m_declaredProcs[module];
+
+        for (Function *callee : proc->getCallees()) {
+            if (!callee->isLib() && declared.insert(static_cast<UserProc *>(callee)).second) {
+                addPrototype(static_cast<UserProc *>(callee));
+            }
+        }
+
+        if (declared.insert(proc).second) {
+            addPrototype(proc);
+        }
+
+        // The globals are only defined after the code for all procedures
+        // has been generated (\sa generateGlobals), so declare them here.
+        QSet<QString> usedGlobals;
+        ProcFinalizer::findUsedGlobals(proc, usedGlobals);
+
+        std::set<QString> &declaredGlobals = m_declaredGlobals[module];
+        for (const QString &name : std::set<QString>(usedGlobals.begin(), usedGlobals.end())) {
+            const Global *global = prog->getGlobalByName(name);
+
+            if (global && declaredGlobals.insert(name).second) {
+                addGlobal(name, global->getType(), nullptr, true);
+            }
+        }
+
+        appendLine("");
+        print(module);
+
+        if (proc->isDecoded()) {
+            generateCode(proc);
+            print(module);
+        }
+
+        return;
+    }
+
     const bool generate_all = cluster == nullptr || cluster == prog->getRootModule();
     bool all_procedures     = (proc == nullptr);
 
@@ -116,6 +159,20 @@ void CCodeGenerator::generateCode(const Prog *prog, Module *cluster, UserProc *p
 }
 
 
+void CCodeGenerator::generateGlobals(const Prog *prog)
+{
+    if (prog->getGlobals().empty()) {
+        return;
+    }
+
+    for (auto &elem : prog->getGlobals()) {
+        addGlobal(elem->getName(), elem->getType(), elem->getInitialValue());
+    }
+
+    print(prog->getRootModule());
+}
+
+
 void CCodeGenerator::addAssignmentStatement(const std::shared_ptr<const Assign> &asgn)
 {
     // Gerard: shouldn't these  3 types of statements be removed earlier?
@@ -880,6 +937,12 @@ void CCodeGenerator::addProcStart(UserProc *proc)
 
     s << "/** address: " << proc->getEntryAddress() << " */";
     appendLine(tgt);
+
+    if (proc->isAnalysisIncomplete()) {
+        addLineComment("Analysis of this procedure is incomplete (" +
+                       proc->getIncompleteReason() + "); the code below may be inaccurate.");
+    }
+
     addFunctionSignature(proc, true);
 }
 
@@ -925,11 +988,16 @@ void CCodeGenerator::addLocal(const QString &name, SharedType type, bool last)
 }
 
 
-void CCodeGenerator::addGlobal(const QString &name, SharedType type, const SharedExp &init)
+void CCodeGenerator::addGlobal(const QString &name, SharedType type, const SharedExp &init,
+                               bool isExtern)
 {
     QString tgt;
     OStream s(&tgt);
 
+    if (isExtern) {
+        s << "extern ";
+    }
+
     // Check for array types. These are declared differently in C than
     // they are printed
     if (type->isArray()) {
@@ -957,7 +1025,7 @@ void CCodeGenerator::addGlobal(const QString &name, SharedType type, const Share
         s << " " << name;
     }
 
-    if (init && !init->isNil()) {
+    if (init && !init->isNil() && !isExtern) {
         s << " = ";
         SharedType base_type = type->isArray() ? type->as<ArrayType>()->getBaseType() : type;
         appendExp(s, init, OpPrec::Assign,
@@ -2777,10 +2845,9 @@ CCodeGenerator::computeOptimalCaseOrdering(const IRFragment *caseHead, const Swi
         SharedExp caseVal;
         if (psi->switchType == SwitchType::F) { // "Fortran" style?
             // Yes, use the table value itself
-            caseVal = Const::get(reinterpret_cast<int *>(psi->tableAddr.value())[i]);
+            caseVal = Const::get(psi->destValues[i]);
         }
         else {
-            // Note that uTable has the address of an int array
             caseVal = Const::get(static_cast<int>(psi->lowerBound + i));
         }
 
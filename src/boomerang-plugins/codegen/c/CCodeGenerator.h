@@ -23,6 +23,7 @@
 
 #include <list>
 #include <map>
+#include <set>
 #include <unordered_set>
 
 
@@ -97,6 +98,9 @@ public:
     virtual void generateCode(const Prog *prog, Module *module = nullptr, UserProc *proc = nullptr,
                               bool intermixRTL = false) override;
 
+    /// \copydoc ICodeGenerator::generateGlobals
+    virtual void generateGlobals(const Prog *prog) override;
+
 private:
     /// Add an assignment statement at the current position.
     void addAssignmentStatement(const std::shared_ptr<const Assign> &assign);
@@ -244,8 +248,10 @@ private:
      * \param name given name for the global
      * \param type The type of the global
      * \param init The initial value of the global.
+     * \param isExtern Only declare the global as \c extern, without initial value.
      */
-    void addGlobal(const QString &name, SharedType type, const SharedExp &init = nullptr);
+    void addGlobal(const QString &name, SharedType type, const SharedExp &init = nullptr,
+                   bool isExtern = false);
 
     /// Adds one line of comment to the code.
     void addLineComment(const QString &cmt);
@@ -340,6 +346,14 @@ private:
     UserProc *m_proc = nullptr;
     ControlFlowAnalyzer m_analyzer;
 
+    /// Procedures already declared in the output file of each module
+    /// when generating code for single procedures.
+    std::map<const Module *, std::set<const UserProc *>> m_declaredProcs;
+
+    /// Names of the globals already declared \c extern in the output file of each module
+    /// when generating code for single procedures.
+    std::map<const Module *, std::set<QString>> m_declaredGlobals;
+
     CodeWriter m_writer;
     QStringList m_lines; ///< The generated code.
 };
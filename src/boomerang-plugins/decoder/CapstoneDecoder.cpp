@@ -19,16 +19,21 @@
 #include "boomerang/ssl/statements/CaseStatement.h"
 #include "boomerang/util/log/Log.h"
 
+#include <atomic>
+
+
+static std::atomic<int> g_nextDecoderID(0);
+
 
 CapstoneDecoder::CapstoneDecoder(Project *project, cs::cs_arch arch, cs::cs_mode mode,
                                  const QString &sslFileName)
     : IDecoder(project)
     , m_dict(project->getSettings()->debugDecoder)
     , m_debugMode(project->getSettings()->debugDecoder)
+    , m_id(g_nextDecoderID++)
+    , m_arch(arch)
+    , m_mode(mode)
 {
-    cs::cs_open(arch, mode, &m_handle);
-    cs::cs_option(m_handle, cs::CS_OPT_DETAIL, cs::CS_OPT_ON);
-
     const Settings *settings = project->getSettings();
     QString realSSLFileName;
 
@@ -48,7 +53,10 @@ CapstoneDecoder::CapstoneDecoder(Project *project, cs::cs_arch arch, cs::cs_mode
 
 CapstoneDecoder::~CapstoneDecoder()
 {
-    cs::cs_close(&m_handle);
+    for (auto &threadState : m_threadStates) {
+        cs::cs_free(threadState.second->insn, 1);
+        cs::cs_close(&threadState.second->handle);
+    }
 }
 
 
@@ -69,3 +77,75 @@ bool CapstoneDecoder::isInstructionInGroup(const cs::cs_insn *instruction, uint8
 
     return false;
 }
+
+
+CapstoneDecoder::ThreadState &CapstoneDecoder::getThreadState()
+{
+    // Cache of the state of this thread. Decoders are identified by ID instead of
+    // by address, since a new decoder might be allocated at the address of an old one.
+    thread_local int cachedID             = -1;
+    thread_local ThreadState *cachedState = nullptr;
+
+    if (cachedID != m_id) {
+        std::lock_guard<std::mutex> lock(m_threadStatesMutex);
+        std::unique_ptr<ThreadState> &state = m_threadStates[std::this_thread::get_id()];
+
+        if (!state) {
+            state = createThreadState();
+        }
+
+        cachedID    = m_id;
+        cachedState = state.get();
+    }
+
+    return *cachedState;
+}
+
+
+std::unique_ptr<CapstoneDecoder::ThreadState> CapstoneDecoder::createThreadState() const
+{
+    std::unique_ptr<ThreadState> state(new ThreadState);
+
+    if (cs::cs_open(m_arch, m_mode, &state->handle) != cs::CS_ERR_OK) {
+        LOG_ERROR("Cannot open Capstone handle");
+        return state;
+    }
+
+    cs::cs_option(state->handle, cs::CS_OPT_DETAIL, cs::CS_OPT_ON);
+    state->insn = cs::cs_malloc(state->handle);
+    return state;
+}
+
+
+void CapstoneDecoder::setMode(cs::cs_mode mode)
+{
+    std::lock_guard<std::mutex> lock(m_threadStatesMutex);
+    m_mode = mode;
+
+    for (auto &threadState : m_threadStates) {
+        cs::cs_option(threadState.second->handle, cs::CS_OPT_MODE, mode);
+    }
+}
+
+
+InsnTemplate CapstoneDecoder::makeTemplate(const QString &name, std::size_t numOperands) const
+{
+    InsnTemplate tmpl;
+    tmpl.name = name;
+
+    // SSL instruction names are upper case and do not contain any .'s
+    tmpl.entry = m_dict.findEntry(QString(name).remove(".").toUpper(), numOperands);
+    return tmpl;
+}
+
+
+std::unique_ptr<RTL> CapstoneDecoder::instantiateTemplate(const MachineInstruction &insn)
+{
+    if (insn.m_templateEntry) {
+        return m_dict.instantiateRTL(*insn.m_templateEntry, insn.m_addr, insn.m_operands);
+    }
+
+    // Not in the dictionary; let the dictionary report the error
+    const QString sanitizedName = QString(insn.m_templateName).remove(".").toUpper();
+    return m_dict.instantiateRTL(sanitizedName, insn.m_addr, insn.m_operands);
+}
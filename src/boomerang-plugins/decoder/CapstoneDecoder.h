@@ -13,6 +13,13 @@
 #include "boomerang/ifc/IDecoder.h"
 #include "boomerang/ssl/RTLInstDict.h"
 
+#include <QHash>
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
 
 namespace cs
 {
@@ -20,8 +27,21 @@ namespace cs
 }
 
 
+/// SSL template of a decoded instruction
+struct InsnTemplate
+{
+    QString name;                      ///< e.g. MOVSX.r32.rm8
+    const TableEntry *entry = nullptr; ///< nullptr if the template is not in the SSL file
+    QByteArray mnemonic;               ///< Capstone mnemonic, if the key is derived from it
+};
+
+
 /**
  * Base class for instruction decoders using Capstone for disassembling instructions.
+ *
+ * Capstone handles must not be shared between threads, so each thread that decodes
+ * instructions gets its own handle and instruction buffer (\sa getThreadState).
+ * Decoding is therefore re-entrant; lifting still accesses the Prog and is not.
  */
 class CapstoneDecoder : public IDecoder
 {
@@ -43,14 +63,49 @@ public:
 public:
     const RTLInstDict *getDict() const override { return &m_dict; }
 
+protected:
+    /// Capstone state of a single decoding thread
+    struct ThreadState
+    {
+        cs::csh handle    = 0;
+        cs::cs_insn *insn = nullptr; ///< buffer for the decoded instruction
+
+        /// Templates of instructions decoded by this thread, by a key computed by the
+        /// derived class from the instruction (e.g. ID and operand kinds)
+        QHash<uint64, InsnTemplate> templates;
+    };
+
 protected:
     bool initialize(Project *project) override;
 
     bool isInstructionInGroup(const cs::cs_insn *instruction, uint8_t group) const;
 
+    /// \returns the Capstone state of the calling thread. It is created on first use.
+    ThreadState &getThreadState();
+
+    /// Change the disassembly mode of all handles, including handles created later.
+    /// Must not be called while instructions are being decoded.
+    void setMode(cs::cs_mode mode);
+
+    /// \returns the template named \p name taking \p numOperands operands.
+    InsnTemplate makeTemplate(const QString &name, std::size_t numOperands) const;
+
+    /// Instantiate the semantics of \p insn from its SSL template.
+    std::unique_ptr<RTL> instantiateTemplate(const MachineInstruction &insn);
+
+private:
+    std::unique_ptr<ThreadState> createThreadState() const;
+
 protected:
-    cs::csh m_handle;
     Prog *m_prog = nullptr;
     RTLInstDict m_dict;
     bool m_debugMode = false;
+
+private:
+    const int m_id; ///< Identifies this decoder in thread local caches
+    const cs::cs_arch m_arch;
+    cs::cs_mode m_mode;
+
+    std::mutex m_threadStatesMutex;
+    std::unordered_map<std::thread::id, std::unique_ptr<ThreadState>> m_threadStates;
 };
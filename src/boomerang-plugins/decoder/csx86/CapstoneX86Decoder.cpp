@@ -138,14 +138,6 @@ CapstoneX86Decoder::CapstoneX86Decoder(Project *project)
     if (m_dict.getRegDB()->getRegNameByNum(REG_X86_ESP).isEmpty()) {
         throw std::runtime_error("Required register #28 (%esp) not present");
     }
-
-    m_insn = cs::cs_malloc(m_handle);
-}
-
-
-CapstoneX86Decoder::~CapstoneX86Decoder()
-{
-    cs::cs_free(m_insn, 1);
 }
 
 
@@ -157,9 +149,9 @@ bool CapstoneX86Decoder::initialize(Project *project)
 
     const int bitness = project->getLoadedBinaryFile()->getBitness();
     switch (bitness) {
-    case 16: cs::cs_option(m_handle, cs::CS_OPT_MODE, cs::CS_MODE_16); break;
-    case 32: cs::cs_option(m_handle, cs::CS_OPT_MODE, cs::CS_MODE_32); break;
-    case 64: cs::cs_option(m_handle, cs::CS_OPT_MODE, cs::CS_MODE_64); break;
+    case 16: setMode(cs::CS_MODE_16); break;
+    case 32: setMode(cs::CS_MODE_32); break;
+    case 64: setMode(cs::CS_MODE_64); break;
     default: return false;
     }
 
@@ -174,35 +166,40 @@ bool CapstoneX86Decoder::disassembleInstruction(Address pc, ptrdiff_t delta,
     size_t size                 = X86_MAX_INSTRUCTION_LENGTH;
     uint64 addr                 = pc.value();
 
-    const bool valid = cs_disasm_iter(m_handle, &instructionData, &size, &addr, m_insn);
+    ThreadState &state = getThreadState();
+    cs::cs_insn *insn  = state.insn;
+
+    const bool valid = insn && cs_disasm_iter(state.handle, &instructionData, &size, &addr, insn);
 
     if (!valid) {
         return false;
     }
 
-    result.m_addr = Address(m_insn->address);
-    result.m_id   = m_insn->id;
-    result.m_size = m_insn->size;
+    result.m_addr = Address(insn->address);
+    result.m_id   = insn->id;
+    result.m_size = insn->size;
 
-    std::strncpy(result.m_mnem.data(), m_insn->mnemonic, MNEM_SIZE);
-    std::strncpy(result.m_opstr.data(), m_insn->op_str, OPSTR_SIZE);
+    std::strncpy(result.m_mnem.data(), insn->mnemonic, MNEM_SIZE);
+    std::strncpy(result.m_opstr.data(), insn->op_str, OPSTR_SIZE);
     result.m_mnem[MNEM_SIZE - 1]   = '\0';
     result.m_opstr[OPSTR_SIZE - 1] = '\0';
 
-    const std::size_t numOperands = m_insn->detail->x86.op_count;
+    const std::size_t numOperands = insn->detail->x86.op_count;
     result.m_operands.resize(numOperands);
 
     for (std::size_t i = 0; i < numOperands; ++i) {
-        result.m_operands[i] = operandToExp(m_insn->detail->x86.operands[i]);
+        result.m_operands[i] = operandToExp(insn->detail->x86.operands[i]);
     }
 
-    result.m_templateName = getTemplateName(m_insn);
+    const InsnTemplate tmpl = getTemplate(state, insn);
+    result.m_templateName   = tmpl.name;
+    result.m_templateEntry  = tmpl.entry;
 
-    result.setGroup(MIGroup::Jump, isInstructionInGroup(m_insn, cs::CS_GRP_JUMP));
-    result.setGroup(MIGroup::Call, isInstructionInGroup(m_insn, cs::CS_GRP_CALL));
+    result.setGroup(MIGroup::Jump, isInstructionInGroup(insn, cs::CS_GRP_JUMP));
+    result.setGroup(MIGroup::Call, isInstructionInGroup(insn, cs::CS_GRP_CALL));
     result.setGroup(MIGroup::BoolAsgn, result.m_templateName.startsWith("SET"));
-    result.setGroup(MIGroup::Ret, isInstructionInGroup(m_insn, cs::CS_GRP_RET) ||
-                                      isInstructionInGroup(m_insn, cs::CS_GRP_IRET));
+    result.setGroup(MIGroup::Ret, isInstructionInGroup(insn, cs::CS_GRP_RET) ||
+                                      isInstructionInGroup(insn, cs::CS_GRP_IRET));
 
     if (result.isInGroup(MIGroup::Jump) || result.isInGroup(MIGroup::Call)) {
         assert(result.getNumOperands() > 0);
@@ -421,8 +418,6 @@ std::unique_ptr<RTL> CapstoneX86Decoder::createRTLForInstruction(const MachineIn
 
 std::unique_ptr<RTL> CapstoneX86Decoder::instantiateRTL(const MachineInstruction &insn)
 {
-    // Take the argument, convert it to upper case and remove any .'s
-    const QString sanitizedName   = QString(insn.m_templateName).remove(".").toUpper();
     const std::size_t numOperands = insn.getNumOperands();
 
     if (m_debugMode) {
@@ -437,7 +432,7 @@ std::unique_ptr<RTL> CapstoneX86Decoder::instantiateRTL(const MachineInstruction
         LOG_MSG("Instantiating RTL at %1: %2 %3", insn.m_addr, insn.m_templateName, argNames);
     }
 
-    return m_dict.instantiateRTL(sanitizedName, insn.m_addr, insn.m_operands);
+    return instantiateTemplate(insn);
 }
 
 
@@ -546,12 +541,48 @@ bool CapstoneX86Decoder::genBSFR(const MachineInstruction &insn, LiftedInstructi
 }
 
 
-QString CapstoneX86Decoder::getTemplateName(const cs::cs_insn *instruction) const
+InsnTemplate CapstoneX86Decoder::getTemplate(ThreadState &state,
+                                             const cs::cs_insn *instruction) const
+{
+    // Pack everything the template name depends on into the key:
+    // instruction ID (16 bits), prefix (2 bits), number of operands (3 bits)
+    // and type (2 bits) and size (8 bits) of up to 4 operands.
+    const int numOperands         = instruction->detail->x86.op_count;
+    const cs::cs_x86_op *operands = instruction->detail->x86.operands;
+
+    uint64 prefix = 0;
+    switch (instruction->detail->x86.prefix[0]) {
+    case cs::X86_PREFIX_REP: prefix = 1; break;
+    case cs::X86_PREFIX_REPNE: prefix = 2; break;
+    }
+
+    if (instruction->id > 0xFFFF || numOperands > 4) {
+        // Does not fit into the key; rare enough not to bother caching it.
+        return makeTemplate(getTemplateName(state.handle, instruction), numOperands);
+    }
+
+    uint64 key = (uint64(instruction->id) << 5) | (prefix << 3) | numOperands;
+
+    for (int i = 0; i < numOperands; i++) {
+        key = (key << 10) | (uint64(operands[i].type & 0x3) << 8) | operands[i].size;
+    }
+
+    auto it = state.templates.find(key);
+    if (it == state.templates.end()) {
+        it = state.templates.insert(
+            key, makeTemplate(getTemplateName(state.handle, instruction), numOperands));
+    }
+
+    return it.value();
+}
+
+
+QString CapstoneX86Decoder::getTemplateName(cs::csh handle, const cs::cs_insn *instruction) const
 {
     const int numOperands         = instruction->detail->x86.op_count;
     const cs::cs_x86_op *operands = instruction->detail->x86.operands;
 
-    QString insnID = cs::cs_insn_name(m_handle, instruction->id);
+    QString insnID = cs::cs_insn_name(handle, instruction->id);
 
     switch (instruction->detail->x86.prefix[0]) {
     case cs::X86_PREFIX_REP: insnID = "REP" + insnID; break;
@@ -24,7 +24,6 @@ class BOOMERANG_PLUGIN_API CapstoneX86Decoder : public CapstoneDecoder
 {
 public:
     CapstoneX86Decoder(Project *project);
-    ~CapstoneX86Decoder();
 
 public:
     /// \copydoc IDecoder::decodeInstruction
@@ -73,9 +72,11 @@ private:
      */
     bool genBSFR(const MachineInstruction &insn, LiftedInstruction &result);
 
-    /// \returns the name of the SSL template for \p instruction
-    QString getTemplateName(const cs::cs_insn *instruction) const;
+    /// \returns the SSL template for \p instruction, from the template cache of \p state
+    /// if possible. The template name is only built the first time an instruction
+    /// with the same ID, prefix and operand types and sizes is decoded.
+    InsnTemplate getTemplate(ThreadState &state, const cs::cs_insn *instruction) const;
 
-private:
-    cs::cs_insn *m_insn; ///< decoded instruction;
+    /// \returns the name of the SSL template for \p instruction
+    QString getTemplateName(cs::csh handle, const cs::cs_insn *instruction) const;
 };
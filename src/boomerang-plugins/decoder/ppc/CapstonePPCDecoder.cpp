@@ -94,11 +94,14 @@ bool CapstonePPCDecoder::disassembleInstruction(Address pc, ptrdiff_t delta,
                                                 MachineInstruction &result)
 {
     const Byte *instructionData = reinterpret_cast<const Byte *>((HostAddress(delta) + pc).value());
+    size_t size                 = PPC_INSN_LENGTH;
+    uint64 addr                 = pc.value();
 
-    cs::cs_insn *decodedInstruction;
-    size_t numInstructions = cs_disasm(m_handle, instructionData, PPC_INSN_LENGTH, pc.value(), 1,
-                                       &decodedInstruction);
-    const bool valid       = numInstructions > 0;
+    ThreadState &state              = getThreadState();
+    cs::cs_insn *decodedInstruction = state.insn;
+
+    const bool valid = decodedInstruction && cs_disasm_iter(state.handle, &instructionData, &size,
+                                                            &addr, decodedInstruction);
 
     if (!valid) {
         return false;
@@ -134,13 +137,14 @@ bool CapstonePPCDecoder::disassembleInstruction(Address pc, ptrdiff_t delta,
         result.m_operands[i] = operandToExp(decodedInstruction->detail->ppc.operands[i]);
     }
 
-    result.m_templateName = getTemplateName(decodedInstruction);
+    const InsnTemplate tmpl = getTemplate(state, decodedInstruction);
+    result.m_templateName   = tmpl.name;
+    result.m_templateEntry  = tmpl.entry;
 
     result.setGroup(MIGroup::Call, isCall(decodedInstruction));
     result.setGroup(MIGroup::Jump, isJump(decodedInstruction));
     result.setGroup(MIGroup::Ret, isRet(decodedInstruction));
 
-    cs_free(decodedInstruction, numInstructions);
     return true;
 }
 
@@ -335,9 +339,7 @@ std::unique_ptr<RTL> CapstonePPCDecoder::instantiateRTL(const MachineInstruction
         LOG_MSG("Instantiating RTL at %1: %2 %3", insn.m_addr, insn.m_templateName, argNames);
     }
 
-    // Take the argument, convert it to upper case and remove any .'s
-    const QString sanitizedName = QString(insn.m_templateName).remove(".").toUpper();
-    return m_dict.instantiateRTL(sanitizedName, insn.m_addr, insn.m_operands);
+    return instantiateTemplate(insn);
 }
 
 
@@ -362,6 +364,37 @@ bool CapstonePPCDecoder::isCRManip(const cs::cs_insn *instruction) const
 }
 
 
+InsnTemplate CapstonePPCDecoder::getTemplate(ThreadState &state,
+                                             const cs::cs_insn *instruction) const
+{
+    // The template name only depends on the mnemonic (the instruction ID does not
+    // distinguish e.g. branch hints), so the key is a FNV-1a hash of the mnemonic
+    // and the number of operands.
+    const int numOperands = instruction->detail->ppc.op_count;
+    uint64 key            = 0xCBF29CE484222325ULL;
+
+    for (const char *c = instruction->mnemonic; *c != '\0'; ++c) {
+        key = (key ^ static_cast<Byte>(*c)) * 0x100000001B3ULL;
+    }
+
+    key = (key ^ static_cast<Byte>(numOperands)) * 0x100000001B3ULL;
+
+    auto it = state.templates.find(key);
+    if (it != state.templates.end() && it->mnemonic == instruction->mnemonic) {
+        return it.value();
+    }
+
+    InsnTemplate tmpl = makeTemplate(getTemplateName(instruction), numOperands);
+    tmpl.mnemonic     = instruction->mnemonic;
+
+    if (it == state.templates.end()) {
+        state.templates.insert(key, tmpl);
+    }
+
+    return tmpl;
+}
+
+
 QString CapstonePPCDecoder::getTemplateName(const cs::cs_insn *instruction) const
 {
     QString insnID = instruction->mnemonic; // cs::cs_insn_name(m_handle, instruction->id);
@@ -52,6 +52,10 @@ private:
 
     bool isRet(const cs::cs_insn *instruction) const;
 
+    /// \returns the SSL template for \p instruction, from the template cache of \p state
+    /// if possible.
+    InsnTemplate getTemplate(ThreadState &state, const cs::cs_insn *instruction) const;
+
     /// \returns the name of the SSL template for \p instruction
     QString getTemplateName(const cs::cs_insn *instruction) const;
 };
@@ -0,0 +1,280 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "OverlappedRegProcessor.h"
+
+#include "boomerang/db/IRFragment.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/RegDB.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/util/LocationSet.h"
+
+#include <deque>
+#include <set>
+
+
+/// \returns the register assigned to by \p stmt, or RegNumSpecial if \p stmt
+/// does not assign to a register.
+static RegNum getAssignedReg(const SharedStmt &stmt)
+{
+    if (!stmt->isAssignment()) {
+        return RegNumSpecial;
+    }
+
+    SharedConstExp lhs = stmt->as<const Assignment>()->getLeft();
+    return lhs->isRegOfConst() ? lhs->access<Const, 1>()->getInt() : RegNumSpecial;
+}
+
+
+/// \returns true if \p stmt might not assign to its left hand side.
+static bool isGuarded(const SharedStmt &stmt)
+{
+    return stmt->isAssign() && stmt->as<const Assign>()->getGuard() != nullptr;
+}
+
+
+OverlappedRegProcessor::OverlappedRegProcessor(UserProc *proc, const RegDB *regDB)
+    : m_proc(proc)
+    , m_regDB(regDB)
+{
+}
+
+
+int OverlappedRegProcessor::processOverlappedRegs()
+{
+    if (!findTrackedRegs()) {
+        return 0;
+    }
+
+    computeLiveness();
+
+    int numInserted = 0;
+    for (IRFragment *frag : *m_proc->getCFG()) {
+        numInserted += insertFixups(frag);
+    }
+
+    return numInserted;
+}
+
+
+bool OverlappedRegProcessor::findTrackedRegs()
+{
+    std::set<RegNum> usedRegs;
+    std::set<RegNum> assignedRegs;
+
+    for (const SharedStmt &stmt : m_proc->getStatementView()) {
+        LocationSet locs;
+        stmt->addUsedLocs(locs);
+
+        for (const SharedExp &loc : locs) {
+            if (loc->isRegOfConst()) {
+                usedRegs.insert(loc->access<Const, 1>()->getInt());
+            }
+        }
+
+        const RegNum assigned = getAssignedReg(stmt);
+        if (assigned != RegNumSpecial) {
+            assignedRegs.insert(assigned);
+        }
+    }
+
+    std::map<RegNum, std::set<RegNum>> overlapping;
+
+    for (RegNum assigned : assignedRegs) {
+        overlapping[assigned] = m_regDB->getOverlappingRegs(assigned);
+
+        for (RegNum reg : overlapping[assigned]) {
+            if (usedRegs.find(reg) != usedRegs.end() &&
+                m_trackedIndex.find(reg) == m_trackedIndex.end()) {
+                m_trackedIndex[reg] = static_cast<int>(m_trackedRegs.size());
+                m_trackedRegs.push_back(reg);
+            }
+        }
+    }
+
+    if (m_trackedRegs.empty()) {
+        return false;
+    }
+
+    const int numTracked = static_cast<int>(m_trackedRegs.size());
+
+    for (RegNum assigned : assignedRegs) {
+        QBitArray killed(numTracked);
+        QBitArray changed(numTracked);
+
+        std::set<RegNum> covered = m_regDB->getCoveredRegs(assigned);
+        covered.insert(assigned);
+
+        for (RegNum reg : covered) {
+            const auto it = m_trackedIndex.find(reg);
+            if (it != m_trackedIndex.end()) {
+                killed.setBit(it->second);
+            }
+        }
+
+        for (RegNum reg : overlapping[assigned]) {
+            const auto it = m_trackedIndex.find(reg);
+            if (it != m_trackedIndex.end()) {
+                changed.setBit(it->second);
+            }
+        }
+
+        m_killed[assigned]      = killed;
+        m_overlapping[assigned] = changed;
+    }
+
+    return true;
+}
+
+
+void OverlappedRegProcessor::computeLiveness()
+{
+    const int numTracked = static_cast<int>(m_trackedRegs.size());
+
+    std::deque<IRFragment *> workList;
+    for (IRFragment *frag : *m_proc->getCFG()) {
+        m_liveIn[frag] = QBitArray(numTracked);
+        workList.push_back(frag);
+    }
+
+    std::set<IRFragment *> inWorkList(workList.begin(), workList.end());
+
+    while (!workList.empty()) {
+        IRFragment *frag = workList.front();
+        workList.pop_front();
+        inWorkList.erase(frag);
+
+        QBitArray live = getLiveOut(frag);
+
+        if (frag->getRTLs()) {
+            for (auto rit = frag->getRTLs()->rbegin(); rit != frag->getRTLs()->rend(); ++rit) {
+                for (auto sit = (*rit)->rbegin(); sit != (*rit)->rend(); ++sit) {
+                    transfer(*sit, live);
+                }
+            }
+        }
+
+        if (live == m_liveIn[frag]) {
+            continue;
+        }
+
+        m_liveIn[frag] = live;
+
+        for (IRFragment *pred : frag->getPredecessors()) {
+            if (inWorkList.insert(pred).second) {
+                workList.push_back(pred);
+            }
+        }
+    }
+}
+
+
+QBitArray OverlappedRegProcessor::getLiveOut(const IRFragment *frag) const
+{
+    QBitArray live(static_cast<int>(m_trackedRegs.size()));
+
+    if (frag->getSuccessors().empty()) {
+        // the caller or unknown successors might read anything
+        live.fill(true);
+        return live;
+    }
+
+    for (const IRFragment *succ : frag->getSuccessors()) {
+        const auto it = m_liveIn.find(succ);
+        if (it != m_liveIn.end()) {
+            live |= it->second;
+        }
+    }
+
+    return live;
+}
+
+
+void OverlappedRegProcessor::transfer(const SharedStmt &stmt, QBitArray &live) const
+{
+    if (stmt->isCall() || stmt->isReturn()) {
+        // arguments and return values are not known yet
+        live.fill(true);
+        return;
+    }
+
+    const RegNum assigned = getAssignedReg(stmt);
+    if (assigned != RegNumSpecial && !isGuarded(stmt)) {
+        live &= ~m_killed.at(assigned);
+    }
+
+    LocationSet locs;
+    stmt->addUsedLocs(locs);
+
+    for (const SharedExp &loc : locs) {
+        if (!loc->isRegOfConst()) {
+            continue;
+        }
+
+        const auto it = m_trackedIndex.find(loc->access<Const, 1>()->getInt());
+        if (it != m_trackedIndex.end()) {
+            live.setBit(it->second);
+        }
+    }
+}
+
+
+int OverlappedRegProcessor::insertFixups(IRFragment *frag)
+{
+    if (!frag->getRTLs()) {
+        return 0;
+    }
+
+    int numInserted = 0;
+    QBitArray live  = getLiveOut(frag);
+
+    for (auto rit = frag->getRTLs()->rbegin(); rit != frag->getRTLs()->rend(); ++rit) {
+        RTL *rtl = rit->get();
+
+        // Walk backwards; inserting after it does not invalidate it.
+        for (RTL::iterator it = rtl->end(); it != rtl->begin();) {
+            --it;
+            const SharedStmt stmt = *it;
+            const RegNum assigned = getAssignedReg(stmt);
+
+            if (assigned != RegNumSpecial) {
+                // tracked registers changed by stmt that might be read later
+                const QBitArray changed = m_overlapping.at(assigned) & live;
+                std::set<RegNum> liveRegs;
+
+                for (int i = 0; i < changed.size(); i++) {
+                    if (changed.testBit(i)) {
+                        liveRegs.insert(m_trackedRegs[i]);
+                    }
+                }
+
+                std::unique_ptr<RTL> fixups;
+                if (!liveRegs.empty()) {
+                    fixups = m_regDB->processOverlappedRegs(stmt->as<Assignment>(), liveRegs);
+                }
+
+                if (fixups) {
+                    for (const SharedStmt &fixup : *fixups) {
+                        fixup->setProc(m_proc);
+                        fixup->setFragment(frag);
+                        rtl->insert(std::next(it), fixup);
+                        numInserted++;
+                    }
+                }
+            }
+
+            transfer(stmt, live);
+        }
+    }
+
+    return numInserted;
+}
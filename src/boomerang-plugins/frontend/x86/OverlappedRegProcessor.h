@@ -0,0 +1,87 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/ssl/Register.h"
+#include "boomerang/ssl/statements/Statement.h"
+
+#include <QBitArray>
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+
+class IRFragment;
+class RegDB;
+class UserProc;
+
+
+/**
+ * Models the effects of assignments to overlapped registers (e.g. %al, %ah, %ax and %eax)
+ * by inserting fixup assignments after them (\sa RegDB::processOverlappedRegs).
+ *
+ * Only overlaps that can actually be observed are materialized: An assignment to %ax
+ * only gets a fixup for %eax if %eax is live after the assignment, i.e. if %eax may be read
+ * on some path before it is completely overwritten. Register liveness is computed on the
+ * lifted (non-SSA) IR of the procedure, where an assignment to a register kills all
+ * registers it covers, but not the registers covering it.
+ * Calls and returns are assumed to read all registers.
+ *
+ * Must be run exactly once on the freshly lifted IR of a procedure.
+ */
+class OverlappedRegProcessor
+{
+public:
+    OverlappedRegProcessor(UserProc *proc, const RegDB *regDB);
+
+public:
+    /// Insert fixup assignments for all observable effects of overlapped registers.
+    /// \returns the number of inserted statements.
+    int processOverlappedRegs();
+
+private:
+    /// Find all registers that are read in the procedure and that might be
+    /// changed by assignments to other registers.
+    /// \returns false if there are no such registers.
+    bool findTrackedRegs();
+
+    /// Compute the registers live at the end of each fragment.
+    void computeLiveness();
+
+    /// \returns the registers live at the end of \p frag
+    QBitArray getLiveOut(const IRFragment *frag) const;
+
+    /// Update \p live from the registers live after \p stmt
+    /// to the registers live before \p stmt.
+    void transfer(const SharedStmt &stmt, QBitArray &live) const;
+
+    /// Insert the fixups for the assignments in \p frag.
+    /// \returns the number of inserted statements.
+    int insertFixups(IRFragment *frag);
+
+private:
+    UserProc *m_proc;
+    const RegDB *m_regDB;
+
+    /// Registers whose value might be changed by assignments to overlapping registers.
+    /// Liveness is only computed for these registers.
+    std::vector<RegNum> m_trackedRegs;
+    std::map<RegNum, int> m_trackedIndex; ///< register -> index in m_trackedRegs
+
+    /// Assigned register -> tracked registers overwritten completely by the assignment
+    std::map<RegNum, QBitArray> m_killed;
+
+    /// Assigned register -> tracked registers that overlap the assigned register
+    std::map<RegNum, QBitArray> m_overlapping;
+
+    std::unordered_map<const IRFragment *, QBitArray> m_liveIn;
+};
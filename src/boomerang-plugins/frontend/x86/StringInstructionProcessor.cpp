@@ -145,7 +145,7 @@ IRFragment *StringInstructionProcessor::splitForBranch(IRFragment *frag, RTL *st
 
     rptFragRTLs->front()->setAddress(stringAddr + 1);
     rptFragRTLs->front()->pop_front();
-    rptFragRTLs->front()->back() = rptBranch;
+    rptFragRTLs->front()->replace(std::prev(rptFragRTLs->front()->end()), rptBranch);
 
     // remove the original string instruction from the CFG.
     BasicBlock *origBB = frag->getBB();
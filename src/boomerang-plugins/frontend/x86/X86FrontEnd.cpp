@@ -9,6 +9,7 @@
 #pragma endregion License
 #include "X86FrontEnd.h"
 
+#include "OverlappedRegProcessor.h"
 #include "StringInstructionProcessor.h"
 
 #include "boomerang/core/Project.h"
@@ -71,8 +72,9 @@ bool X86FrontEnd::liftProcImpl(UserProc *proc)
         }
     }
 
-    // Process code for side effects of overlapped registers
-    processOverlapped(proc);
+    // Process code for side effects of overlapped registers.
+    // All fragments have just been lifted, so none of them has been processed before.
+    OverlappedRegProcessor(proc, m_decoder->getDict()->getRegDB()).processOverlappedRegs();
 
     for (IRFragment *frag : *procCFG) {
         for (SharedStmt stmt = frag->getFirstStmt(rit, sit); stmt != nullptr;
@@ -318,54 +320,6 @@ void X86FrontEnd::processStringInst(UserProc *proc)
 }
 
 
-void X86FrontEnd::processOverlapped(UserProc *proc)
-{
-    // first, lets look for any uses of the registers
-    std::set<RegNum> usedRegs;
-    StatementList stmts;
-    proc->getStatements(stmts);
-
-    for (SharedStmt s : stmts) {
-        LocationSet locs;
-        s->addUsedLocs(locs);
-
-        for (SharedExp l : locs) {
-            if (l->isRegOfConst()) {
-                usedRegs.insert(l->access<Const, 1>()->getInt());
-            }
-        }
-    }
-
-    std::set<IRFragment *> frags;
-
-    for (SharedStmt s : stmts) {
-        if (isOverlappedRegsProcessed(s->getFragment())) { // never redo processing
-            continue;
-        }
-
-        frags.insert(s->getFragment());
-
-        if (!s->isAssignment()) {
-            continue;
-        }
-
-        std::unique_ptr<RTL> overlapResult = m_decoder->getDict()
-                                                 ->getRegDB()
-                                                 ->processOverlappedRegs(s->as<Assignment>(),
-                                                                         usedRegs);
-
-        if (overlapResult) {
-            for (SharedStmt res : *overlapResult) {
-                proc->insertStatementAfter(s, res->clone());
-            }
-        }
-    }
-
-    // set a flag for every fragment we've processed so we don't do them again
-    m_overlappedRegsProcessed.insert(frags.begin(), frags.end());
-}
-
-
 void X86FrontEnd::extraProcessCall(IRFragment *callFrag)
 {
     const std::shared_ptr<CallStatement> call = callFrag->getLastStmt()->as<CallStatement>();
@@ -60,11 +60,6 @@ private:
      */
     void processStringInst(UserProc *proc);
 
-    /**
-     * Process for overlapped registers
-     */
-    void processOverlapped(UserProc *proc);
-
     /**
      * Checks for x86 specific helper functions like __xtol which have specific sematics.
      *
@@ -78,17 +73,11 @@ private:
      */
     bool isHelperFunc(Address dest, Address addr, RTLList &lrtl) override;
 
-    bool isOverlappedRegsProcessed(const IRFragment *frag) const
-    {
-        return m_overlappedRegsProcessed.find(frag) != m_overlappedRegsProcessed.end();
-    }
-
     bool isFloatProcessed(const IRFragment *frag) const
     {
         return m_floatProcessed.find(frag) != m_floatProcessed.end();
     }
 
 private:
-    std::unordered_set<const IRFragment *> m_overlappedRegsProcessed;
     std::unordered_set<const IRFragment *> m_floatProcessed;
 };
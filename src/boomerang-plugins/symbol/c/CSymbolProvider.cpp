@@ -32,6 +32,18 @@ CSymbolProvider::CSymbolProvider(Project *project)
 
 
 bool CSymbolProvider::readLibraryCatalog(const Prog *prog, const QString &filePath)
+{
+    return readCatalog(filePath, prog->getMachine(), true);
+}
+
+
+bool CSymbolProvider::preloadLibraryCatalog(Machine machine, const QString &filePath)
+{
+    return readCatalog(filePath, machine, false);
+}
+
+
+bool CSymbolProvider::readCatalog(const QString &filePath, Machine machine, bool addSignatures)
 {
     // TODO: this is a work for generic semantics provider plugin : HeaderReader
     QFile file(filePath);
@@ -67,7 +79,7 @@ bool CSymbolProvider::readLibraryCatalog(const Prog *prog, const QString &filePa
         }
 
         const QString sig_path = QFileInfo(filePath).absoluteDir().absoluteFilePath(sigFilePath);
-        if (!readLibrarySignatures(qPrintable(sig_path), prog, cc)) {
+        if (!readLibrarySignatures(qPrintable(sig_path), machine, cc, addSignatures)) {
             return false;
         }
     }
@@ -76,18 +88,34 @@ bool CSymbolProvider::readLibraryCatalog(const Prog *prog, const QString &filePa
 }
 
 
-bool CSymbolProvider::readLibrarySignatures(const QString &signatureFile, const Prog *prog,
-                                            CallConv cc)
+bool CSymbolProvider::readLibrarySignatures(const QString &signatureFile, Machine machine,
+                                            CallConv cc, bool addSignatures)
 {
-    AnsiCParserDriver driver;
-    if (driver.parse(signatureFile, prog->getMachine(), cc) != 0) {
-        LOG_ERROR("Cannot read library signature file '%1'", signatureFile);
-        return false;
+    const SignatureFileKey key(signatureFile, machine, cc);
+    auto it = m_parsedSignatureFiles.find(key);
+
+    if (it == m_parsedSignatureFiles.end()) {
+        AnsiCParserDriver driver;
+        if (driver.parse(signatureFile, machine, cc) != 0) {
+            LOG_ERROR("Cannot read library signature file '%1'", signatureFile);
+            return false;
+        }
+
+        for (std::shared_ptr<Signature> &signature : driver.signatures) {
+            signature->setSigFilePath(signatureFile);
+        }
+
+        it = m_parsedSignatureFiles.emplace(key, std::move(driver.signatures)).first;
     }
 
-    for (std::shared_ptr<Signature> &signature : driver.signatures) {
-        m_librarySignatures[signature->getName()] = signature;
-        signature->setSigFilePath(signatureFile);
+    if (!addSignatures) {
+        return true;
+    }
+
+    // The parsed signatures are shared by all Progs; hand out copies
+    // so that analysis of one Prog cannot change the signatures of another one.
+    for (const std::shared_ptr<Signature> &signature : it->second) {
+        m_librarySignatures[signature->getName()] = signature->clone();
     }
 
     return true;
@@ -142,5 +170,11 @@ std::shared_ptr<Signature> CSymbolProvider::getSignatureByName(const QString &fu
 }
 
 
+void CSymbolProvider::clearLibrarySignatures()
+{
+    m_librarySignatures.clear();
+}
+
+
 BOOMERANG_DEFINE_PLUGIN(PluginType::SymbolProvider, CSymbolProvider, "C Symbol Provider plugin",
                         BOOMERANG_VERSION, "Boomerang developers")
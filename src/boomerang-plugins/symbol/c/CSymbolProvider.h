@@ -11,17 +11,26 @@
 
 
 #include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/db/binary/BinaryFile.h"
 #include "boomerang/frontend/SigEnum.h"
 #include "boomerang/ifc/ISymbolProvider.h"
 
 #include <QMap>
 
+#include <list>
+#include <map>
+#include <tuple>
+
 
 class Prog;
 
 
 /// Symbol provider for reading signatures and symbols from C-like headers.
 /// (cf. also the files in data/signature/)
+///
+/// Parsed signature files are kept for the lifetime of the plugin, so decompiling
+/// several binaries with the same Project only parses each signature file once.
+/// Each Prog gets its own copies of the signatures.
 class BOOMERANG_PLUGIN_API CSymbolProvider : public ISymbolProvider
 {
 public:
@@ -32,15 +41,29 @@ public:
     /// \copydoc ISymbolProvider::readLibraryCatalog
     bool readLibraryCatalog(const Prog *prog, const QString &fileName) override;
 
+    /// \copydoc ISymbolProvider::preloadLibraryCatalog
+    bool preloadLibraryCatalog(Machine machine, const QString &fileName) override;
+
     /// \copydoc ISymbolProvider::addSymbolsFromSymbolFile
     bool addSymbolsFromSymbolFile(Prog *prog, const QString &fileName) override;
 
     /// \copydoc ISymbolProvider::getSignatureByName
     std::shared_ptr<Signature> getSignatureByName(const QString &functionName) const override;
 
+    /// \copydoc ISymbolProvider::clearLibrarySignatures
+    void clearLibrarySignatures() override;
+
 private:
-    bool readLibrarySignatures(const QString &signatureFile, const Prog *prog, CallConv cc);
+    /// \param addSignatures If true, add the signatures of all files to the library signatures
+    /// of the current program; otherwise only parse the files.
+    bool readCatalog(const QString &filePath, Machine machine, bool addSignatures);
+    bool readLibrarySignatures(const QString &signatureFile, Machine machine, CallConv cc,
+                               bool addSignatures);
 
 private:
+    /// Signature file, machine and calling convention the file was parsed with
+    typedef std::tuple<QString, Machine, CallConv> SignatureFileKey;
+
     QMap<QString, std::shared_ptr<Signature>> m_librarySignatures;
+    std::map<SignatureFileKey, std::list<std::shared_ptr<Signature>>> m_parsedSignatureFiles;
 };
@@ -19,6 +19,7 @@
 #include "boomerang/db/signature/Signature.h"
 #include "boomerang/passes/PassManager.h"
 #include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/ExpPattern.h"
 #include "boomerang/ssl/exp/Location.h"
 #include "boomerang/ssl/exp/RefExp.h"
 #include "boomerang/ssl/exp/Terminal.h"
@@ -41,6 +42,7 @@
 #include "boomerang/ssl/type/SizeType.h"
 #include "boomerang/ssl/type/UnionType.h"
 #include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/type/StackFrameLayout.h"
 #include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expvisitor/ConstFinder.h"
@@ -56,6 +58,7 @@
 
 // idx + K; leave idx wild
 static const Binary unscaledArrayPat(opPlus, Terminal::get(opWild), Terminal::get(opWildIntConst));
+static const ExpPattern unscaledArrayPattern(unscaledArrayPat);
 
 
 DFATypeRecovery::DFATypeRecovery(Project *project)
@@ -121,6 +124,7 @@ static const Location scaledArrayPat(opMemOf,
                                                  Terminal::get(opWildIntConst)),
                                      nullptr);
 // clang-format on
+static const ExpPattern scaledArrayPattern(scaledArrayPat);
 
 
 void DFATypeRecovery::replaceArrayIndices(const SharedStmt &s)
@@ -129,7 +133,7 @@ void DFATypeRecovery::replaceArrayIndices(const SharedStmt &s)
     Prog *prog     = proc->getProg();
 
     std::list<SharedExp> result;
-    s->searchAll(scaledArrayPat, result);
+    s->searchAll(scaledArrayPattern, result);
 
     // We have m[idx*stride + base]
     // Rewrite it as globalN[idx] with addr(globalN) == base
@@ -147,7 +151,7 @@ void DFATypeRecovery::replaceArrayIndices(const SharedStmt &s)
 
         SharedExp array = Binary::get(opArrayIndex, Location::global(name, proc), idx);
 
-        if (s->searchAndReplace(scaledArrayPat, array)) {
+        if (s->searchAndReplace(scaledArrayPattern, array)) {
             if (s->isImplicit()) {
                 // Register an array of appropriate type
                 prog->markGlobalUsed(base,
@@ -215,6 +219,9 @@ void DFATypeRecovery::recoverFunctionTypes(Function *function)
     UserProc *up = dynamic_cast<UserProc *>(function);
     assert(up != nullptr);
 
+    // The locals of earlier rounds stay valid; later rounds only merge new types into them.
+    StackFrameLayout locals(up);
+
     do {
         if (first) {
             // Subscript the discovered extra parameters
@@ -224,7 +231,7 @@ void DFATypeRecovery::recoverFunctionTypes(Function *function)
         }
 
         first = false;
-        dfaTypeAnalysis(up);
+        dfaTypeAnalysis(up, locals);
 
         // There used to be a pass here to insert casts. This is best left until global type
         // analysis is complete, so do it just before translating from SSA form (which is the where
@@ -240,7 +247,7 @@ void DFATypeRecovery::recoverFunctionTypes(Function *function)
 }
 
 
-void DFATypeRecovery::dfaTypeAnalysis(UserProc *proc)
+void DFATypeRecovery::dfaTypeAnalysis(UserProc *proc, StackFrameLayout &locals)
 {
     ProcCFG *cfg = proc->getCFG();
     proc->getProg()->getProject()->alertDecompileDebugPoint(proc, "before data-flow type analysis");
@@ -248,15 +255,13 @@ void DFATypeRecovery::dfaTypeAnalysis(UserProc *proc)
     // First use the type information from the signature.
     // Sometimes needed to split variables
     bool ch = dfaTypeAnalysis(proc->getSignature().get(), cfg);
-    StatementList stmts;
-    proc->getStatements(stmts);
 
     int iter = 0;
 
     for (iter = 1; iter <= DFA_ITER_LIMIT; ++iter) {
         ch = false;
 
-        for (SharedStmt stmt : stmts) {
+        for (const SharedStmt &stmt : proc->getStatementView()) {
             SharedStmt before = nullptr;
 
             if (proc->getProg()->getProject()->getSettings()->debugTA) {
@@ -290,6 +295,10 @@ void DFATypeRecovery::dfaTypeAnalysis(UserProc *proc)
                     proc->getName());
     }
 
+    // Implicit assignments might be removed below, so iterate over a copy.
+    StatementList stmts;
+    proc->getStatements(stmts);
+
     if (proc->getProg()->getProject()->getSettings()->debugTA) {
         LOG_MSG("### Results for data-flow based type analysis for %1 ###", proc->getName());
         printResults(stmts, iter);
@@ -298,7 +307,7 @@ void DFATypeRecovery::dfaTypeAnalysis(UserProc *proc)
 
     // Now use the type information gathered
     Prog *_prog = proc->getProg();
-    DataIntervalMap localsMap(proc); // map of all local variables of proc
+    assert(locals.getProc() == proc);
 
     for (SharedStmt s : stmts) {
         // 1) constants
@@ -377,7 +386,7 @@ void DFATypeRecovery::dfaTypeAnalysis(UserProc *proc)
                     // can't get the parent of con, but we can find it with the pattern
                     // unscaledArrayPat.
                     std::list<SharedExp> result;
-                    s->searchAll(unscaledArrayPat, result);
+                    s->searchAll(unscaledArrayPattern, result);
 
                     for (auto &elem : result) {
                         // idx + K
@@ -411,7 +420,7 @@ void DFATypeRecovery::dfaTypeAnalysis(UserProc *proc)
                             cfg->removeImplicitAssign(s->as<ImplicitAssign>()->getLeft());
                         }
 
-                        if (!s->searchAndReplace(unscaledArrayPat, arr)) {
+                        if (!s->searchAndReplace(unscaledArrayPattern, arr)) {
                             arr = nullptr; // remove if not emplaced in s
                         }
 
@@ -487,8 +496,7 @@ void DFATypeRecovery::dfaTypeAnalysis(UserProc *proc)
                     "Type analysis for '%1': Adding addrExp '%2' with type %3 to local table",
                     proc->getName(), addrExp, ty);
                 SharedExp loc_mem = Location::memOf(addrExp);
-                localsMap.insertItem(Address(localAddressOffset), proc->lookupSym(loc_mem, ty),
-                                     typeExp);
+                locals.insertSlot(localAddressOffset, proc->lookupSym(loc_mem, ty), typeExp);
             }
         }
     }
@@ -527,18 +535,12 @@ bool DFATypeRecovery::doEllipsisProcessing(UserProc *proc)
 {
     bool ch = false;
 
-    for (IRFragment *frag : *proc->getCFG()) {
-        IRFragment::RTLRIterator rrit;
-        StatementList::reverse_iterator srit;
-        std::shared_ptr<CallStatement> c = std::dynamic_pointer_cast<CallStatement>(
-            frag->getLastStmt(rrit, srit));
-
-        // Note: we may have removed some statements, so there may no longer be a last statement!
-        if (c == nullptr) {
-            continue;
-        }
+    // Process all calls of the proc in one batch; the format strings are parsed only once
+    // per program, and calls that were already processed return early.
+    const std::vector<SharedStmt> calls = proc->getStatementsOfKind(StmtType::Call);
 
-        ch |= c->doEllipsisProcessing();
+    for (const SharedStmt &call : calls) {
+        ch |= call->as<CallStatement>()->doEllipsisProcessing();
     }
 
     if (ch) {
@@ -20,6 +20,7 @@
 
 class ProcCFG;
 class Signature;
+class StackFrameLayout;
 class StatementList;
 class UserProc;
 class Const;
@@ -51,7 +52,9 @@ public:
     void recoverFunctionTypes(Function *function) override;
 
 private:
-    void dfaTypeAnalysis(UserProc *proc);
+    /// \param locals Stack frame layout of \p proc. Kept across the rounds of
+    /// ellipsis processing, so the locals of earlier rounds are only merged with new types.
+    void dfaTypeAnalysis(UserProc *proc, StackFrameLayout &locals);
     bool dfaTypeAnalysis(Signature *signature, ProcCFG *cfg);
     //     bool dfaTypeAnalysis(const SharedStmt &stmt);
 
@@ -0,0 +1,82 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "EventBus.h"
+
+
+EventBus::EventBus()
+{
+}
+
+
+void EventBus::setListening(bool listening)
+{
+    m_listening.store(listening, std::memory_order_relaxed);
+}
+
+
+bool EventBus::publish(const DecompEvent &event)
+{
+    if (!isListening()) {
+        return false;
+    }
+
+    const uint32 tail = m_tail.load(std::memory_order_relaxed);
+    const uint32 head = m_head.load(std::memory_order_acquire);
+
+    if (tail - head >= CAPACITY) {
+        m_numDropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    m_events[tail & MASK] = event;
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+
+void EventBus::flushDecodeProgress()
+{
+    if (m_numPendingInsns == 0) {
+        return;
+    }
+
+    DecompEvent event;
+    event.kind     = DecompEvent::Kind::DecodeProgress;
+    event.addr     = m_lastDecodedAddr;
+    event.count    = m_numDecodedInsns;
+    event.numBytes = m_numDecodedBytes;
+
+    m_numPendingInsns = 0;
+    publish(event);
+}
+
+
+void EventBus::resetDecodeProgress()
+{
+    m_numPendingInsns = 0;
+    m_numDecodedInsns = 0;
+    m_numDecodedBytes = 0;
+    m_lastDecodedAddr = Address::INVALID;
+}
+
+
+bool EventBus::poll(DecompEvent &event)
+{
+    const uint32 head = m_head.load(std::memory_order_relaxed);
+    const uint32 tail = m_tail.load(std::memory_order_acquire);
+
+    if (head == tail) {
+        return false;
+    }
+
+    event = m_events[head & MASK];
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
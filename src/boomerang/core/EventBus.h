@@ -0,0 +1,153 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/util/Address.h"
+#include "boomerang/util/Types.h"
+
+#include <array>
+#include <atomic>
+
+
+/// A progress event of the decoder or decompiler.
+/// Functions are identified by their entry address, since they might be gone
+/// by the time the event is processed.
+struct DecompEvent
+{
+    enum class Kind : uint8_t
+    {
+        StartDecode,       ///< addr: lowest address to decode, numBytes: number of bytes
+        DecodeProgress,    ///< count/numBytes: instructions/bytes decoded so far, addr: last pc
+        BadDecode,         ///< addr: address of the invalid instruction
+        FunctionDecoded,   ///< addr: entry, endAddr: last address, numBytes: size of the function
+        EndDecode,         ///< count/numBytes: instructions/bytes decoded in total
+        StartDecompile,    ///< addr: entry of the proc
+        ProcStatusChanged, ///< addr: entry of the proc, status: new ProcStatus
+        EndDecompile,      ///< addr: entry of the proc
+        DecompilationEnd
+    };
+
+    Kind kind;
+    uint8_t status  = 0;
+    Address addr    = Address::INVALID;
+    Address endAddr = Address::INVALID;
+    uint64 count    = 0;
+    uint64 numBytes = 0;
+};
+
+
+/**
+ * Stream of progress events from the decompiler thread to an asynchronous consumer
+ * (e.g. the GUI, a progress bar or a metrics exporter).
+ *
+ * Events are stored in a lock-free single-producer single-consumer ring buffer.
+ * The producer never blocks: If the buffer is full, the event is dropped and counted.
+ * Decoded instructions are coalesced into one DecodeProgress event per
+ * \ref DECODE_BATCH_SIZE instructions, which carries running totals,
+ * so dropping progress events does not lose information.
+ *
+ * Nothing is recorded unless a consumer has called \ref setListening.
+ */
+class BOOMERANG_API EventBus
+{
+public:
+    /// Maximum number of events not yet consumed. Must be a power of 2.
+    static constexpr uint32 CAPACITY = 4096;
+
+    /// Number of decoded instructions per DecodeProgress event
+    static constexpr uint32 DECODE_BATCH_SIZE = 1024;
+
+public:
+    EventBus();
+    EventBus(const EventBus &other) = delete;
+    EventBus(EventBus &&other)      = delete;
+
+    ~EventBus() = default;
+
+    EventBus &operator=(const EventBus &other) = delete;
+    EventBus &operator=(EventBus &&other) = delete;
+
+public:
+    /// Start or stop recording events. Can be called from any thread.
+    void setListening(bool listening);
+    bool isListening() const { return m_listening.load(std::memory_order_relaxed); }
+
+    /// Add an event to the stream. Must only be called by the producer thread.
+    /// \returns false if the event was dropped (no listener or buffer full).
+    bool publish(const DecompEvent &event);
+
+    /// Count a decoded instruction, publishing a DecodeProgress event
+    /// every \ref DECODE_BATCH_SIZE instructions. Producer thread only.
+    void instructionDecoded(Address pc, int numBytes)
+    {
+        if (isListening()) {
+            m_numDecodedInsns++;
+            m_numDecodedBytes += numBytes;
+            m_lastDecodedAddr = pc;
+
+            if (++m_numPendingInsns >= DECODE_BATCH_SIZE) {
+                flushDecodeProgress();
+            }
+        }
+    }
+
+    /// Publish a DecodeProgress event for instructions counted since the last one.
+    /// Producer thread only.
+    void flushDecodeProgress();
+
+    /// Reset the running totals of decoded instructions. Producer thread only.
+    void resetDecodeProgress();
+
+    uint64 getNumDecodedInsns() const { return m_numDecodedInsns; }
+    uint64 getNumDecodedBytes() const { return m_numDecodedBytes; }
+
+    /// Take the oldest event from the stream. Must only be called by the consumer thread.
+    /// \returns false if there are no events.
+    bool poll(DecompEvent &event);
+
+    /// Pass all available events to \p handler. Consumer thread only.
+    /// \returns the number of events processed.
+    template<typename Handler>
+    int drain(Handler handler)
+    {
+        int numEvents = 0;
+        DecompEvent event;
+
+        while (poll(event)) {
+            handler(event);
+            numEvents++;
+        }
+
+        return numEvents;
+    }
+
+    /// \returns the number of events dropped because the buffer was full.
+    uint64 getNumDropped() const { return m_numDropped.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr uint32 MASK = CAPACITY - 1;
+    static_assert((CAPACITY & MASK) == 0, "CAPACITY must be a power of 2");
+
+    std::array<DecompEvent, CAPACITY> m_events;
+
+    // Keep the indices on separate cache lines, they are written by different threads.
+    alignas(64) std::atomic<uint32> m_head{ 0 }; ///< Index of the next event to poll
+    alignas(64) std::atomic<uint32> m_tail{ 0 }; ///< Index of the next event to publish
+    alignas(64) std::atomic<bool> m_listening{ false };
+    std::atomic<uint64> m_numDropped{ 0 };
+
+    // Producer side coalescing state
+    uint32 m_numPendingInsns = 0;
+    uint64 m_numDecodedInsns = 0;
+    uint64 m_numDecodedBytes = 0;
+    Address m_lastDecodedAddr;
+};
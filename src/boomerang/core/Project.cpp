@@ -9,6 +9,7 @@
 #pragma endregion License
 #include "Project.h"
 
+#include "boomerang/core/EventBus.h"
 #include "boomerang/core/Settings.h"
 #include "boomerang/core/Watcher.h"
 #include "boomerang/db/Prog.h"
@@ -22,6 +23,7 @@
 
 Project::Project()
     : m_settings(new Settings())
+    , m_eventBus(new EventBus())
     , m_pluginManager(new PluginManager(this))
 {
 }
@@ -220,11 +222,28 @@ bool Project::decompileBinaryFile()
     LOG_MSG("Decompiling...");
     ProgDecompiler dcomp(m_prog.get());
     dcomp.decompile();
+    alertDecompilationEnd();
 
     return true;
 }
 
 
+bool Project::refineProc(UserProc *proc)
+{
+    if (!m_prog || !m_fe) {
+        LOG_ERROR("Cannot refine procedure: No binary file is loaded.");
+        return false;
+    }
+    else if (!proc || !proc->isDecoded()) {
+        LOG_ERROR("Cannot refine procedure: Procedure is not decoded.");
+        return false;
+    }
+
+    ProgDecompiler(m_prog.get()).refineProc(proc);
+    return true;
+}
+
+
 bool Project::generateCode(Module *module)
 {
     if (!m_prog) {
@@ -236,6 +255,11 @@ bool Project::generateCode(Module *module)
         return false;
     }
 
+    else if (m_settings->streamDecompilation) {
+        // Code has been generated during decompilation already
+        return true;
+    }
+
     LOG_MSG("Generating code...");
     for (auto &plugin : m_pluginManager->getPluginsByType(PluginType::CodeGenerator)) {
         ICodeGenerator *gen = plugin->getIfc<ICodeGenerator>();
@@ -246,6 +270,39 @@ bool Project::generateCode(Module *module)
 }
 
 
+bool Project::generateProcCode(UserProc *proc)
+{
+    if (!m_prog) {
+        LOG_ERROR("Cannot generate code: No binary file is loaded.");
+        return false;
+    }
+
+    LOG_VERBOSE("Generating code for '%1'...", proc->getName());
+    for (auto &plugin : m_pluginManager->getPluginsByType(PluginType::CodeGenerator)) {
+        ICodeGenerator *gen = plugin->getIfc<ICodeGenerator>();
+        gen->generateCode(getProg(), proc->getModule(), proc);
+    }
+
+    return true;
+}
+
+
+bool Project::generateGlobalsCode()
+{
+    if (!m_prog) {
+        LOG_ERROR("Cannot generate code: No binary file is loaded.");
+        return false;
+    }
+
+    for (auto &plugin : m_pluginManager->getPluginsByType(PluginType::CodeGenerator)) {
+        ICodeGenerator *gen = plugin->getIfc<ICodeGenerator>();
+        gen->generateGlobals(getProg());
+    }
+
+    return true;
+}
+
+
 Prog *Project::createProg(BinaryFile *file, const QString &name)
 {
     if (!file) {
@@ -394,6 +451,12 @@ void Project::addWatcher(IWatcher *watcher)
 }
 
 
+EventBus *Project::getEventBus()
+{
+    return m_eventBus.get();
+}
+
+
 void Project::alertDecompileDebugPoint(UserProc *p, const QString &description)
 {
     p->debugPrintAll(description);
@@ -430,64 +493,92 @@ void Project::alertSignatureUpdated(Function *function)
 
 void Project::alertInstructionDecoded(Address pc, int numBytes)
 {
-    for (IWatcher *it : m_watchers) {
-        it->onInstructionDecoded(pc, numBytes);
-    }
+    m_eventBus->instructionDecoded(pc, numBytes);
 }
 
 
 void Project::alertBadDecode(Address pc)
 {
-    for (IWatcher *it : m_watchers) {
-        it->onBadDecode(pc);
+    if (m_eventBus->isListening()) {
+        DecompEvent event;
+        event.kind = DecompEvent::Kind::BadDecode;
+        event.addr = pc;
+        m_eventBus->publish(event);
     }
 }
 
 
 void Project::alertFunctionDecoded(Function *p, Address pc, Address last, int numBytes)
 {
-    for (IWatcher *it : m_watchers) {
-        it->onFunctionDecoded(p, pc, last, numBytes);
+    if (m_eventBus->isListening()) {
+        DecompEvent event;
+        event.kind     = DecompEvent::Kind::FunctionDecoded;
+        event.addr     = p ? p->getEntryAddress() : pc;
+        event.endAddr  = last;
+        event.numBytes = numBytes;
+        m_eventBus->publish(event);
     }
 }
 
 
 void Project::alertStartDecode(Address start, int numBytes)
 {
-    for (IWatcher *it : m_watchers) {
-        it->onStartDecode(start, numBytes);
+    m_eventBus->resetDecodeProgress();
+
+    if (m_eventBus->isListening()) {
+        DecompEvent event;
+        event.kind     = DecompEvent::Kind::StartDecode;
+        event.addr     = start;
+        event.numBytes = numBytes;
+        m_eventBus->publish(event);
     }
 }
 
 
 void Project::alertEndDecode()
 {
-    for (IWatcher *it : m_watchers) {
-        it->onEndDecode();
+    if (m_eventBus->isListening()) {
+        m_eventBus->flushDecodeProgress();
+
+        DecompEvent event;
+        event.kind     = DecompEvent::Kind::EndDecode;
+        event.count    = m_eventBus->getNumDecodedInsns();
+        event.numBytes = m_eventBus->getNumDecodedBytes();
+        m_eventBus->publish(event);
     }
 }
 
 
 void Project::alertStartDecompile(UserProc *proc)
 {
-    for (IWatcher *it : m_watchers) {
-        it->onStartDecompile(proc);
+    if (m_eventBus->isListening()) {
+        DecompEvent event;
+        event.kind = DecompEvent::Kind::StartDecompile;
+        event.addr = proc->getEntryAddress();
+        m_eventBus->publish(event);
     }
 }
 
 
 void Project::alertProcStatusChanged(UserProc *proc)
 {
-    for (IWatcher *it : m_watchers) {
-        it->onProcStatusChange(proc);
+    if (m_eventBus->isListening()) {
+        DecompEvent event;
+        event.kind   = DecompEvent::Kind::ProcStatusChanged;
+        event.addr   = proc->getEntryAddress();
+        event.status = static_cast<uint8_t>(proc->getStatus());
+        m_eventBus->publish(event);
     }
 }
 
 
 void Project::alertEndDecompile(UserProc *proc)
 {
-    for (IWatcher *it : m_watchers) {
-        it->onEndDecompile(proc);
+    if (m_eventBus->isListening()) {
+        DecompEvent event;
+        event.kind = DecompEvent::Kind::EndDecompile;
+        event.addr = proc->getEntryAddress();
+        m_eventBus->publish(event);
     }
 }
 
@@ -510,8 +601,10 @@ void Project::alertDecompiling(UserProc *proc)
 
 void Project::alertDecompilationEnd()
 {
-    for (IWatcher *w : m_watchers) {
-        w->onDecompilationEnd();
+    if (m_eventBus->isListening()) {
+        DecompEvent event;
+        event.kind = DecompEvent::Kind::DecompilationEnd;
+        m_eventBus->publish(event);
     }
 }
 
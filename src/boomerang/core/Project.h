@@ -21,6 +21,7 @@
 
 
 class BinaryFile;
+class EventBus;
 class Function;
 class ICodeGenerator;
 class IFrontEnd;
@@ -117,17 +118,39 @@ public:
      */
     bool decompileBinaryFile();
 
+    /**
+     * Decompile the single procedure \p proc again with all analyses,
+     * e.g. after a quick decompilation (\sa Settings::decompileTier).
+     * Code has to be generated again afterwards.
+     * \returns true on success, false if no binary is decompiled or an error occurred.
+     */
+    bool refineProc(UserProc *proc);
+
     /**
      * Generate code for \p module, or all modules if \p module is nullptr.
      * \returns true on success, false if no binary is decompiled or an error occurred.
      */
     bool generateCode(Module *module = nullptr);
 
+    /**
+     * Generate code for the single procedure \p proc, appending it to the output
+     * of its module. Used for streaming decompilation.
+     * \returns true on success, false if no binary is decompiled or an error occurred.
+     */
+    bool generateProcCode(UserProc *proc);
+
+    /// Generate declarations for all global variables after all procedures
+    /// have been generated by \ref generateProcCode.
+    bool generateGlobalsCode();
+
 public:
     /// Register a watcher to receive events about the decompilation.
     /// Does NOT take ownership of the pointer.
     void addWatcher(IWatcher *watcher);
 
+    /// \returns the stream of progress events of this project.
+    EventBus *getEventBus();
+
     /// Called once after a function was created.
     void alertFunctionCreated(Function *function);
 
@@ -137,10 +160,12 @@ public:
     /// Called once after the function signature was updated.
     void alertSignatureUpdated(Function *function);
 
+    // The alerts below up to alertDecompilationEnd are only published on the event bus.
+
     /// Called once on decode start.
     void alertStartDecode(Address start, int numBytes);
 
-    /// Called every time an instruction is decoded.
+    /// Called every time an instruction is decoded. Instructions are reported in batches.
     /// \param numBytes size of the instruction
     void alertInstructionDecoded(Address pc, int numBytes);
 
@@ -162,6 +187,9 @@ public:
     /// Called once for every completely decompiled proc \p proc.
     void alertEndDecompile(UserProc *proc);
 
+    /// Called once on decompilation end.
+    void alertDecompilationEnd();
+
     /// Called every time before middleDecompile is executed for \p function
     void alertDiscovered(Function *function);
 
@@ -170,9 +198,6 @@ public:
 
     void alertDecompileDebugPoint(UserProc *p, const QString &description);
 
-    /// Called once on decompilation end.
-    void alertDecompilationEnd();
-
 private:
     /// Get the best loader that is able to load the file at \p filePath
     IFileLoader *getBestLoader(const QString &filePath) const;
@@ -210,6 +235,9 @@ private:
     /// The watchers which are interested in this decompilation.
     std::set<IWatcher *> m_watchers;
 
+    /// Progress events for asynchronous consumers
+    std::unique_ptr<EventBus> m_eventBus;
+
     std::unique_ptr<PluginManager> m_pluginManager;
 
     std::unique_ptr<BinaryFile> m_loadedBinary;
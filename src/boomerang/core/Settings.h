@@ -19,6 +19,23 @@
 #include <vector>
 
 
+/// When to free the machine instructions of basic blocks (\sa BasicBlock::releaseInsns)
+enum class InsnRetention : uint8_t
+{
+    Keep,           ///< Keep all machine instructions until the program is unloaded
+    AfterDecompile, ///< Free them when their procedure is fully decompiled
+    AfterLift       ///< Free them as soon as their procedure has been lifted
+};
+
+
+/// How thoroughly procedures are analysed (\sa Project::refineProc)
+enum class DecompileTier : uint8_t
+{
+    Quick, ///< Tier 0: Lifting, SSA and a single propagation pass only
+    Full   ///< Tier 1: All analyses, including preservation and unused return removal
+};
+
+
 /**
  * Settings that affect decompilation and output behaviour.
  */
@@ -75,6 +92,7 @@ public:
     bool decodeThruIndCall = false;
     bool decodeChildren    = true;
     bool useProof          = true;
+    int proofStepLimit     = 100000; ///< Max steps of a single preservation proof (0 = no limit)
     bool changeSignatures  = true;
     bool useTypeAnalysis   = true;
     int propMaxDepth       = 3; ///< Max depth of exp that'll be propagated to more than one dest
@@ -83,6 +101,34 @@ public:
     bool useGlobals        = true;
     bool assumeABI         = false; ///< Assume ABI compliance
 
+    /// Generate code for each procedure as soon as it and all its callers are decompiled,
+    /// and free its IR afterwards. This bounds memory usage for very large binaries,
+    /// but global analyses (e.g. removal of unused returns) are not performed.
+    bool streamDecompilation = false;
+
+    /// Freed machine instructions are disassembled again on demand (e.g. for printing),
+    /// so this trades decoding time for memory.
+    InsnRetention insnRetention = InsnRetention::Keep;
+
+    /// Budgets for the analysis of a single procedure (0 = no limit).
+    /// A procedure exceeding one of its budgets is finalized with the analysis done so far
+    /// and flagged in the generated code.
+    int procTimeLimit = 0; ///< Max wall clock time per procedure in seconds
+    int procPassLimit = 0; ///< Max number of analysis passes executed per procedure
+    int procStmtLimit = 0; ///< Max number of statements of a procedure
+
+    /// After this many seconds (0 = no limit), all procedures that are not decompiled yet
+    /// are finalized after as little analysis as possible.
+    int decompileTimeLimit = 0;
+
+    /// With DecompileTier::Quick, code for all procedures is generated after minimal
+    /// analysis. Single procedures can then be refined with all analyses on demand.
+    DecompileTier decompileTier = DecompileTier::Full;
+
+    /// Number of threads for the late per-procedure phases (transformation out of SSA form,
+    /// CFG compression, search for used globals). 0 = number of hardware threads.
+    int numThreads = 0;
+
     QString replayFile;  ///< file with commands to execute in interactive mode
     QString sslFileName; ///< Use this SSL file instead of one of the hard-coded ones.
 
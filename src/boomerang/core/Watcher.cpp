@@ -25,46 +25,6 @@ void IWatcher::onSignatureUpdated(Function *)
 }
 
 
-void IWatcher::onInstructionDecoded(Address, int)
-{
-}
-
-
-void IWatcher::onBadDecode(Address)
-{
-}
-
-
-void IWatcher::onStartDecode(Address, int)
-{
-}
-
-
-void IWatcher::onEndDecode()
-{
-}
-
-
-void IWatcher::onFunctionDecoded(Function *, Address, Address, int)
-{
-}
-
-
-void IWatcher::onStartDecompile(UserProc *)
-{
-}
-
-
-void IWatcher::onProcStatusChange(UserProc *)
-{
-}
-
-
-void IWatcher::onEndDecompile(UserProc *)
-{
-}
-
-
 void IWatcher::onFunctionDiscovered(Function *)
 {
 }
@@ -78,8 +38,3 @@ void IWatcher::onDecompileInProgress(UserProc *)
 void IWatcher::onDecompileDebugPoint(UserProc *, const char *)
 {
 }
-
-
-void IWatcher::onDecompilationEnd()
-{
-}
@@ -11,14 +11,17 @@
 
 
 #include "boomerang/core/BoomerangAPI.h"
-#include "boomerang/util/Address.h"
 
 
 class Function;
 class UserProc;
 
 
-/// Virtual class to monitor the decompilation.
+/**
+ * Virtual class to monitor the decompilation. Watchers are called synchronously
+ * on the decompiler thread. Progress of decoding and decompilation
+ * is reported asynchronously by the EventBus of the Project instead.
+ */
 class BOOMERANG_API IWatcher
 {
 public:
@@ -35,31 +38,6 @@ public:
     /// Called once after the function signature was updated.
     virtual void onSignatureUpdated(Function *function);
 
-    /// Called once on decode start.
-    virtual void onStartDecode(Address start, int numBytes);
-
-    /// Called every time an instruction is decoded.
-    /// \param numBytes the size of the instruction.
-    virtual void onInstructionDecoded(Address pc, int numBytes);
-
-    /// Called every time a function was decoded completely.
-    virtual void onFunctionDecoded(Function *function, Address pc, Address last, int numBytes);
-
-    /// Called every time an invalid or unrecognized instruction is encountered.
-    virtual void onBadDecode(Address pc);
-
-    /// Called once on decode end.
-    virtual void onEndDecode();
-
-    /// Called once for every function on decompilation start (before earlyDecompile)
-    virtual void onStartDecompile(UserProc *proc);
-
-    /// Called every time the status of \p proc has changed.
-    virtual void onProcStatusChange(UserProc *proc);
-
-    /// Called once for every completely decompiled proc \p proc
-    virtual void onEndDecompile(UserProc *proc);
-
     /// Called every time before middleDecompile is executed for \p function
     virtual void onFunctionDiscovered(Function *function);
 
@@ -68,7 +46,4 @@ public:
 
     /// Called when a decompilation breakpoint occurs.
     virtual void onDecompileDebugPoint(UserProc *proc, const char *description);
-
-    /// Called once on decompilation end.
-    virtual void onDecompilationEnd();
 };
@@ -9,6 +9,18 @@
 #pragma endregion License
 #include "BasicBlock.h"
 
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ifc/IFrontEnd.h"
+#include "boomerang/util/log/Log.h"
+
+#include <atomic>
+#include <mutex>
+
+
+static std::atomic<int> g_numReloads{ 0 };
+static std::mutex g_reloadMutex;
+
 
 BasicBlock::BasicBlock(Address lowAddr)
     : m_bbType(BBType::Invalid)
@@ -71,6 +83,64 @@ void BasicBlock::completeBB(const std::vector<MachineInstruction> &insns)
 }
 
 
+void BasicBlock::releaseInsns()
+{
+    if (m_insns.empty() || m_proc == nullptr) {
+        return;
+    }
+
+    const int numInsns = static_cast<int>(m_insns.size());
+    m_releasedEndAddr  = m_insns.back().m_addr + m_insns.back().m_size;
+
+    std::vector<MachineInstruction>().swap(m_insns); // also free the storage
+    m_numReleasedInsns = numInsns;
+}
+
+
+int BasicBlock::getNumReloads()
+{
+    return g_numReloads;
+}
+
+
+void BasicBlock::reloadInsns() const
+{
+    std::lock_guard<std::mutex> guard(g_reloadMutex);
+
+    const int numInsns = m_numReleasedInsns;
+    if (numInsns == 0) {
+        return; // reloaded by another thread in the meantime
+    }
+
+    assert(m_proc != nullptr);
+    assert(m_insns.empty());
+    g_numReloads++;
+
+    IFrontEnd *fe = m_proc->getProg()->getFrontEnd();
+    m_insns.reserve(numInsns);
+
+    for (Address pc = m_lowAddr; pc < m_releasedEndAddr;) {
+        MachineInstruction insn;
+
+        if (!fe->disassembleInstruction(pc, insn) || insn.m_size == 0) {
+            LOG_ERROR("Cannot disassemble instruction at address %1 again", pc);
+            break;
+        }
+
+        pc += insn.m_size;
+        m_insns.push_back(std::move(insn));
+    }
+
+    m_numReleasedInsns = 0;
+
+    if (static_cast<int>(m_insns.size()) != numInsns) {
+        LOG_WARN("BB at address %1 had %2 instructions, but %3 instructions were disassembled "
+                 "again",
+                 m_lowAddr, numInsns, m_insns.size());
+    }
+}
+
+
 QString BasicBlock::toString() const
 {
     QString tgt;
@@ -110,7 +180,7 @@ void BasicBlock::print(OStream &os) const
 
     os << "\n";
 
-    for (const MachineInstruction &insn : m_insns) {
+    for (const MachineInstruction &insn : getInsns()) {
         os << insn.m_addr << " " << insn.m_mnem.data() << " " << insn.m_opstr.data() << "\n";
     }
 }
@@ -16,6 +16,7 @@
 #include "boomerang/ssl/RTL.h"
 #include "boomerang/util/Address.h"
 
+#include <atomic>
 #include <vector>
 
 
@@ -97,11 +98,41 @@ public:
     inline Address getLowAddr() const { return m_lowAddr; }
     inline Address getHiAddr() const { return m_highAddr; }
 
-    inline bool isComplete() const { return !m_insns.empty(); }
+    inline bool isComplete() const { return !m_insns.empty() || hasReleasedInsns(); }
 
 public:
-    std::vector<MachineInstruction> &getInsns() { return m_insns; }
-    const std::vector<MachineInstruction> &getInsns() const { return m_insns; }
+    /// \returns the machine instructions of this BB.
+    /// Released instructions are disassembled again first. This is safe to do
+    /// from several threads at once (e.g. the workers of parallel passes),
+    /// as long as no thread releases the instructions at the same time.
+    std::vector<MachineInstruction> &getInsns()
+    {
+        loadInsns();
+        return m_insns;
+    }
+
+    const std::vector<MachineInstruction> &getInsns() const
+    {
+        loadInsns();
+        return m_insns;
+    }
+
+    /**
+     * Free the machine instructions of this BB. They are disassembled again from
+     * the binary image the next time they are accessed, so this only saves memory
+     * if the instructions are not needed any more (e.g. after lifting).
+     * Only BBs that belong to a procedure can release their instructions.
+     * Must not be called while other threads might access the instructions of this BB.
+     * \sa Settings::insnRetention
+     */
+    void releaseInsns();
+
+    /// \returns true if the instructions of this BB have been released and not reloaded yet.
+    bool hasReleasedInsns() const { return m_numReleasedInsns > 0; }
+
+    /// \returns the number of times released instructions had to be disassembled again,
+    /// summed over all BBs.
+    static int getNumReloads();
 
     /**
      * Update the RTL list of this basic block. Takes ownership of the pointer.
@@ -119,8 +150,27 @@ public:
 
     QString toString() const;
 
+private:
+    void loadInsns() const
+    {
+        if (hasReleasedInsns()) {
+            reloadInsns();
+        }
+    }
+
+    /// Disassemble the released instructions again.
+    /// Reloads are serialized, so that only one thread reloads the instructions
+    /// and the decoder is not used concurrently.
+    void reloadInsns() const;
+
 protected:
-    std::vector<MachineInstruction> m_insns;
+    /// Mutable since released instructions are reloaded by const accessors
+    mutable std::vector<MachineInstruction> m_insns;
+
+    /// 0 if the instructions are not released. Only set to 0 after \ref m_insns
+    /// has been reloaded, so threads that see 0 also see the reloaded instructions.
+    mutable std::atomic<int> m_numReleasedInsns{ 0 };
+    Address m_releasedEndAddr      = Address::INVALID; ///< End of the last released instruction
 
     /// The function this BB is part of, or nullptr if this BB is not part of a function.
     UserProc *m_proc = nullptr;
@@ -9,6 +9,8 @@
 #pragma endregion License
 #include "DefCollector.h"
 
+#include "boomerang/db/RenameStacks.h"
+#include "boomerang/ssl/exp/ExpPattern.h"
 #include "boomerang/ssl/exp/RefExp.h"
 #include "boomerang/util/Util.h"
 
@@ -69,17 +71,18 @@ SharedExp DefCollector::findDefFor(const SharedExp &e) const
 }
 
 
-void DefCollector::updateDefs(std::map<SharedExp, std::stack<SharedStmt>, lessExpStar> &Stacks,
-                              UserProc *proc)
+void DefCollector::updateDefs(const RenameStacks &stacks, UserProc *proc)
 {
-    for (auto &Stack : Stacks) {
-        if (Stack.second.empty()) {
+    for (RenameStacks::LocID id = 0; id < stacks.getNumLocs(); id++) {
+        const SharedStmt def = stacks.getTop(id);
+        if (!def) {
             continue; // This variable's definition doesn't reach here
         }
 
         // Create an assignment of the form loc := loc{def}
-        auto re = RefExp::get(Stack.first->clone(), Stack.second.top());
-        std::shared_ptr<Assign> as(new Assign(Stack.first->clone(), re));
+        const SharedExp &loc = stacks.getLoc(id);
+        auto re              = RefExp::get(loc->clone(), def);
+        std::shared_ptr<Assign> as(new Assign(loc->clone(), re));
         as->setProc(proc); // Simplify sometimes needs this
         collectDef(as);
     }
@@ -88,8 +91,9 @@ void DefCollector::updateDefs(std::map<SharedExp, std::stack<SharedStmt>, lessEx
 
 void DefCollector::searchReplaceAll(const Exp &from, SharedExp to, bool &changed)
 {
+    const ExpPattern pattern(from);
     for (auto def : m_defs) {
-        changed |= def->searchAndReplace(from, to);
+        changed |= def->searchAndReplace(pattern, to);
     }
 }
 
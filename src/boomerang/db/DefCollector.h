@@ -13,10 +13,7 @@
 #include "boomerang/ssl/exp/ExpHelp.h"
 #include "boomerang/util/StatementSet.h"
 
-#include <map>
-#include <stack>
-
-
+class RenameStacks;
 class Statement;
 class UserProc;
 
@@ -66,8 +63,7 @@ public:
 
     /// Update the definitions with the current set of reaching definitions
     /// \p proc is the enclosing procedure
-    void updateDefs(std::map<SharedExp, std::stack<SharedStmt>, lessExpStar> &Stacks,
-                    UserProc *proc);
+    void updateDefs(const RenameStacks &stacks, UserProc *proc);
 
     /// Search and replace all occurrences
     void searchReplaceAll(const Exp &pattern, SharedExp replacement, bool &change);
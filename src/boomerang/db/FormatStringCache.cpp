@@ -0,0 +1,260 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "FormatStringCache.h"
+
+#include "boomerang/ssl/type/ArrayType.h"
+#include "boomerang/ssl/type/CharType.h"
+#include "boomerang/ssl/type/FloatType.h"
+#include "boomerang/ssl/type/IntegerType.h"
+#include "boomerang/ssl/type/PointerType.h"
+#include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/util/Address.h"
+
+#include <QRegularExpression>
+
+
+FormatParams FormatStringCache::getParams(const QString &fmtStr, bool isScanf)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    QHash<QString, FormatParams> &params = isScanf ? m_scanfParams : m_printfParams;
+    auto it                              = params.find(fmtStr);
+
+    if (it != params.end()) {
+        m_numHits++;
+        return it.value();
+    }
+
+    return params.insert(fmtStr, parse(fmtStr, isScanf)).value();
+}
+
+
+void FormatStringCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_printfParams.clear();
+    m_scanfParams.clear();
+    m_numHits = 0;
+}
+
+
+int FormatStringCache::getNumParsed() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_printfParams.size() + m_scanfParams.size();
+}
+
+
+int FormatStringCache::getNumHits() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numHits;
+}
+
+
+FormatParams FormatStringCache::parse(const QString &fmtStr, bool isScanf)
+{
+    // clang-format off
+    static const QRegularExpression re(
+        "%("                                 // '%' followed by either ...
+          "(?<flags>[+-0 #]*)"               //   flags (opt), ...
+          "(?<width>([0-9\\*]*))"            //   width (opt, digits or *), ...
+          "(?<prec>((\\.[0-9\\*]+)?))"       //   precision (opt, dot followed by digits or *), ...
+          "(?<mod>[hlLzjt]*)"                //   size modifier (opt), and ...
+          "(?<spec>([%diufFeEgGxXaAoscpn]))" //   the actual specifier, ...
+        "|"                                  // or ...
+          "(?<list>l?\\[\\^?[^\\]]+\\])"     //   a list of characters to (not) match (scanf only)
+        ")");
+    // clang-format on
+
+    FormatParams params;
+    auto addParam = [&params](SharedType ty, bool addPointer) {
+        params.push_back({ ty, addPointer });
+    };
+
+    auto it = re.globalMatch(fmtStr);
+
+    while (it.hasNext()) {
+        auto match = it.next();
+
+        const QString width = match.captured("width");
+        const QString prec  = match.captured("prec");
+        const QString mod   = match.captured("mod");
+        const QString list  = match.captured("list");
+        const QString spec  = match.captured("spec");
+
+        if (isScanf && list != "") {
+            if (list[0] == "l") {
+                addParam(ArrayType::get(IntegerType::get(16, Sign::Signed)), true); // wchar_t
+            }
+            else {
+                addParam(ArrayType::get(CharType::get()), true);
+            }
+
+            continue;
+        }
+
+        if (isScanf && width.startsWith("*")) {
+            // We have something like %*3d. No output parameter.
+            continue;
+        }
+
+        if (width == "*") {
+            addParam(IntegerType::get(32, Sign::Signed), false);
+        }
+
+        if (prec == ".*") {
+            addParam(IntegerType::get(32, Sign::Signed), false);
+        }
+
+        switch (spec[0].toLatin1()) {
+        case 'd':
+        case 'i':
+            if (mod == "") {
+                addParam(IntegerType::get(32, Sign::Signed), isScanf);
+            }
+            else if (mod == "hh") {
+                addParam(IntegerType::get(8, Sign::Signed), isScanf);
+            }
+            else if (mod == "h") {
+                addParam(IntegerType::get(16, Sign::Signed), isScanf);
+            }
+            else if (mod == "l") {
+                addParam(IntegerType::get(32, Sign::Signed), isScanf);
+            }
+            else if (mod == "ll") {
+                addParam(IntegerType::get(64, Sign::Signed), isScanf);
+            }
+            else if (mod == "j") {
+                addParam(IntegerType::get(32, Sign::Signed), isScanf);
+            }
+            else if (mod == "z") { // size_t
+                addParam(IntegerType::get(STD_SIZE, Sign::Unsigned), isScanf);
+            }
+            else if (mod == "t") { // ptrdiff_t
+                addParam(IntegerType::get(STD_SIZE, Sign::Signed), isScanf);
+            }
+            break;
+
+        case 'X':
+            if (isScanf) {
+                break; // not valid for scanf
+            }
+            // fallthrough
+        case 'u':
+        case 'o':
+        case 'x':
+            if (mod == "") {
+                addParam(IntegerType::get(32, Sign::Unsigned), isScanf);
+            }
+            else if (mod == "hh") {
+                addParam(IntegerType::get(8, Sign::Unsigned), isScanf);
+            }
+            else if (mod == "h") {
+                addParam(IntegerType::get(16, Sign::Unsigned), isScanf);
+            }
+            else if (mod == "l") {
+                addParam(IntegerType::get(32, Sign::Unsigned), isScanf);
+            }
+            else if (mod == "ll") {
+                addParam(IntegerType::get(64, Sign::Unsigned), isScanf);
+            }
+            else if (mod == "j") {
+                addParam(IntegerType::get(32, Sign::Unsigned), isScanf);
+            }
+            else if (mod == "z") { // size_t
+                addParam(IntegerType::get(STD_SIZE, Sign::Unsigned), isScanf);
+            }
+            else if (mod == "t") { // ptrdiff_t
+                addParam(IntegerType::get(STD_SIZE, Sign::Signed), isScanf);
+            }
+            break;
+
+        case 'A':
+        case 'E':
+        case 'F':
+        case 'G':
+            if (isScanf) {
+                break; // these are not valid for scanf
+            }
+            // fallthrough
+        case 'a':
+        case 'f':
+        case 'e':
+        case 'g':
+            if (mod == "") {
+                addParam(FloatType::get(isScanf ? 32 : 64), isScanf);
+            }
+            else if (mod == "L") {
+                addParam(FloatType::get(128), isScanf);
+            }
+            else if (mod == "l" && isScanf) {
+                addParam(FloatType::get(64), true);
+            }
+            break;
+
+        case 'c':
+            if (mod == "") {
+                addParam(CharType::get(), isScanf);
+            }
+            else if (mod == "l") {
+                addParam(IntegerType::get(16, Sign::Signed), isScanf);
+            }
+            break;
+
+        case 's':
+            if (mod == "") {
+                addParam(ArrayType::get(CharType::get()), true);
+            }
+            else if (mod == "l") {
+                addParam(ArrayType::get(IntegerType::get(16, Sign::Signed)), true);
+            }
+            break;
+
+        case 'p':
+            if (mod == "") {
+                addParam(PointerType::get(VoidType::get()), isScanf);
+            }
+            break;
+
+        case 'n':
+            if (mod == "") {
+                addParam(IntegerType::get(32, Sign::Signed), true);
+            }
+            else if (mod == "hh") {
+                addParam(IntegerType::get(8, Sign::Signed), true);
+            }
+            else if (mod == "h") {
+                addParam(IntegerType::get(16, Sign::Signed), true);
+            }
+            else if (mod == "l") {
+                addParam(IntegerType::get(32, Sign::Signed), true);
+            }
+            else if (mod == "ll") {
+                addParam(IntegerType::get(64, Sign::Signed), true);
+            }
+            else if (mod == "j") {
+                addParam(IntegerType::get(32, Sign::Signed), true);
+            }
+            else if (mod == "z") { // size_t
+                addParam(IntegerType::get(STD_SIZE, Sign::Unsigned), true);
+            }
+            else if (mod == "t") { // ptrdiff_t
+                addParam(IntegerType::get(STD_SIZE, Sign::Signed), true);
+            }
+            break;
+
+        case '%': break;
+        }
+    }
+
+    return params;
+}
@@ -0,0 +1,66 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/ssl/type/Type.h"
+
+#include <QHash>
+#include <QString>
+
+#include <mutex>
+#include <vector>
+
+
+/// A parameter of a printf or scanf style function described by a format string
+struct FormatParam
+{
+    SharedType type; ///< Type of the parameter, or of the pointed-to value if \ref addPointer
+    bool addPointer; ///< true if the parameter is a pointer to \ref type
+};
+
+typedef std::vector<FormatParam> FormatParams;
+
+
+/**
+ * Parameters described by the format strings of printf and scanf style calls.
+ *
+ * The same format strings are usually passed to many calls, and the ellipsis processing
+ * of a call might be done several times (for each round of type analysis, and for each
+ * re-analysis of a recursion group), so each format string is only parsed once.
+ * Thread safe.
+ */
+class BOOMERANG_API FormatStringCache
+{
+public:
+    FormatStringCache() = default;
+
+public:
+    /// \returns the parameters after the format string described by \p fmtStr.
+    /// The types are shared with other callers and must be cloned before modifying them.
+    FormatParams getParams(const QString &fmtStr, bool isScanf);
+
+    /// Remove all parsed format strings.
+    void clear();
+
+    int getNumParsed() const;
+    int getNumHits() const;
+
+    /// Parse \p fmtStr without using the cache.
+    static FormatParams parse(const QString &fmtStr, bool isScanf);
+
+private:
+    mutable std::mutex m_mutex;
+
+    QHash<QString, FormatParams> m_printfParams; ///< Format string -> parameters
+    QHash<QString, FormatParams> m_scanfParams;  ///< Format string -> parameters
+    int m_numHits = 0;
+};
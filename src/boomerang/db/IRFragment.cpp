@@ -246,6 +246,7 @@ std::shared_ptr<ImplicitAssign> IRFragment::addImplicitAssign(const SharedExp &l
 
     if (m_listOfRTLs->empty() || m_listOfRTLs->front()->getAddress() != Address::ZERO) {
         m_listOfRTLs->push_front(std::unique_ptr<RTL>(new RTL(Address::ZERO)));
+        m_listOfRTLs->front()->setModificationStamp(m_modificationStamp);
     }
 
     // do not allow BB with 2 zero address RTLs
@@ -283,6 +284,7 @@ std::shared_ptr<PhiAssign> IRFragment::addPhi(const SharedExp &usedExp)
 
     if (m_listOfRTLs->empty() || m_listOfRTLs->front()->getAddress() != Address::ZERO) {
         m_listOfRTLs->push_front(std::unique_ptr<RTL>(new RTL(Address::ZERO)));
+        m_listOfRTLs->front()->setModificationStamp(m_modificationStamp);
     }
 
     // do not allow BB with 2 zero address RTLs
@@ -365,6 +367,39 @@ void IRFragment::removeRTL(RTL *rtl)
 }
 
 
+void IRFragment::setModificationStamp(uint64 *stamp)
+{
+    m_modificationStamp = stamp;
+
+    if (m_listOfRTLs) {
+        for (const std::unique_ptr<RTL> &rtl : *m_listOfRTLs) {
+            rtl->setModificationStamp(stamp);
+        }
+    }
+}
+
+
+RTL *IRFragment::findRTLOf(const SharedConstStmt &stmt)
+{
+    if (!stmt || !m_listOfRTLs) {
+        return nullptr;
+    }
+
+    RTL *rtl = stmt->getRTL();
+    if (rtl && rtl->find(stmt) != rtl->end()) {
+        return rtl;
+    }
+
+    for (auto &fragRTL : *m_listOfRTLs) {
+        if (fragRTL->find(stmt) != fragRTL->end()) {
+            return fragRTL.get();
+        }
+    }
+
+    return nullptr;
+}
+
+
 Address IRFragment::getLowAddr() const
 {
     return m_lowAddr;
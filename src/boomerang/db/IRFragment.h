@@ -85,6 +85,14 @@ public:
 
     void removeRTL(RTL *rtl);
 
+    /// Count insertions and removals of statements of this fragment in \p stamp.
+    /// \sa ProcCFG::getModificationStamp
+    void setModificationStamp(uint64 *stamp);
+
+    /// \returns the RTL of this fragment that contains \p stmt, or nullptr if there is none.
+    /// O(1) if \p stmt was last inserted into one of the RTLs of this fragment.
+    RTL *findRTLOf(const SharedConstStmt &stmt);
+
 public:
     /// \returns the lowest real address associated with this fragement.
     /// \sa updateAddresses
@@ -180,6 +188,7 @@ public:
     FragType m_fragType = FragType::Invalid;
     BasicBlock *m_bb;
     std::unique_ptr<RTLList> m_listOfRTLs = nullptr; ///< Ptr to list of RTLs
+    uint64 *m_modificationStamp           = nullptr; ///< \sa setModificationStamp
 
     Address m_lowAddr  = Address::ZERO;
     Address m_highAddr = Address::INVALID;
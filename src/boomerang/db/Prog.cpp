@@ -12,6 +12,7 @@
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/DebugInfo.h"
+#include "boomerang/db/FormatStringCache.h"
 #include "boomerang/db/Global.h"
 #include "boomerang/db/LowLevelCFG.h"
 #include "boomerang/db/binary/BinaryFile.h"
@@ -19,6 +20,7 @@
 #include "boomerang/db/binary/BinarySection.h"
 #include "boomerang/db/binary/BinarySymbol.h"
 #include "boomerang/db/binary/BinarySymbolTable.h"
+#include "boomerang/db/binary/DataScanner.h"
 #include "boomerang/db/module/Module.h"
 #include "boomerang/db/proc/LibProc.h"
 #include "boomerang/db/proc/ProcCFG.h"
@@ -56,9 +58,19 @@ Prog::Prog(const QString &name, Project *project)
     , m_binaryFile(project ? project->getLoadedBinaryFile() : nullptr)
     , m_fe(nullptr)
     , m_cfg(new LowLevelCFG)
+    , m_formatStrings(new FormatStringCache)
 {
     m_rootModule = getOrInsertModule(getName());
     assert(m_rootModule != nullptr);
+
+    if (m_binaryFile && m_binaryFile->getImage()) {
+        const int pointerSize = m_binaryFile->getBitness() == 64 ? 8 : 4;
+        m_dataScanner.reset(new DataScanner(m_binaryFile->getImage(), pointerSize));
+        m_dataScanner->scanImage();
+
+        LOG_VERBOSE("Found %1 strings and %2 pointers in data sections",
+                    m_dataScanner->getNumStrings(), m_dataScanner->getNumPointers());
+    }
 }
 
 
@@ -358,28 +370,36 @@ void Prog::readDefaultLibraryCatalogues()
     }
 
     ISymbolProvider *prov = plugin->getIfc<ISymbolProvider>();
-    prov->readLibraryCatalog(this, dataDir.absoluteFilePath("signatures/common.hs"));
+    prov->clearLibrarySignatures();
 
-    QString libCatalogName;
-    switch (getMachine()) {
-    case Machine::X86: libCatalogName = "signatures/x86.hs"; break;
-    case Machine::PPC: libCatalogName = "signatures/ppc.hs"; break;
-    case Machine::ST20: libCatalogName = "signatures/st20.hs"; break;
-    default: libCatalogName = ""; break;
+    for (const QString &catalog :
+         getDefaultLibraryCatalogues(getMachine(), m_binaryFile->getFormat())) {
+        prov->readLibraryCatalog(this, dataDir.absoluteFilePath(catalog));
     }
+}
+
 
-    if (!libCatalogName.isEmpty()) {
-        prov->readLibraryCatalog(this, dataDir.absoluteFilePath(libCatalogName));
+QStringList Prog::getDefaultLibraryCatalogues(Machine machine, LoadFmt format)
+{
+    QStringList catalogs = { "signatures/common.hs" };
+
+    switch (machine) {
+    case Machine::X86: catalogs.append("signatures/x86.hs"); break;
+    case Machine::PPC: catalogs.append("signatures/ppc.hs"); break;
+    case Machine::ST20: catalogs.append("signatures/st20.hs"); break;
+    default: break;
     }
 
-    if (isWin32()) {
-        prov->readLibraryCatalog(this, dataDir.absoluteFilePath("signatures/win32.hs"));
+    if (format == LoadFmt::PE) {
+        catalogs.append("signatures/win32.hs");
     }
 
     // TODO: change this to BinaryLayer query ("FILE_FORMAT","MACHO")
-    if (m_binaryFile->getFormat() == LoadFmt::MACHO) {
-        prov->readLibraryCatalog(this, dataDir.absoluteFilePath("signatures/objc.hs"));
+    if (format == LoadFmt::MACHO) {
+        catalogs.append("signatures/objc.hs");
     }
+
+    return catalogs;
 }
 
 
@@ -448,6 +468,9 @@ const char *Prog::getStringConstant(Address addr, bool knownString /* = false */
         // No need to guess... this is hopefully a known string
         return p;
     }
+    else if (m_dataScanner && m_dataScanner->findStringContaining(addr)) {
+        return p;
+    }
 
     // this address is not known to be a string -> use heuristic
     int numPrintables = 0;
@@ -808,6 +831,24 @@ SharedType Prog::guessGlobalType(const QString &globalName, Address globAddr) co
     auto symbol = m_binaryFile->getSymbols()->findSymbolByName(globalName);
     int sz      = symbol ? symbol->getSize() : 0;
 
+    if (sz == 0 && m_dataScanner) {
+        if (const ScannedString *str = m_dataScanner->findString(globAddr); str && str->wide) {
+            // array of UTF-16 characters, including the terminator
+            return ArrayType::get(IntegerType::get(16, Sign::Unsigned), str->length + 1);
+        }
+
+        // pointer to a string
+        const ScannedPointer *ptr = m_dataScanner->findPointer(globAddr);
+        const ScannedString *tgt  = ptr ? m_dataScanner->findString(ptr->target) : nullptr;
+
+        if (tgt && tgt->wide) {
+            return PointerType::get(IntegerType::get(16, Sign::Unsigned));
+        }
+        else if (tgt) {
+            return PointerType::get(CharType::get());
+        }
+    }
+
     if (sz == 0) {
         // Check if it might be a string
         const char *str = getStringConstant(globAddr);
@@ -20,6 +20,7 @@
 #include "boomerang/util/Address.h"
 
 #include <QString>
+#include <QStringList>
 
 #include <list>
 #include <map>
@@ -31,6 +32,8 @@ class ArrayType;
 class BinaryFile;
 class BinarySection;
 class BinarySymbol;
+class DataScanner;
+class FormatStringCache;
 class Function;
 class IFrontEnd;
 class LibProc;
@@ -157,6 +160,12 @@ public:
     Machine getMachine() const;
 
     void readDefaultLibraryCatalogues();
+
+    /// \returns the library signature catalogs (relative to the data directory) that
+    /// \ref readDefaultLibraryCatalogues reads for a binary file of format \p format
+    /// for machine \p machine.
+    static QStringList getDefaultLibraryCatalogues(Machine machine, LoadFmt format);
+
     bool addSymbolsFromSymbolFile(const QString &fname);
     std::shared_ptr<Signature> getLibSignature(const QString &name);
 
@@ -167,6 +176,14 @@ public:
     /// if knownString, it is already known to be a char*
     /// get a string constant at a give address if appropriate
     const char *getStringConstant(Address addr, bool knownString = false) const;
+
+    /// \returns the strings and pointers found in the data sections of the binary file,
+    /// or nullptr if no binary file is loaded.
+    const DataScanner *getDataScanner() const { return m_dataScanner.get(); }
+
+    /// \returns the parsed format strings of printf and scanf style calls
+    FormatStringCache &getFormatStringCache() { return *m_formatStrings; }
+
     bool getFloatConstant(Address addr, double &value, int bits = 64) const;
 
     /// Get a symbol from an address
@@ -257,6 +274,8 @@ private:
     ModuleList m_moduleList;            ///< The Modules that make up this program
 
     std::unique_ptr<LowLevelCFG> m_cfg;
+    std::unique_ptr<DataScanner> m_dataScanner; ///< Strings and pointers in data sections
+    std::unique_ptr<FormatStringCache> m_formatStrings;
 
     /// list of UserProcs for entry point(s)
     std::list<UserProc *> m_entryProcs;
@@ -0,0 +1,86 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "RenameStacks.h"
+
+#include "boomerang/ssl/exp/Exp.h"
+
+#include <cassert>
+
+
+void RenameStacks::clear()
+{
+    m_ids.clear();
+    m_locs.clear();
+    m_tops.clear();
+    m_entries.clear();
+}
+
+
+RenameStacks::LocID RenameStacks::findLoc(const SharedConstExp &loc) const
+{
+    // std::map::find needs a key of type SharedExp
+    const auto it = m_ids.find(std::const_pointer_cast<Exp>(loc));
+    return it != m_ids.end() ? it->second : NO_LOC;
+}
+
+
+SharedStmt RenameStacks::getTop(LocID id) const
+{
+    assert(id >= 0 && id < getNumLocs());
+    const int top = m_tops[id];
+    return top != -1 ? m_entries[top].def : nullptr;
+}
+
+
+SharedStmt RenameStacks::getTop(const SharedConstExp &loc) const
+{
+    const LocID id = findLoc(loc);
+    return id != NO_LOC ? getTop(id) : nullptr;
+}
+
+
+RenameStacks::LocID RenameStacks::push(const SharedExp &loc, const SharedStmt &def)
+{
+    LocID id = findLoc(loc);
+
+    if (id == NO_LOC) {
+        // Clone the location, since the original might be modified
+        // by subscripting the statement it belongs to.
+        id = getNumLocs();
+        m_locs.push_back(loc->clone());
+        m_ids.insert({ m_locs.back(), id });
+        m_tops.push_back(-1);
+    }
+
+    m_entries.push_back({ def, id, m_tops[id] });
+    m_tops[id] = static_cast<int>(m_entries.size()) - 1;
+    return id;
+}
+
+
+void RenameStacks::pushAll(const SharedStmt &def)
+{
+    for (LocID id = 0; id < getNumLocs(); id++) {
+        m_entries.push_back({ def, id, m_tops[id] });
+        m_tops[id] = static_cast<int>(m_entries.size()) - 1;
+    }
+}
+
+
+void RenameStacks::popTo(std::size_t height)
+{
+    assert(height <= m_entries.size());
+
+    while (m_entries.size() > height) {
+        const Entry &entry = m_entries.back();
+        m_tops[entry.loc]  = entry.shadowed;
+        m_entries.pop_back();
+    }
+}
@@ -0,0 +1,93 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/ssl/exp/ExpHelp.h"
+#include "boomerang/ssl/statements/Statement.h"
+
+#include <map>
+#include <vector>
+
+
+/**
+ * The definitions reaching the current point of SSA renaming,
+ * i.e. a stack of definitions for every location.
+ *
+ * Each location pushed at least once gets a dense id. All stacks share a single
+ * vector of entries that is also the undo log of the pushes: Each entry links to
+ * the entry it shadows, so popping back to a previous height restores all stacks at once.
+ * Apart from the first push of a location, stack operations do not compare expressions.
+ */
+class BOOMERANG_API RenameStacks
+{
+public:
+    typedef int LocID;
+    static constexpr LocID NO_LOC = -1;
+
+public:
+    RenameStacks()                          = default;
+    RenameStacks(const RenameStacks &other) = delete;
+    RenameStacks(RenameStacks &&other)      = default;
+
+    ~RenameStacks() = default;
+
+    RenameStacks &operator=(const RenameStacks &other) = delete;
+    RenameStacks &operator=(RenameStacks &&other) = default;
+
+public:
+    /// Remove all locations and definitions.
+    void clear();
+
+    /// \returns the id of \p loc, or NO_LOC if nothing was ever pushed for \p loc
+    LocID findLoc(const SharedConstExp &loc) const;
+
+    /// \returns the number of locations that have (or had) a definition
+    int getNumLocs() const { return static_cast<int>(m_locs.size()); }
+
+    /// \returns the location with id \p id
+    const SharedExp &getLoc(LocID id) const { return m_locs[id]; }
+
+    /// \returns the last definition of the location with id \p id,
+    /// or nullptr if its stack is empty.
+    SharedStmt getTop(LocID id) const;
+
+    /// \returns the last definition of \p loc, or nullptr if there is none.
+    SharedStmt getTop(const SharedConstExp &loc) const;
+
+    /// Push \p def onto the stack of \p loc.
+    /// \returns the id of \p loc
+    LocID push(const SharedExp &loc, const SharedStmt &def);
+
+    /// Push \p def onto the stacks of all locations known so far.
+    void pushAll(const SharedStmt &def);
+
+    /// \returns the total number of definitions on all stacks.
+    std::size_t getHeight() const { return m_entries.size(); }
+
+    /// Pop the last definitions until there are only \p height definitions left.
+    void popTo(std::size_t height);
+
+    /// \returns true if all stacks are empty.
+    bool empty() const { return m_entries.empty(); }
+
+private:
+    struct Entry
+    {
+        SharedStmt def;
+        LocID loc;
+        int shadowed; ///< Index of the previous top entry of \ref loc, or -1
+    };
+
+    std::map<SharedExp, LocID, lessExpStar> m_ids; ///< Location -> id
+    std::vector<SharedExp> m_locs;                 ///< id -> location
+    std::vector<int> m_tops;                       ///< id -> index of top entry, or -1
+    std::vector<Entry> m_entries;                  ///< All stacks, in order of pushes
+};
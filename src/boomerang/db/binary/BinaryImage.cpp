@@ -143,6 +143,33 @@ bool BinaryImage::readNativeAddr8(Address addr, Address &value) const
 }
 
 
+std::vector<Address> BinaryImage::readNativeAddrs4(Address addr, int maxCount) const
+{
+    std::vector<Address> result;
+    const BinarySection *si = getSectionByAddr(addr);
+
+    if (si == nullptr || si->getHostAddr() == HostAddress::INVALID || maxCount <= 0) {
+        return result;
+    }
+
+    const Address sectionEnd = si->getSourceAddr() + si->getSize();
+    const HostAddress start  = si->getHostAddr() - si->getSourceAddr() + addr;
+    const Byte *host         = reinterpret_cast<const Byte *>(start.value());
+
+    result.reserve(maxCount);
+    for (Address entry = addr; entry + 4 <= sectionEnd && (int)result.size() < maxCount;
+         entry += 4, host += 4) {
+        if (si->isAddressBss(entry)) {
+            break;
+        }
+
+        result.push_back(Address(Util::readDWord(host, si->getEndian())));
+    }
+
+    return result;
+}
+
+
 bool BinaryImage::readNativeFloat4(Address addr, float &value) const
 {
     const BinarySection *sect = getSectionByAddr(addr);
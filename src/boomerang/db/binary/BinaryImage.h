@@ -112,6 +112,12 @@ public:
     bool readNativeAddr4(Address addr, Address &value) const;
     bool readNativeAddr8(Address addr, Address &value) const;
 
+    /// Read up to \p maxCount consecutive 32 bit addresses starting at \p addr,
+    /// looking up the section only once (e.g. for jump tables).
+    /// Reading stops at the end of the section or at the first uninitialized word.
+    /// \returns the addresses read, which is empty if \p addr is not mapped.
+    std::vector<Address> readNativeAddrs4(Address addr, int maxCount) const;
+
     bool readNativeFloat4(Address addr, float &value) const;
     bool readNativeFloat8(Address addr, double &value) const;
 
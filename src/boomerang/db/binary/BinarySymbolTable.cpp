@@ -76,6 +76,13 @@ const BinarySymbol *BinarySymbolTable::findSymbolByAddress(Address addr) const
 }
 
 
+const BinarySymbol *BinarySymbolTable::findNextSymbol(Address addr) const
+{
+    auto it = m_addrIndex.upper_bound(addr);
+    return (it != m_addrIndex.end()) ? it->second.get() : nullptr;
+}
+
+
 BinarySymbol *BinarySymbolTable::findSymbolByName(const QString &name)
 {
     auto ff = m_nameIndex.find(name);
@@ -70,6 +70,9 @@ public:
     BinarySymbol *findSymbolByAddress(Address addr);
     const BinarySymbol *findSymbolByAddress(Address addr) const;
 
+    /// \returns the symbol with the lowest address greater than \p addr, or nullptr if none.
+    const BinarySymbol *findNextSymbol(Address addr) const;
+
     BinarySymbol *findSymbolByName(const QString &name);
     const BinarySymbol *findSymbolByName(const QString &name) const;
 
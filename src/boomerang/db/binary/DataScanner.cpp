@@ -0,0 +1,406 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "DataScanner.h"
+
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/util/ByteUtil.h"
+#include "boomerang/util/Util.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define BOOMERANG_DATASCANNER_SSE2 1
+#    include <emmintrin.h>
+#endif
+
+
+namespace
+{
+constexpr int BLOCK_SIZE = 16;
+
+/// Mask of the even bits of a block mask (start bytes of UTF-16 characters)
+constexpr uint32 EVEN_BITS = 0x5555;
+
+
+/// Bit masks of the bytes in a block of 16 bytes.
+struct BlockMasks
+{
+    uint32 printable; ///< Printable ASCII characters and \\t, \\n, \\r
+    uint32 nul;       ///< NUL bytes
+};
+
+
+class CharTable
+{
+public:
+    CharTable()
+    {
+        for (int c = 0; c < 256; c++) {
+            m_printable[c] = (c >= 0x20 && c < 0x7F) || c == '\t' || c == '\n' || c == '\r';
+        }
+    }
+
+    bool isPrintable(Byte c) const { return m_printable[c]; }
+
+private:
+    std::array<bool, 256> m_printable;
+};
+
+
+const CharTable g_charTable;
+
+
+BlockMasks classifyBlockScalar(const Byte *p)
+{
+    BlockMasks masks{ 0, 0 };
+
+    for (int i = 0; i < BLOCK_SIZE; i++) {
+        if (g_charTable.isPrintable(p[i])) {
+            masks.printable |= 1U << i;
+        }
+        else if (p[i] == 0) {
+            masks.nul |= 1U << i;
+        }
+    }
+
+    return masks;
+}
+
+
+/// Classify the 16 bytes starting at \p p.
+BlockMasks classifyBlock(const Byte *p)
+{
+#ifdef BOOMERANG_DATASCANNER_SSE2
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+
+    // Bytes >= 0x80 are negative as signed chars, so a signed comparison suffices.
+    const __m128i inRange = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(0x1F)),
+                                          _mm_cmplt_epi8(v, _mm_set1_epi8(0x7F)));
+
+    const __m128i control = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\t')),
+                                                      _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))),
+                                         _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+
+    const __m128i nul = _mm_cmpeq_epi8(v, _mm_setzero_si128());
+
+    BlockMasks masks;
+    masks.printable = static_cast<uint32>(_mm_movemask_epi8(_mm_or_si128(inRange, control)));
+    masks.nul       = static_cast<uint32>(_mm_movemask_epi8(nul));
+    return masks;
+#else
+    return classifyBlockScalar(p);
+#endif
+}
+
+
+/**
+ * Calls \p fn for each block of the section data. The last block is padded
+ * with bytes that are neither printable nor NUL; bits past the end of the data
+ * are never set.
+ */
+template<typename Fn>
+void forEachBlock(const Byte *data, uint64 size, Fn &&fn)
+{
+    uint64 offset = 0;
+
+    for (; offset + BLOCK_SIZE <= size; offset += BLOCK_SIZE) {
+        fn(offset, classifyBlock(data + offset));
+    }
+
+    if (offset < size) {
+        Byte tail[BLOCK_SIZE];
+        std::memset(tail, 0x80, BLOCK_SIZE);
+        std::memcpy(tail, data + offset, size - offset);
+        fn(offset, classifyBlockScalar(tail));
+    }
+}
+
+
+/// Find strings made of the characters in \p charMask, terminated by a bit in \p termMask,
+/// in blocks of bytes. Only the bits in \p validBits are looked at;
+/// \p step is the number of bytes per character.
+class StringRunTracker
+{
+public:
+    StringRunTracker(int step, uint32 validBits)
+        : m_step(step)
+        , m_validBits(validBits)
+    {
+    }
+
+    template<typename Fn>
+    void addBlock(uint64 offset, uint32 charMask, uint32 termMask, Fn &&onString)
+    {
+        charMask &= m_validBits;
+        termMask &= m_validBits;
+
+        if (charMask == m_validBits) {
+            // The complete block continues (or starts) a string
+            if (!m_inRun) {
+                m_inRun    = true;
+                m_runStart = offset;
+            }
+
+            return;
+        }
+        else if (charMask == 0 && termMask == 0) {
+            m_inRun = false;
+            return;
+        }
+
+        for (int i = 0; i < BLOCK_SIZE; i += m_step) {
+            const uint32 bit = 1U << i;
+
+            if (charMask & bit) {
+                if (!m_inRun) {
+                    m_inRun    = true;
+                    m_runStart = offset + i;
+                }
+            }
+            else if ((termMask & bit) && m_inRun) {
+                const uint64 length = (offset + i - m_runStart) / m_step;
+                if (length >= DataScanner::MIN_STRING_LENGTH) {
+                    onString(m_runStart, static_cast<uint32>(length));
+                }
+
+                m_inRun = false;
+            }
+            else {
+                m_inRun = false;
+            }
+        }
+    }
+
+private:
+    int m_step;
+    uint32 m_validBits;
+    bool m_inRun      = false;
+    uint64 m_runStart = 0;
+};
+}
+
+
+DataScanner::DataScanner(const BinaryImage *image, int pointerSize)
+    : m_image(image)
+    , m_pointerSize(pointerSize)
+{
+    assert(m_image != nullptr);
+    assert(m_pointerSize == 4 || m_pointerSize == 8);
+}
+
+
+void DataScanner::scanImage()
+{
+    m_strings.clear();
+    m_pointers.clear();
+    m_lowTarget  = Address::INVALID;
+    m_highTarget = Address::INVALID;
+
+    for (const BinarySection *section : *m_image) {
+        if (!section->isCode() && !section->isData()) {
+            continue;
+        }
+
+        const Address lowAddr  = section->getSourceAddr();
+        const Address highAddr = section->getSourceAddr() + section->getSize();
+
+        if (m_lowTarget == Address::INVALID || lowAddr < m_lowTarget) {
+            m_lowTarget = lowAddr;
+        }
+
+        if (m_highTarget == Address::INVALID || highAddr > m_highTarget) {
+            m_highTarget = highAddr;
+        }
+    }
+
+    for (const BinarySection *section : *m_image) {
+        scanSection(section);
+    }
+}
+
+
+void DataScanner::scanSection(const BinarySection *section)
+{
+    // Only initialized data contains anything worth scanning
+    if (!section->isData() || section->isAddressBss(section->getSourceAddr()) ||
+        section->getHostAddr() == HostAddress::INVALID || section->getHostAddr().isZero() ||
+        section->getSize() <= 0) {
+        return;
+    }
+
+    const Byte *data  = reinterpret_cast<const Byte *>(section->getHostAddr().value());
+    const uint64 size = static_cast<uint64>(section->getSize());
+
+    scanStrings(section, data, size);
+    scanWideStrings(section, data, size);
+
+    if (m_lowTarget != Address::INVALID) {
+        scanPointers(section, data, size);
+    }
+
+    sortResults();
+}
+
+
+const ScannedString *DataScanner::findString(Address addr) const
+{
+    auto it = std::lower_bound(
+        m_strings.begin(), m_strings.end(), addr,
+        [](const ScannedString &str, Address a) { return str.addr < a; });
+
+    return (it != m_strings.end() && it->addr == addr) ? &*it : nullptr;
+}
+
+
+const ScannedString *DataScanner::findStringContaining(Address addr) const
+{
+    // Find the last string starting at or before addr
+    auto it = std::upper_bound(
+        m_strings.begin(), m_strings.end(), addr,
+        [](Address a, const ScannedString &str) { return a < str.addr; });
+
+    if (it == m_strings.begin()) {
+        return nullptr;
+    }
+
+    --it;
+    const Address terminatorAddr = it->getEndAddr() - (it->wide ? 2 : 1);
+    return addr < terminatorAddr ? &*it : nullptr;
+}
+
+
+const ScannedPointer *DataScanner::findPointer(Address addr) const
+{
+    auto it = std::lower_bound(
+        m_pointers.begin(), m_pointers.end(), addr,
+        [](const ScannedPointer &ptr, Address a) { return ptr.addr < a; });
+
+    return (it != m_pointers.end() && it->addr == addr) ? &*it : nullptr;
+}
+
+
+void DataScanner::scanStrings(const BinarySection *section, const Byte *data, uint64 size)
+{
+    const Address base = section->getSourceAddr();
+    StringRunTracker tracker(1, 0xFFFF);
+
+    forEachBlock(data, size, [&](uint64 offset, const BlockMasks &masks) {
+        tracker.addBlock(offset, masks.printable, masks.nul, [&](uint64 start, uint32 length) {
+            m_strings.push_back({ base + start, length, false });
+        });
+    });
+}
+
+
+void DataScanner::scanWideStrings(const BinarySection *section, const Byte *data, uint64 size)
+{
+    const Address base = section->getSourceAddr();
+    if (base.value() % 2 != 0) {
+        // Characters are assumed to be aligned relative to the start of the section
+        return;
+    }
+
+    const bool bigEndian = section->getEndian() == Endian::Big;
+    StringRunTracker tracker(2, EVEN_BITS);
+
+    forEachBlock(data, size, [&](uint64 offset, const BlockMasks &masks) {
+        // A character is a printable byte next to a NUL byte; the terminator is two NUL bytes.
+        const uint32 charMask = bigEndian ? (masks.nul & (masks.printable >> 1))
+                                          : (masks.printable & (masks.nul >> 1));
+        const uint32 termMask = masks.nul & (masks.nul >> 1);
+
+        tracker.addBlock(offset, charMask, termMask, [&](uint64 start, uint32 length) {
+            m_strings.push_back({ base + start, length, true });
+        });
+    });
+}
+
+
+void DataScanner::scanPointers(const BinarySection *section, const Byte *data, uint64 size)
+{
+    const Address base    = section->getSourceAddr();
+    const Endian endian   = section->getEndian();
+    const uint64 ptrSize  = static_cast<uint64>(m_pointerSize);
+    const uint64 misalign = base.value() % ptrSize;
+    uint64 offset         = misalign != 0 ? ptrSize - misalign : 0;
+
+    auto addCandidate = [&](uint64 off, Address target) {
+        if (isValidTarget(target)) {
+            m_pointers.push_back({ base + off, target });
+        }
+    };
+
+#ifdef BOOMERANG_DATASCANNER_SSE2
+    if (m_pointerSize == 4 && endian == Endian::Little && m_lowTarget.value() <= 0xFFFFFFFFU) {
+        // Compare 4 words at a time against the target range. SSE2 only has signed comparisons,
+        // so flip the sign bit of both sides first.
+        const uint32 lowTarget  = static_cast<uint32>(m_lowTarget.value());
+        const uint32 highTarget = static_cast<uint32>(
+            std::min<Address::value_type>(m_highTarget.value() - 1, 0xFFFFFFFFU));
+
+        const __m128i bias = _mm_set1_epi32(static_cast<int>(0x80000000U));
+        const __m128i low  = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(lowTarget)), bias);
+        const __m128i high = _mm_xor_si128(_mm_set1_epi32(static_cast<int>(highTarget)), bias);
+
+        for (; offset + BLOCK_SIZE <= size; offset += BLOCK_SIZE) {
+            const __m128i v = _mm_xor_si128(
+                _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + offset)), bias);
+            const __m128i outOfRange = _mm_or_si128(_mm_cmplt_epi32(v, low),
+                                                    _mm_cmpgt_epi32(v, high));
+            const int outMask = _mm_movemask_ps(_mm_castsi128_ps(outOfRange));
+
+            if (outMask == 0xF) {
+                continue;
+            }
+
+            for (int i = 0; i < 4; i++) {
+                if ((outMask & (1 << i)) == 0) {
+                    const uint64 off = offset + 4 * i;
+                    addCandidate(off, Address(Util::readDWord(data + off, Endian::Little)));
+                }
+            }
+        }
+    }
+#endif
+
+    for (; offset + ptrSize <= size; offset += ptrSize) {
+        const QWord value = (m_pointerSize == 4) ? Util::readDWord(data + offset, endian)
+                                                 : Util::readQWord(data + offset, endian);
+
+        if (Util::inRange(Address(value), m_lowTarget, m_highTarget)) {
+            addCandidate(offset, Address(value));
+        }
+    }
+}
+
+
+bool DataScanner::isValidTarget(Address target) const
+{
+    if (!Util::inRange(target, m_lowTarget, m_highTarget)) {
+        return false;
+    }
+
+    const BinarySection *section = m_image->getSectionByAddr(target);
+    return section && (section->isCode() || section->isData());
+}
+
+
+void DataScanner::sortResults()
+{
+    std::sort(m_strings.begin(), m_strings.end(),
+              [](const ScannedString &a, const ScannedString &b) { return a.addr < b.addr; });
+
+    std::sort(m_pointers.begin(), m_pointers.end(),
+              [](const ScannedPointer &a, const ScannedPointer &b) { return a.addr < b.addr; });
+}
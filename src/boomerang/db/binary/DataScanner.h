@@ -0,0 +1,104 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/util/Address.h"
+#include "boomerang/util/Types.h"
+
+#include <vector>
+
+
+class BinaryImage;
+class BinarySection;
+
+
+/// A NUL terminated string found by DataScanner
+struct ScannedString
+{
+    Address addr;  ///< Address of the first character
+    uint32 length; ///< Number of characters, excluding the terminator
+    bool wide;     ///< true for UTF-16 strings, false for ASCII strings
+
+    /// \returns the address of the first byte after the terminator
+    Address getEndAddr() const { return addr + (length + 1) * (wide ? 2 : 1); }
+};
+
+
+/// An aligned word in a data section that points into a code or data section
+struct ScannedPointer
+{
+    Address addr;   ///< Address of the pointer itself
+    Address target; ///< Value of the pointer
+};
+
+
+/**
+ * Finds strings and pointers in the data sections of a binary image.
+ *
+ * Each section is scanned in a single pass. Bytes are classified in blocks of 16
+ * (using SSE2 where available), so that blocks without any string characters
+ * or pointer candidates are skipped without looking at individual bytes.
+ * The results are kept sorted by address, so they can be queried in O(log n).
+ *
+ * Only strings of at least \ref MIN_STRING_LENGTH characters are recorded;
+ * shorter strings still need to be recognized by heuristics (\sa Prog::getStringConstant).
+ */
+class BOOMERANG_API DataScanner
+{
+public:
+    /// Minimum number of characters of strings to record
+    static constexpr uint32 MIN_STRING_LENGTH = 4;
+
+public:
+    /// \param pointerSize size of pointers in the image in bytes (4 or 8)
+    DataScanner(const BinaryImage *image, int pointerSize);
+
+public:
+    /// Scan all initialized data sections of the image. Previous results are discarded.
+    void scanImage();
+
+    /// Scan a single section and add the results.
+    void scanSection(const BinarySection *section);
+
+    /// \returns the string starting at \p addr, or nullptr if there is none.
+    const ScannedString *findString(Address addr) const;
+
+    /// \returns the string containing \p addr, or nullptr if \p addr is not inside a string.
+    /// The terminator is not considered part of the string.
+    const ScannedString *findStringContaining(Address addr) const;
+
+    /// \returns the pointer stored at \p addr, or nullptr if there is none.
+    const ScannedPointer *findPointer(Address addr) const;
+
+    int getNumStrings() const { return static_cast<int>(m_strings.size()); }
+    int getNumPointers() const { return static_cast<int>(m_pointers.size()); }
+
+private:
+    void scanStrings(const BinarySection *section, const Byte *data, uint64 size);
+    void scanWideStrings(const BinarySection *section, const Byte *data, uint64 size);
+    void scanPointers(const BinarySection *section, const Byte *data, uint64 size);
+
+    /// \returns true if \p target points into a code or data section.
+    bool isValidTarget(Address target) const;
+
+    /// Sort results after adding new ones.
+    void sortResults();
+
+private:
+    const BinaryImage *m_image;
+    int m_pointerSize;
+
+    Address m_lowTarget  = Address::INVALID; ///< Lowest address of all code and data sections
+    Address m_highTarget = Address::INVALID; ///< End of the highest code or data section
+
+    std::vector<ScannedString> m_strings;   ///< sorted by address
+    std::vector<ScannedPointer> m_pointers; ///< sorted by address
+};
@@ -0,0 +1,48 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "CallEffectSummary.h"
+
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/statements/ReturnStatement.h"
+
+
+CallEffectSummary::CallEffectSummary(const UserProc *proc)
+{
+    assert(proc != nullptr);
+
+    for (const auto &[left, right] : proc->getProvenTrue()) {
+        m_provenTrue[left->clone()] = right->clone();
+
+        if (*left == *right) {
+            m_preserveds.insert(left->clone());
+        }
+    }
+
+    if (proc->getRetStmt()) {
+        for (const SharedConstStmt &mod : proc->getRetStmt()->getModifieds()) {
+            const SharedExp lhs = mod->as<const Assignment>()->getLeft();
+            m_defines.insert(lhs->clone());
+
+            // For foo@[x:y], both foo@[x:y] and foo are defined (see Assignment::definesLoc)
+            if (lhs->getOper() == opAt) {
+                m_defines.insert(lhs->getSubExp1()->clone());
+            }
+        }
+    }
+}
+
+
+SharedExp CallEffectSummary::getProven(const SharedConstExp &left) const
+{
+    auto it = m_provenTrue.find(std::const_pointer_cast<Exp>(left));
+    return it != m_provenTrue.end() ? it->second : nullptr;
+}
+
@@ -0,0 +1,66 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/util/LocationSet.h"
+
+#include <map>
+
+
+class UserProc;
+
+
+/**
+ * Immutable summary of the effects of calling a fully decompiled UserProc.
+ * It is computed once when the callee reaches ProcStatus::FinalDone and is then
+ * shared by all call sites, so that callers do not have to re-query the callee's
+ * return statement or re-run the prover for every bypass.
+ *
+ * The summary is discarded by the callee whenever the information it was built from
+ * becomes stale, e.g. when the callee's recursion group is re-analysed.
+ */
+class BOOMERANG_API CallEffectSummary
+{
+    typedef std::map<SharedExp, SharedExp, lessExpStar> ExpExpMap;
+
+public:
+    /// Build the summary from the current state of \p proc.
+    explicit CallEffectSummary(const UserProc *proc);
+    CallEffectSummary(const CallEffectSummary &) = delete;
+    CallEffectSummary(CallEffectSummary &&)      = default;
+
+    ~CallEffectSummary() = default;
+
+    CallEffectSummary &operator=(const CallEffectSummary &) = delete;
+    CallEffectSummary &operator=(CallEffectSummary &&) = default;
+
+public:
+    /// \returns the (unsubscripted) RHS proven for \p left, e.g. r28 + 4 for r28,
+    /// or nullptr if nothing was proven.
+    /// \note The result is shared; clone it before modifying it.
+    SharedExp getProven(const SharedConstExp &left) const;
+
+    /// \returns true if the callee was proven to preserve \p loc (i.e. loc = loc)
+    bool isPreserved(const SharedConstExp &loc) const { return m_preserveds.contains(loc); }
+
+    /// \returns true if the callee may modify \p loc
+    bool definesLoc(const SharedConstExp &loc) const { return m_defines.contains(loc); }
+
+    const LocationSet &getPreserveds() const { return m_preserveds; }
+    const LocationSet &getDefines() const { return m_defines; }
+    const ExpExpMap &getProvenTrue() const { return m_provenTrue; }
+
+private:
+    ExpExpMap m_provenTrue;   ///< Copy of the callee's proven equations
+    LocationSet m_preserveds; ///< Locations proven to be of the form loc = loc
+    LocationSet m_defines;    ///< Locations modified by the callee (modifieds of the return)
+};
@@ -0,0 +1,51 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "LiftCheckpoint.h"
+
+#include "boomerang/ssl/RTL.h"
+
+
+LiftCheckpoint::LiftCheckpoint(LiftCheckpoint &&) = default;
+
+
+LiftCheckpoint::~LiftCheckpoint()
+{
+}
+
+
+LiftCheckpoint &LiftCheckpoint::operator=(LiftCheckpoint &&) = default;
+
+
+std::unique_ptr<RTL> LiftCheckpoint::findRTL(Address addr)
+{
+    auto it = m_rtls.find(addr);
+
+    if (it == m_rtls.end()) {
+        m_numMisses++;
+        return nullptr;
+    }
+
+    m_numHits++;
+    return std::make_unique<RTL>(*it->second);
+}
+
+
+void LiftCheckpoint::addRTL(Address addr, const RTL &rtl)
+{
+    m_rtls[addr] = std::make_unique<RTL>(rtl);
+}
+
+
+void LiftCheckpoint::clear()
+{
+    m_rtls.clear();
+    m_numHits   = 0;
+    m_numMisses = 0;
+}
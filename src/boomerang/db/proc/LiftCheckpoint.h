@@ -0,0 +1,71 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/util/Address.h"
+
+#include <map>
+#include <memory>
+
+
+class RTL;
+
+
+/**
+ * Remembers the RTLs the decoder lifted the instructions of a single UserProc to,
+ * before they are processed any further (simplification, call and jump processing,
+ * data flow analysis).
+ *
+ * When the decompilation of a UserProc has to be restarted (e.g. because new switch arms
+ * were found), all instructions that were lifted before are taken from the checkpoint
+ * instead of being lifted again, so only newly discovered instructions reach the decoder.
+ * Since lifting does not depend on the context of an instruction, the checkpoint stays valid
+ * when basic blocks are split or new edges are added to the low level CFG.
+ *
+ * \sa DefaultFrontEnd::liftProc, UserProc::getLiftCheckpoint
+ */
+class BOOMERANG_API LiftCheckpoint
+{
+public:
+    LiftCheckpoint()                       = default;
+    LiftCheckpoint(const LiftCheckpoint &) = delete;
+    LiftCheckpoint(LiftCheckpoint &&);
+
+    ~LiftCheckpoint();
+
+    LiftCheckpoint &operator=(const LiftCheckpoint &) = delete;
+    LiftCheckpoint &operator=(LiftCheckpoint &&);
+
+public:
+    /// \returns a deep copy of the RTL the instruction at \p addr was lifted to,
+    /// or nullptr if the instruction is not in the checkpoint.
+    std::unique_ptr<RTL> findRTL(Address addr);
+
+    /// Remember that the instruction at \p addr was lifted to \p rtl.
+    /// A deep copy of \p rtl is stored.
+    void addRTL(Address addr, const RTL &rtl);
+
+    /// Forget everything.
+    void clear();
+
+    bool isEmpty() const { return m_rtls.empty(); }
+    int getNumRTLs() const { return static_cast<int>(m_rtls.size()); }
+
+    int getNumHits() const { return m_numHits; }
+    int getNumMisses() const { return m_numMisses; }
+
+private:
+    std::map<Address, std::unique_ptr<RTL>> m_rtls;
+
+    int m_numHits   = 0;
+    int m_numMisses = 0;
+};
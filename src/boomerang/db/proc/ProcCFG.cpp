@@ -45,6 +45,9 @@ void ProcCFG::clear()
 
     qDeleteAll(begin(), end()); // deletes all fragments
     m_fragmentSet.clear();
+
+    m_entryFrag = nullptr;
+    m_exitFrag  = nullptr;
 }
 
 
@@ -66,6 +69,10 @@ IRFragment *ProcCFG::createFragment(FragType fragType, std::unique_ptr<RTLList>
     IRFragment *frag = new IRFragment(getNextFragID(), bb, std::move(rtls));
     m_fragmentSet.insert(frag);
 
+    // the statements of the new fragment are now part of the procedure
+    frag->setModificationStamp(&m_modificationStamp);
+    m_modificationStamp++;
+
     frag->setType(fragType);
     frag->updateAddresses();
     return frag;
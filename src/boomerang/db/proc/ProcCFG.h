@@ -54,12 +54,12 @@ public:
     /// Creates an empty CFG for the function \p proc
     ProcCFG(UserProc *proc);
     ProcCFG(const ProcCFG &other) = delete;
-    ProcCFG(ProcCFG &&other)      = default;
+    ProcCFG(ProcCFG &&other)      = delete; // RTLs refer to m_modificationStamp
 
     ~ProcCFG();
 
     ProcCFG &operator=(const ProcCFG &other) = delete;
-    ProcCFG &operator=(ProcCFG &&other) = default;
+    ProcCFG &operator=(ProcCFG &&other) = delete;
 
 public:
     /// \note When removing a fragment, the iterator(s) pointing to the removed fragment
@@ -81,6 +81,11 @@ public:
     /// Remove all IRFragments in the CFG
     void clear();
 
+    /// \returns a number that changes whenever a statement is inserted into or removed from
+    /// any fragment of this CFG, or a fragment is added or removed.
+    /// Used to detect outdated caches of statements (\sa UserProc::getStatementsOfKind).
+    uint64 getModificationStamp() const { return m_modificationStamp; }
+
     /// \returns the number of fragments in this CFG.
     int getNumFragments() const { return m_fragmentSet.size(); }
 
@@ -172,5 +177,7 @@ private:
     /// (e.g. with ad-hoc global assignment)
     bool m_implicitsDone = false;
 
+    uint64 m_modificationStamp = 0; ///< \sa getModificationStamp
+
     static IRFragment::FragID m_nextID;
 };
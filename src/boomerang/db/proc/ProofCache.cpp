@@ -0,0 +1,65 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProofCache.h"
+
+#include "boomerang/ssl/exp/Exp.h"
+#include "boomerang/ssl/statements/PhiAssign.h"
+
+
+bool ProofCache::findResult(const SharedExp &key, bool &result)
+{
+    auto it = m_results.find(key);
+
+    if (it == m_results.end()) {
+        m_numMisses++;
+        return false;
+    }
+
+    m_numHits++;
+    result = it->second;
+    return true;
+}
+
+
+void ProofCache::addResult(const SharedExp &key, bool result)
+{
+    m_results[key] = result;
+}
+
+
+SharedExp ProofCache::findPhiProof(const std::shared_ptr<PhiAssign> &phi) const
+{
+    auto it = m_phiProofs.find(phi);
+    return it != m_phiProofs.end() ? it->second : nullptr;
+}
+
+
+void ProofCache::addPhiProofs(const PhiProofMap &proofs)
+{
+    for (const auto &[phi, proof] : proofs) {
+        m_phiProofs[phi] = proof;
+    }
+}
+
+
+void ProofCache::clear()
+{
+    m_results.clear();
+    m_phiProofs.clear();
+}
+
+
+void ProofCache::validate(uint64 stamp)
+{
+    if (stamp != m_stamp) {
+        clear();
+        m_stamp = stamp;
+    }
+}
@@ -0,0 +1,84 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/ssl/exp/ExpHelp.h"
+#include "boomerang/util/Types.h"
+
+#include <map>
+
+
+class PhiAssign;
+
+
+/**
+ * Memoizes the results of the preservation prover of a single UserProc.
+ * Results of whole queries are keyed on the query together with the premises
+ * that were active when the query was made, so conditional (recursion group) proofs
+ * never leak into unconditional ones. Additionally, phis that have been proven equal
+ * to an expression as part of a successful unconditional proof are remembered, so that
+ * later queries going through the same phi web do not have to re-prove them.
+ *
+ * Nothing in the keys reflects the statements of the UserProc, so the cache remembers
+ * the modification stamp of the CFG it was filled for (\sa ProcCFG::getModificationStamp)
+ * and is cleared as soon as statements have been inserted or removed since
+ * (\sa validate). It is also cleared at the start of each decompilation stage
+ * (\sa UserProc::clearProofCache). Proofs that ran out of steps are not cached,
+ * since they may succeed with a fresh budget.
+ */
+class BOOMERANG_API ProofCache
+{
+public:
+    typedef std::map<std::shared_ptr<PhiAssign>, SharedExp> PhiProofMap;
+
+public:
+    ProofCache()                   = default;
+    ProofCache(const ProofCache &) = delete;
+    ProofCache(ProofCache &&)      = default;
+
+    ~ProofCache() = default;
+
+    ProofCache &operator=(const ProofCache &) = delete;
+    ProofCache &operator=(ProofCache &&) = default;
+
+public:
+    /// Look up the result of a previous query with key \p key.
+    /// \returns true if a result was found, in which case \p result is set to it.
+    bool findResult(const SharedExp &key, bool &result);
+
+    /// Remember that the query with key \p key evaluated to \p result.
+    void addResult(const SharedExp &key, bool result);
+
+    /// \returns the expression \p phi was proven equal to, or nullptr if not known.
+    SharedExp findPhiProof(const std::shared_ptr<PhiAssign> &phi) const;
+
+    /// Remember all phi proofs in \p proofs
+    void addPhiProofs(const PhiProofMap &proofs);
+
+    /// Forget everything.
+    void clear();
+
+    /// Forget everything if \p stamp, the current modification stamp of the CFG,
+    /// differs from the stamp the cached proofs were made for.
+    void validate(uint64 stamp);
+
+    int getNumHits() const { return m_numHits; }
+    int getNumMisses() const { return m_numMisses; }
+
+private:
+    std::map<SharedExp, bool, lessExpStar> m_results;
+    PhiProofMap m_phiProofs;
+    uint64 m_stamp = 0; ///< Modification stamp of the CFG the proofs are valid for
+
+    int m_numHits   = 0;
+    int m_numMisses = 0;
+};
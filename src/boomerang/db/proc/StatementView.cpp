@@ -0,0 +1,118 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "StatementView.h"
+
+
+StatementView::iterator::iterator(ProcCFG::const_iterator fragIt,
+                                  ProcCFG::const_iterator fragEnd, StmtKindMask kinds)
+    : m_fragIt(fragIt)
+    , m_fragEnd(fragEnd)
+    , m_kinds(kinds)
+{
+    enterFragment();
+    skipToMatch();
+}
+
+
+bool StatementView::iterator::operator==(const iterator &other) const
+{
+    if (m_fragIt != other.m_fragIt) {
+        return false;
+    }
+
+    // RTL and statement iterators are only valid before the end
+    return m_fragIt == m_fragEnd || (m_rtlIt == other.m_rtlIt && m_stmtIt == other.m_stmtIt);
+}
+
+
+StatementView::iterator &StatementView::iterator::operator++()
+{
+    step();
+    skipToMatch();
+    return *this;
+}
+
+
+StatementView::iterator StatementView::iterator::operator++(int)
+{
+    iterator tmp = *this;
+    ++(*this);
+    return tmp;
+}
+
+
+void StatementView::iterator::enterFragment()
+{
+    for (; m_fragIt != m_fragEnd; ++m_fragIt) {
+        RTLList *rtls = (*m_fragIt)->getRTLs();
+        if (!rtls) {
+            continue;
+        }
+
+        for (m_rtlIt = rtls->begin(); m_rtlIt != rtls->end(); ++m_rtlIt) {
+            if (!(*m_rtlIt)->empty()) {
+                m_stmtIt = (*m_rtlIt)->begin();
+                return;
+            }
+        }
+    }
+}
+
+
+void StatementView::iterator::step()
+{
+    if (++m_stmtIt != (*m_rtlIt)->end()) {
+        return;
+    }
+
+    RTLList *rtls = (*m_fragIt)->getRTLs();
+
+    for (++m_rtlIt; m_rtlIt != rtls->end(); ++m_rtlIt) {
+        if (!(*m_rtlIt)->empty()) {
+            m_stmtIt = (*m_rtlIt)->begin();
+            return;
+        }
+    }
+
+    ++m_fragIt;
+    enterFragment();
+}
+
+
+void StatementView::iterator::skipToMatch()
+{
+    if (m_kinds == STMT_MASK_ALL) {
+        return;
+    }
+
+    while (m_fragIt != m_fragEnd && (m_kinds & stmtKindMask((*m_stmtIt)->getKind())) == 0) {
+        step();
+    }
+}
+
+
+StatementView::StatementView(const ProcCFG *cfg, StmtKindMask kinds)
+    : m_cfg(cfg)
+    , m_kinds(kinds)
+{
+    assert(m_cfg != nullptr);
+}
+
+
+StatementView::iterator StatementView::begin() const
+{
+    return iterator(m_cfg->begin(), m_cfg->end(), m_kinds);
+}
+
+
+StatementView::iterator StatementView::end() const
+{
+    return iterator(m_cfg->end(), m_cfg->end(), m_kinds);
+}
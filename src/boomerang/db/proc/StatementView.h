@@ -0,0 +1,107 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/util/Types.h"
+
+#include <iterator>
+
+
+/// A set of statement kinds, with one bit for each StmtType.
+typedef uint32 StmtKindMask;
+
+/// \returns the set containing only \p kind
+constexpr StmtKindMask stmtKindMask(StmtType kind)
+{
+    return StmtKindMask(1) << static_cast<uint32>(kind);
+}
+
+/// Number of different statement kinds
+constexpr int NUM_STMT_KINDS = static_cast<int>(StmtType::Case) + 1;
+
+/// All statement kinds
+constexpr StmtKindMask STMT_MASK_ALL = ~StmtKindMask(0);
+
+/// All statements that are Assignments (\sa Statement::isAssignment)
+constexpr StmtKindMask STMT_MASK_ASSIGNMENTS = stmtKindMask(StmtType::Assign) |
+                                               stmtKindMask(StmtType::PhiAssign) |
+                                               stmtKindMask(StmtType::ImpAssign) |
+                                               stmtKindMask(StmtType::BoolAssign);
+
+
+/**
+ * A view of the statements of a procedure, optionally restricted to certain kinds of statements.
+ * Unlike UserProc::getStatements, the statements are not copied into a list;
+ * they are visited in place, in the same order.
+ *
+ * Statements may be modified while iterating, but inserting or removing statements
+ * invalidates the iterators, like for the underlying RTLs.
+ */
+class BOOMERANG_API StatementView
+{
+public:
+    class BOOMERANG_API iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef SharedStmt value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const SharedStmt *pointer;
+        typedef const SharedStmt &reference;
+
+    public:
+        iterator(ProcCFG::const_iterator fragIt, ProcCFG::const_iterator fragEnd,
+                 StmtKindMask kinds);
+
+        bool operator==(const iterator &other) const;
+        bool operator!=(const iterator &other) const { return !(*this == other); }
+
+        reference operator*() const { return *m_stmtIt; }
+        pointer operator->() const { return &*m_stmtIt; }
+
+        iterator &operator++();
+        iterator operator++(int);
+
+    private:
+        /// Move to the first statement of the first non-empty RTL, starting at m_fragIt.
+        void enterFragment();
+
+        /// Move to the next statement, regardless of its kind.
+        void step();
+
+        /// Move to the first statement at or after the current position that is in m_kinds.
+        void skipToMatch();
+
+    private:
+        ProcCFG::const_iterator m_fragIt;
+        ProcCFG::const_iterator m_fragEnd;
+        RTLList::iterator m_rtlIt;
+        RTL::iterator m_stmtIt;
+        StmtKindMask m_kinds;
+    };
+
+    typedef iterator const_iterator;
+
+public:
+    StatementView(const ProcCFG *cfg, StmtKindMask kinds = STMT_MASK_ALL);
+
+public:
+    iterator begin() const;
+    iterator end() const;
+
+    bool empty() const { return begin() == end(); }
+
+private:
+    const ProcCFG *m_cfg;
+    StmtKindMask m_kinds;
+};
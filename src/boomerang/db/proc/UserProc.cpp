@@ -11,14 +11,17 @@
 
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
+#include "boomerang/db/BasicBlock.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/CallEffectSummary.h"
 #include "boomerang/db/signature/Signature.h"
 #include "boomerang/decomp/ProcDecompiler.h"
 #include "boomerang/ifc/ITypeRecovery.h"
 #include "boomerang/passes/PassManager.h"
 #include "boomerang/ssl/RTL.h"
 #include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/ExpPattern.h"
 #include "boomerang/ssl/exp/Location.h"
 #include "boomerang/ssl/exp/RefExp.h"
 #include "boomerang/ssl/exp/Ternary.h"
@@ -92,14 +95,68 @@ SharedExp UserProc::getPremised(SharedExp left)
 
 bool UserProc::isPreserved(SharedExp e)
 {
+    if (m_callSummary && m_callSummary->isPreserved(e)) {
+        return true;
+    }
+
     return preservesExp(e);
 }
 
 
+std::shared_ptr<const CallEffectSummary> UserProc::getCallSummary()
+{
+    if (!m_callSummary && isDecompiled()) {
+        m_callSummary = std::make_shared<const CallEffectSummary>(this);
+    }
+
+    return m_callSummary;
+}
+
+
+void UserProc::releaseIR()
+{
+    // Build the summary while the information it is built from is still available
+    getCallSummary();
+
+    m_cfg->clear();
+    m_df = DataFlow(this);
+
+    m_locals.clear();
+    m_symbolMap.clear();
+    m_procUseCollector.clear();
+    m_recurPremises.clear();
+    m_proofCache.clear();
+    m_liftCheckpoint.clear();
+
+    if (m_retStatement) {
+        m_retStatement->setFragment(nullptr); // the fragment does not exist any more
+    }
+}
+
+
 void UserProc::setStatus(ProcStatus s)
 {
+    if (s < ProcStatus::FinalDone) {
+        // Being (re-)analysed; anything summarized so far may change
+        invalidateCallSummary();
+    }
+    else {
+        // Decompilation will not be restarted any more
+        m_liftCheckpoint.clear();
+
+        if (m_prog && m_prog->getProject()->getSettings()->insnRetention ==
+                          InsnRetention::AfterDecompile) {
+            for (IRFragment *frag : *m_cfg) {
+                if (frag->getBB()) {
+                    frag->getBB()->releaseInsns();
+                }
+            }
+        }
+    }
+
     if (m_status != s) {
         m_status = s;
+        m_proofCache.clear(); // New decompilation stage
         if (m_prog) {
             m_prog->getProject()->alertProcStatusChanged(this);
         }
@@ -113,6 +170,47 @@ void UserProc::setDecoded()
 }
 
 
+void UserProc::resetAnalysis()
+{
+    if (m_status < ProcStatus::Decoded) {
+        return;
+    }
+
+    // The calls of this procedure are about to be destroyed
+    for (const SharedStmt &stmt : getStatementView(stmtKindMask(StmtType::Call))) {
+        std::shared_ptr<CallStatement> call = stmt->as<CallStatement>();
+        if (call->getDestProc()) {
+            call->getDestProc()->removeCaller(call);
+        }
+    }
+
+    m_cfg->clear();
+    removeRetStmt();
+    m_df.setRenameLocalsParams(false);
+
+    for (std::vector<SharedStmt> &stmts : m_stmtsByKind) {
+        stmts.clear();
+    }
+
+    m_stmtsByKindStamp = ~uint64(0);
+
+    m_parameters.clear();
+    m_symbolMap.clear();
+    m_locals.clear();
+    m_nextLocal = 0;
+
+    m_procUseCollector.clear();
+    m_provenTrue.clear();
+    m_recurPremises.clear();
+    m_proofCache.clear();
+    m_liftCheckpoint.clear();
+    m_incompleteReason.clear();
+    m_recursionGroup.reset();
+
+    setStatus(ProcStatus::Decoded);
+}
+
+
 IRFragment *UserProc::getEntryFragment() const
 {
     return m_cfg->getEntryFragment();
@@ -160,6 +258,47 @@ void UserProc::getStatements(StatementList &stmts) const
 }
 
 
+StatementView UserProc::getStatementView(StmtKindMask kinds) const
+{
+    return StatementView(m_cfg.get(), kinds);
+}
+
+
+const std::vector<SharedStmt> &UserProc::getStatementsOfKind(StmtType kind) const
+{
+    const uint64 stamp = m_cfg->getModificationStamp();
+
+    if (stamp != m_stmtsByKindStamp) {
+        for (std::vector<SharedStmt> &stmts : m_stmtsByKind) {
+            stmts.clear();
+        }
+
+        for (const SharedStmt &stmt : getStatementView()) {
+            m_stmtsByKind[static_cast<int>(stmt->getKind())].push_back(stmt);
+        }
+
+        m_stmtsByKindStamp = stamp;
+    }
+
+    return m_stmtsByKind[static_cast<int>(kind)];
+}
+
+
+void UserProc::releaseOutdatedStatementIndex()
+{
+    if (m_stmtsByKindStamp == m_cfg->getModificationStamp()) {
+        return;
+    }
+
+    for (std::vector<SharedStmt> &stmts : m_stmtsByKind) {
+        // swap to free the memory as well
+        std::vector<SharedStmt>().swap(stmts);
+    }
+
+    m_stmtsByKindStamp = ~uint64(0);
+}
+
+
 bool UserProc::removeStatement(const SharedStmt &stmt)
 {
     if (!stmt) {
@@ -182,6 +321,7 @@ bool UserProc::removeStatement(const SharedStmt &stmt)
                         provenIt->first, provenIt->second);
 
             provenIt = m_provenTrue.erase(provenIt);
+            invalidateCallSummary();
             continue;
         }
 
@@ -194,16 +334,13 @@ bool UserProc::removeStatement(const SharedStmt &stmt)
         return false;
     }
 
-    for (auto &rtl : *frag->getRTLs()) {
-        for (RTL::iterator it = rtl->begin(); it != rtl->end(); ++it) {
-            if (*it == stmt) {
-                rtl->erase(it);
-                return true;
-            }
-        }
+    RTL *rtl = frag->findRTLOf(stmt);
+    if (!rtl) {
+        return false;
     }
 
-    return false;
+    rtl->erase(rtl->find(stmt));
+    return true;
 }
 
 
@@ -228,13 +365,11 @@ std::shared_ptr<Assign> UserProc::insertAssignAfter(SharedStmt s, SharedExp left
     if (s != nullptr) {
         // Insert the new assignment directly after s,
         // or near the end of the existing fragment if s has been removed already.
-        for (auto &rtl : *frag->getRTLs()) {
-            for (auto it = rtl->begin(); it != rtl->end(); ++it) {
-                if (*it == s) {
-                    rtl->insert(++it, as);
-                    return as;
-                }
-            }
+        RTL *rtl = frag->findRTLOf(s);
+
+        if (rtl) {
+            rtl->insert(std::next(rtl->find(s)), as);
+            return as;
         }
     }
 
@@ -259,17 +394,14 @@ bool UserProc::insertStatementAfter(const SharedStmt &afterThis, const SharedStm
     IRFragment *frag = afterThis->getFragment();
     assert(frag != nullptr);
 
-    for (auto &rtl : *frag->getRTLs()) {
-        for (RTL::iterator ss = rtl->begin(); ss != rtl->end(); ++ss) {
-            if (*ss == afterThis) {
-                rtl->insert(std::next(ss), stmt);
-                stmt->setFragment(frag);
-                return true;
-            }
-        }
+    RTL *rtl = frag->findRTLOf(afterThis);
+    if (!rtl) {
+        return false;
     }
 
-    return false;
+    rtl->insert(std::next(rtl->find(afterThis)), stmt);
+    stmt->setFragment(frag);
+    return true;
 }
 
 
@@ -279,66 +411,62 @@ std::shared_ptr<Assign> UserProc::replacePhiByAssign(const std::shared_ptr<const
     // I believe we always want to propagate to these ex-phi's; check!
     SharedExp newRhs = rhs->propagateAll();
 
-    for (IRFragment *frag : *m_cfg) {
-        for (const auto &rtl : *frag->getRTLs()) {
-            for (RTL::iterator ss = rtl->begin(); ss != rtl->end(); ++ss) {
-                if (*ss == orig) {
-                    // convert *ss to an Assign
-                    std::shared_ptr<Assign> asgn(new Assign(orig->getLeft()->clone(), newRhs));
-
-                    asgn->setType(orig->getType()->clone());
-                    asgn->setNumber(orig->getNumber());
-                    asgn->setProc(orig->getProc());
-                    asgn->setFragment(frag);
-
-                    SharedStmt toDelete = *ss;
-
-                    // Erase the phi, and insert the assign after any remaining phis.
-                    // Since all phis have different LHSes, the order does not matter.
-                    ss = rtl->erase(ss);
-                    while (ss != rtl->end() && (*ss)->isPhi()) {
-                        ++ss;
-                    }
-                    rtl->insert(ss, asgn);
+    if (!orig || !orig->getFragment()) {
+        return nullptr;
+    }
 
-                    StatementList stmts;
-                    getStatements(stmts);
+    IRFragment *frag = const_cast<IRFragment *>(orig->getFragment());
+    RTL *rtl         = frag->findRTLOf(orig);
 
-                    // replace all refs orig -> asgn
-                    for (const SharedStmt &stmt : stmts) {
-                        StmtSubscriptReplacer stmtMod(orig, asgn);
+    if (!rtl) {
+        return nullptr;
+    }
 
-                        stmt->accept(&stmtMod);
-                    }
+    // convert orig to an Assign
+    std::shared_ptr<Assign> asgn(new Assign(orig->getLeft()->clone(), newRhs));
 
-                    SymbolMap newSymbols;
+    asgn->setType(orig->getType()->clone());
+    asgn->setNumber(orig->getNumber());
+    asgn->setProc(orig->getProc());
+    asgn->setFragment(frag);
 
-                    for (auto it = m_symbolMap.begin(); it != m_symbolMap.end();) {
-                        SharedExp exp = (*it).first->clone();
-                        ExpSubscriptReplacer esr(orig, asgn);
-                        exp->acceptModifier(&esr);
+    // Erase the phi, and insert the assign after any remaining phis.
+    // Since all phis have different LHSes, the order does not matter.
+    RTL::iterator ss = rtl->erase(rtl->find(orig));
+    while (ss != rtl->end() && (*ss)->isPhi()) {
+        ++ss;
+    }
+    rtl->insert(ss, asgn);
 
-                        if (esr.isModified()) {
-                            SharedExp local = it->second;
-                            it              = m_symbolMap.erase(it);
-                            newSymbols.insert({ exp, local });
-                        }
-                        else {
-                            ++it;
-                        }
-                    }
+    // replace all refs orig -> asgn
+    for (const SharedStmt &stmt : getStatementView()) {
+        StmtSubscriptReplacer stmtMod(orig, asgn);
 
-                    for (auto elem : newSymbols) {
-                        m_symbolMap.insert(elem);
-                    }
+        stmt->accept(&stmtMod);
+    }
 
-                    return asgn;
-                }
-            }
+    SymbolMap newSymbols;
+
+    for (auto it = m_symbolMap.begin(); it != m_symbolMap.end();) {
+        SharedExp exp = (*it).first->clone();
+        ExpSubscriptReplacer esr(orig, asgn);
+        exp->acceptModifier(&esr);
+
+        if (esr.isModified()) {
+            SharedExp local = it->second;
+            it              = m_symbolMap.erase(it);
+            newSymbols.insert({ exp, local });
+        }
+        else {
+            ++it;
         }
     }
 
-    return nullptr;
+    for (auto elem : newSymbols) {
+        m_symbolMap.insert(elem);
+    }
+
+    return asgn;
 }
 
 
@@ -913,8 +1041,9 @@ bool UserProc::searchAndReplace(const Exp &search, SharedExp replace)
     StatementList stmts;
     getStatements(stmts);
 
+    const ExpPattern pattern(search);
     for (SharedStmt s : stmts) {
-        ch |= s->searchAndReplace(search, replace);
+        ch |= s->searchAndReplace(pattern, replace);
     }
 
     return ch;
@@ -1172,7 +1301,8 @@ SharedConstType UserProc::getTypeForLocation(const SharedConstExp &e) const
 static const SharedExp defAll = Terminal::get(opDefineAll);
 
 
-bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRight, bool conditional)
+bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRight, bool conditional,
+                          int *stepsLeft)
 {
     if ((m_provenTrue.find(queryLeft) != m_provenTrue.end()) &&
         (*m_provenTrue[queryLeft] == *queryRight)) {
@@ -1216,15 +1346,17 @@ bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRigh
             // no definition reaching the exit
             auto right = origRight->clone()->simplify(); // In case it's sp+0
 
+            // Recurse in case <all> not proven yet
             if ((*origLeft == *right) &&                // x == x
                 (origLeft->getOper() != opDefineAll) && // Beware infinite recursion
-                proveEqual(defAll, defAll)) {           // Recurse in case <all> not proven yet
+                proveEqual(defAll, defAll, false, stepsLeft)) {
                 if (m_prog->getProject()->getSettings()->debugProof) {
                     LOG_MSG("Using all=all for %1", query->getSubExp1());
                     LOG_MSG("Prove returns true");
                 }
 
                 m_provenTrue[origLeft->clone()] = right;
+                invalidateCallSummary();
                 return true;
             }
 
@@ -1237,17 +1369,54 @@ bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRigh
         }
     }
 
-    if (m_recursionGroup) { // If in involved in a recursion cycle
-        //    then save the original query as a premise for bypassing calls
-        m_recurPremises[origLeft->clone()] = origRight;
+    bool hasPremises         = false;
+    const SharedExp cacheKey = makeProofCacheKey(query, hasPremises);
+    bool result              = false;
+
+    m_proofCache.validate(m_cfg->getModificationStamp());
+
+    if (m_proofCache.findResult(cacheKey, result)) {
+        if (m_prog->getProject()->getSettings()->debugProof) {
+            LOG_MSG("found %1 in proof cache of %2", query, getName());
+        }
     }
+    else {
+        // Limit the number of steps so pathological phi webs do not hang the decompilation
+        const int stepLimit = m_prog->getProject()->getSettings()->proofStepLimit;
+        int ownSteps        = stepLimit;
+
+        if (!stepsLeft && stepLimit > 0) {
+            stepsLeft = &ownSteps;
+        }
 
-    std::set<std::shared_ptr<PhiAssign>> lastPhis;
-    std::map<std::shared_ptr<PhiAssign>, SharedExp> cache;
-    bool result = prover(query, lastPhis, cache);
+        if (m_recursionGroup) { // If in involved in a recursion cycle
+            //    then save the original query as a premise for bypassing calls
+            m_recurPremises[origLeft->clone()] = origRight;
+        }
 
-    if (m_recursionGroup) {
-        killPremise(origLeft); // Remove the premise, regardless of result
+        ProofContext ctx;
+        ctx.stepsLeft = stepsLeft;
+        result        = prover(query, ctx);
+
+        if (m_recursionGroup) {
+            killPremise(origLeft); // Remove the premise, regardless of result
+        }
+
+        if (stepsLeft && *stepsLeft < 0) {
+            // Do not cache the result: With a fresh budget (e.g. when queried directly
+            // instead of from another proof) the proof might succeed.
+            LOG_WARN("Proof of %1 in %2 exceeded the limit of %3 steps, assuming false", query,
+                     getName(), stepLimit);
+            result = false;
+        }
+        else {
+            if (result && !hasPremises) {
+                // Unconditional proof: the phis proven along the way are valid for other queries
+                m_proofCache.addPhiProofs(ctx.phiCache);
+            }
+
+            m_proofCache.addResult(cacheKey, result);
+        }
     }
 
     if (m_prog->getProject()->getSettings()->debugProof) {
@@ -1257,26 +1426,39 @@ bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRigh
 
     if (result && !conditional) {
         m_provenTrue[origLeft] = origRight; // Save the now proven equation
+        invalidateCallSummary();
     }
 
     return result;
 }
 
 
-bool UserProc::prover(SharedExp query, std::set<std::shared_ptr<PhiAssign>> &lastPhis,
-                      std::map<std::shared_ptr<PhiAssign>, SharedExp> &cache,
+bool UserProc::prover(SharedExp query, ProofContext &ctx,
                       std::shared_ptr<PhiAssign> lastPhi /* = nullptr */)
 {
+    if (!ctx.consumeStep()) {
+        return false;
+    }
+
     // A map that seems to be used to detect loops in the call graph:
     std::map<std::shared_ptr<CallStatement>, SharedExp> called;
     auto phiInd = query->getSubExp2()->clone();
 
-    if (lastPhi && (cache.find(lastPhi) != cache.end()) && (*cache[lastPhi] == *phiInd)) {
-        if (m_prog->getProject()->getSettings()->debugProof) {
-            LOG_MSG("true - in the phi cache");
-        }
+    if (lastPhi) {
+        // prover may be called directly for the callee of a call in another procedure
+        m_proofCache.validate(m_cfg->getModificationStamp());
 
-        return true;
+        auto it            = ctx.phiCache.find(lastPhi);
+        SharedExp provenTo = (it != ctx.phiCache.end()) ? it->second
+                                                        : m_proofCache.findPhiProof(lastPhi);
+
+        if (provenTo && (*provenTo == *phiInd)) {
+            if (m_prog->getProject()->getSettings()->debugProof) {
+                LOG_MSG("true - in the phi cache");
+            }
+
+            return true;
+        }
     }
 
     std::set<SharedStmt> refsTo;
@@ -1286,6 +1468,10 @@ bool UserProc::prover(SharedExp query, std::set<std::shared_ptr<PhiAssign>> &las
     bool swapped = false;
 
     while (change) {
+        if (!ctx.consumeStep()) {
+            return false;
+        }
+
         if (m_prog->getProject()->getSettings()->debugProof) {
             LOG_MSG("%1", query);
         }
@@ -1345,7 +1531,7 @@ bool UserProc::prover(SharedExp query, std::set<std::shared_ptr<PhiAssign>> &las
                             query->setSubExp1(queryLeft);
 
                             // Now try everything on the result
-                            return prover(query, lastPhis, cache, lastPhi);
+                            return prover(query, ctx, lastPhi);
                         }
                         else {
                             // Check if the required preservation is one of the premises already
@@ -1361,7 +1547,7 @@ bool UserProc::prover(SharedExp query, std::set<std::shared_ptr<PhiAssign>> &las
 
                                 auto queryLeft = call->localiseExp(premisedTo->clone());
                                 query->setSubExp1(queryLeft);
-                                return prover(query, lastPhis, cache, lastPhi);
+                                return prover(query, ctx, lastPhi);
                             }
                             else {
                                 // There is no proof, and it's not one of the premises. It may yet
@@ -1379,7 +1565,7 @@ bool UserProc::prover(SharedExp query, std::set<std::shared_ptr<PhiAssign>> &las
                                 // Pass conditional as true, since even if proven, this is
                                 // conditional on other things
                                 bool result = destProc->proveEqual(base->clone(), base->clone(),
-                                                                   true);
+                                                                   true, ctx.stepsLeft);
                                 destProc->killPremise(base);
 
                                 if (result) {
@@ -1393,7 +1579,7 @@ bool UserProc::prover(SharedExp query, std::set<std::shared_ptr<PhiAssign>> &las
                                     // Use the new conditionally proven result
                                     auto queryLeft = call->localiseExp(base->clone());
                                     query->setSubExp1(queryLeft);
-                                    return destProc->prover(query, lastPhis, cache, lastPhi);
+                                    return destProc->prover(query, ctx, lastPhi);
                                 }
                                 else {
                                     if (m_prog->getProject()->getSettings()->debugProof) {
@@ -1445,7 +1631,7 @@ bool UserProc::prover(SharedExp query, std::set<std::shared_ptr<PhiAssign>> &las
                     std::shared_ptr<PhiAssign> pa = s->as<PhiAssign>();
                     bool ok                       = true;
 
-                    if ((lastPhis.find(pa) != lastPhis.end()) || (pa == lastPhi)) {
+                    if ((ctx.lastPhis.find(pa) != ctx.lastPhis.end()) || (pa == lastPhi)) {
                         ok = (*query->getSubExp2() == *phiInd);
 
                         if (m_prog->getProject()->getSettings()->debugProof) {
@@ -1473,20 +1659,20 @@ bool UserProc::prover(SharedExp query, std::set<std::shared_ptr<PhiAssign>> &las
                                 LOG_MSG("proving for %1", e);
                             }
 
-                            lastPhis.insert(lastPhi);
+                            ctx.lastPhis.insert(lastPhi);
 
-                            if (!prover(e, lastPhis, cache, pa)) {
+                            if (!prover(e, ctx, pa)) {
                                 ok = false;
                                 // delete e;
                                 break;
                             }
 
-                            lastPhis.erase(lastPhi);
+                            ctx.lastPhis.erase(lastPhi);
                             // delete e;
                         }
 
                         if (ok) {
-                            cache[pa] = query->getSubExp2()->clone();
+                            ctx.phiCache[pa] = query->getSubExp2()->clone();
                         }
                     }
 
@@ -1584,6 +1770,27 @@ bool UserProc::prover(SharedExp query, std::set<std::shared_ptr<PhiAssign>> &las
 }
 
 
+SharedExp UserProc::makeProofCacheKey(const SharedExp &query, bool &hasPremises) const
+{
+    // The result of a query may depend on the premises of all procs in our recursion group
+    // (see prover()), so they are part of the key.
+    // Key: query . (premise1 . (premise2 . ...))
+    SharedExp premises = Terminal::get(opNil);
+    hasPremises        = false;
+
+    if (m_recursionGroup) {
+        for (const UserProc *proc : *m_recursionGroup) {
+            for (const auto &[left, right] : proc->m_recurPremises) {
+                premises    = Binary::get(opList, Binary::get(opEquals, left, right), premises);
+                hasPremises = true;
+            }
+        }
+    }
+
+    return Binary::get(opList, query->clone(), premises);
+}
+
+
 SharedExp UserProc::getSymbolFor(const SharedConstExp &from, const SharedConstType &ty) const
 {
     assert(ty != nullptr);
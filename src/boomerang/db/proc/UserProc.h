@@ -14,10 +14,17 @@
 #include "boomerang/db/UseCollector.h"
 #include "boomerang/db/proc/Proc.h"
 #include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/LiftCheckpoint.h"
+#include "boomerang/db/proc/ProofCache.h"
+#include "boomerang/db/proc/StatementView.h"
 #include "boomerang/util/StatementList.h"
 
+#include <array>
+#include <vector>
+
 
 class Binary;
+class CallEffectSummary;
 class UserProc;
 class Assign;
 class ReturnStatement;
@@ -121,6 +128,21 @@ public:
     /// Records that this procedure has been decoded.
     void setDecoded();
 
+    /**
+     * Discard all results of the decompilation of this procedure (statements, locals,
+     * parameters, proofs etc.) and go back to ProcStatus::Decoded, so that it can be
+     * decompiled again from scratch. The signature is kept, as callers depend on it.
+     * \sa Project::refineProc
+     */
+    void resetAnalysis();
+
+    /// Record that the analysis of this procedure was stopped before it was complete,
+    /// e.g. because it exceeded its decompilation budget.
+    /// \p reason is mentioned in the generated code.
+    void setAnalysisIncomplete(const QString &reason) { m_incompleteReason = reason; }
+    bool isAnalysisIncomplete() const { return !m_incompleteReason.isEmpty(); }
+    const QString &getIncompleteReason() const { return m_incompleteReason; }
+
     bool isEarlyRecursive() const
     {
         return m_recursionGroup != nullptr && m_status <= ProcStatus::InCycle;
@@ -151,6 +173,20 @@ public:
     /// \returns all statements in this UserProc
     void getStatements(StatementList &stmts) const;
 
+    /// \returns all statements in this UserProc of the kinds in \p kinds, without copying them.
+    StatementView getStatementView(StmtKindMask kinds = STMT_MASK_ALL) const;
+
+    /// \returns all statements of kind \p kind in this UserProc, in the same order as
+    /// getStatements. The index is built on first use and rebuilt after statements
+    /// were inserted or removed.
+    /// \note The returned vector may change on the next call after statements were inserted
+    /// or removed; copy it before changing the statements of this procedure.
+    const std::vector<SharedStmt> &getStatementsOfKind(StmtType kind) const;
+
+    /// Release the index of getStatementsOfKind if it is outdated,
+    /// so that it does not keep removed statements alive.
+    void releaseOutdatedStatementIndex();
+
     /// Remove (but not delete) \p stmt from this UserProc
     /// \returns true iff successfully removed
     bool removeStatement(const SharedStmt &stmt);
@@ -331,6 +367,35 @@ public:
 
     const ExpExpMap &getProvenTrue() const { return m_provenTrue; }
 
+    /// \returns the summary of the effects of calling this procedure, or nullptr if this
+    /// procedure is not fully decompiled yet. The summary is built on first use after the
+    /// procedure has reached ProcStatus::FinalDone and is shared by all call sites.
+    std::shared_ptr<const CallEffectSummary> getCallSummary();
+
+    /// Discard the call effect summary, e.g. because this procedure is being re-analysed.
+    /// It will be rebuilt on the next call to getCallSummary().
+    void invalidateCallSummary() { m_callSummary.reset(); }
+
+    const ProofCache &getProofCache() const { return m_proofCache; }
+
+    /// Forget all memoized proofs, e.g. at the start of a new decompilation stage.
+    void clearProofCache() { m_proofCache.clear(); }
+
+    /// \returns the lifted RTLs of the instructions of this procedure,
+    /// for restarting the decompilation without lifting everything again.
+    /// The checkpoint is discarded once the procedure is fully decompiled.
+    LiftCheckpoint &getLiftCheckpoint() { return m_liftCheckpoint; }
+    const LiftCheckpoint &getLiftCheckpoint() const { return m_liftCheckpoint; }
+
+    /**
+     * Free the IR (CFG, data flow information, locals and symbols) of this procedure
+     * after code has been generated for it. Only the signature, the parameters,
+     * the return statement and the call summary are kept, which is all that
+     * is needed to decompile callers of this procedure.
+     * \sa Settings::streamDecompilation
+     */
+    void releaseIR();
+
 public:
     QString toString() const;
 
@@ -362,16 +427,36 @@ private:
     SharedType getTypeForLocation(const SharedExp &e);
     SharedConstType getTypeForLocation(const SharedConstExp &e) const;
 
+    /// State of a single top level proof, shared by all recursive invocations of prover()
+    struct ProofContext
+    {
+        std::set<std::shared_ptr<PhiAssign>> lastPhis;
+        ProofCache::PhiProofMap phiCache; ///< Phis proven during this proof
+
+        /// Number of prover steps left for this proof, or nullptr if unlimited.
+        /// Shared with nested proofs in other procedures.
+        int *stepsLeft = nullptr;
+
+        /// \returns false if the step limit has been reached
+        bool consumeStep() { return !stepsLeft || (*stepsLeft)-- > 0; }
+    };
+
     /// Prove any arbitary property of this procedure.
     /// If \p conditional is true, do not save the result,
     /// as it may be conditional on premises stored in other procedures
+    /// \param stepsLeft remaining prover steps of the enclosing proof, if any.
+    ///        If nullptr, the proof starts with a fresh budget of Settings::proofStepLimit steps.
     /// \note this function was non-reentrant, but now reentrancy is frequently used
-    bool proveEqual(const SharedExp &lhs, const SharedExp &rhs, bool conditional = false);
+    bool proveEqual(const SharedExp &lhs, const SharedExp &rhs, bool conditional = false,
+                    int *stepsLeft = nullptr);
 
     /// helper function for proveEqual()
-    bool prover(SharedExp query, std::set<std::shared_ptr<PhiAssign>> &lastPhis,
-                std::map<std::shared_ptr<PhiAssign>, SharedExp> &cache,
-                std::shared_ptr<PhiAssign> lastPhi = nullptr);
+    bool prover(SharedExp query, ProofContext &ctx, std::shared_ptr<PhiAssign> lastPhi = nullptr);
+
+    /// \returns the key for looking up \p query in the proof cache. The key contains
+    /// all premises of the recursion group of this procedure.
+    /// \param hasPremises set to true iff any premises are active
+    SharedExp makeProofCacheKey(const SharedExp &query, bool &hasPremises) const;
 
     // FIXME: is this the same as lookupSym() now?
     /// Lookup the expression in the symbol map. Return nullptr or a C string with the symbol. Use
@@ -396,6 +481,10 @@ private:
 
     std::unique_ptr<ProcCFG> m_cfg; ///< The control flow graph.
 
+    /// Statements of m_cfg by kind. \sa getStatementsOfKind
+    mutable std::array<std::vector<SharedStmt>, NUM_STMT_KINDS> m_stmtsByKind;
+    mutable uint64 m_stmtsByKindStamp = ~uint64(0); ///< CFG modification stamp of m_stmtsByKind
+
     /// DataFlow object. Holds information relevant to transforming to and from SSA form.
     DataFlow m_df;
 
@@ -453,8 +542,20 @@ private:
      */
     ExpExpMap m_recurPremises;
 
+    /// Memoized results of proveEqual() for the current decompilation stage
+    ProofCache m_proofCache;
+
+    /// Lifted RTLs for restarting the decompilation of this procedure
+    LiftCheckpoint m_liftCheckpoint;
+
+    /// Why the analysis of this procedure is incomplete; empty if it is complete.
+    QString m_incompleteReason;
+
     std::shared_ptr<ProcSet> m_recursionGroup;
 
+    /// Cached effects of calling this procedure; only valid when fully decompiled.
+    std::shared_ptr<const CallEffectSummary> m_callSummary;
+
     /**
      * We ensure that there is only one return statement now.
      * See code in frontend/frontend.cpp handling case StmtType::Ret.
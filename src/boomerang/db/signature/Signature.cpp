@@ -28,12 +28,34 @@
 #include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 
+#include <atomic>
 #include <cassert>
 #include <cstring>
 #include <sstream>
 #include <string>
 
 
+static std::atomic<int> g_numLiveSignatures{ 0 };
+
+
+Signature::LiveCount::LiveCount()
+{
+    g_numLiveSignatures++;
+}
+
+
+Signature::LiveCount::LiveCount(const LiveCount &)
+{
+    g_numLiveSignatures++;
+}
+
+
+Signature::LiveCount::~LiveCount()
+{
+    g_numLiveSignatures--;
+}
+
+
 Signature::Signature(const QString &name)
     : m_ellipsis(false)
     , m_unknown(true)
@@ -53,6 +75,12 @@ Signature::~Signature()
 }
 
 
+int Signature::getNumLive()
+{
+    return g_numLiveSignatures.load();
+}
+
+
 std::shared_ptr<Signature> Signature::clone() const
 {
     auto n = std::make_shared<Signature>(m_name);
@@ -212,6 +212,9 @@ public:
 public:
     void print(OStream &out, bool = false) const;
 
+    /// \returns the number of Signature objects that currently exist.
+    static int getNumLive();
+
 protected:
     QString m_name;    ///< name of procedure
     QString m_sigFile; ///< signature file this signature was read from (for libprocs)
@@ -222,4 +225,17 @@ protected:
     bool m_unknown;
     bool m_forced;
     QString m_preferredName;
+
+private:
+    /// Counts the live signatures, including copies (\sa getNumLive)
+    struct LiveCount
+    {
+        LiveCount();
+        LiveCount(const LiveCount &other);
+        ~LiveCount();
+
+        LiveCount &operator=(const LiveCount &) { return *this; }
+    };
+
+    LiveCount m_liveCount;
 };
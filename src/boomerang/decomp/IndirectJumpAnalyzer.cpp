@@ -110,6 +110,22 @@ static const SwitchForm hlForms[] = {
 // clang-format on
 
 
+/// All switch forms, compiled for matching them in a single pass over the jump destination.
+/// The index of a pattern is the index of the form in \ref hlForms.
+static const ExpPatternSet &getSwitchFormPatterns()
+{
+    static const ExpPatternSet patterns = [] {
+        ExpPatternSet set(ExpPattern::Mode::NoSubscript);
+        for (const SwitchForm &form : hlForms) {
+            set.addPattern(form.pattern);
+        }
+        return set;
+    }();
+
+    return patterns;
+}
+
+
 /// Find all the possible constant values that the location defined by s could be assigned with
 static void findConstantValues(const SharedConstStmt &s, std::list<int> &dests)
 {
@@ -321,6 +337,13 @@ bool IndirectJumpAnalyzer::processSwitch(IRFragment *frag, UserProc *proc)
     // be a goto to the code for case 3, but a smarter back end could group them
     std::list<std::pair<IRFragment *, Address>> dests;
 
+    // Read all entries of simple tables at once; form H tables contain (value, dest) pairs
+    // and form F has no table at all.
+    std::vector<Address> tableEntries;
+    if (si->switchType != SwitchType::H && si->switchType != SwitchType::F) {
+        tableEntries = image->readNativeAddrs4(si->tableAddr, numCases);
+    }
+
     for (int i = 0; i < numCases; i++) {
         // Get the destination address from the switch table.
         if (si->switchType == SwitchType::H) {
@@ -333,10 +356,12 @@ bool IndirectJumpAnalyzer::processSwitch(IRFragment *frag, UserProc *proc)
             }
         }
         else if (si->switchType == SwitchType::F) {
-            const int *entry  = reinterpret_cast<int *>(si->tableAddr.value());
-            switchDestination = Address(entry[i]);
+            switchDestination = Address(si->destValues[i]);
+        }
+        else if (i < (int)tableEntries.size()) {
+            switchDestination = tableEntries[i];
         }
-        else if (!image->readNativeAddr4(si->tableAddr + 4 * i, switchDestination)) {
+        else {
             continue;
         }
 
@@ -427,15 +452,12 @@ bool IndirectJumpAnalyzer::analyzeCompJump(IRFragment *frag, UserProc *proc)
 
     SwitchType switchType = SwitchType::Invalid;
 
-    for (auto &val : hlForms) {
-        if (jumpDest->equalNoSubscript(*val.pattern)) {
-            switchType = val.type;
+    const int formIdx = getSwitchFormPatterns().findFirstMatch(*jumpDest);
+    if (formIdx != -1) {
+        switchType = hlForms[formIdx].type;
 
-            if (proc->getProg()->getProject()->getSettings()->debugSwitch) {
-                LOG_MSG("Indirect jump matches form %1", static_cast<char>(switchType));
-            }
-
-            break;
+        if (proc->getProg()->getProject()->getSettings()->debugSwitch) {
+            LOG_MSG("Indirect jump matches form %1", static_cast<char>(switchType));
         }
     }
 
@@ -454,14 +476,19 @@ bool IndirectJumpAnalyzer::analyzeCompJump(IRFragment *frag, UserProc *proc)
             // findNumCases() thinks is the number of cases, when finding the first array
             // element not pointing to code.
             if (switchType == SwitchType::A) {
-                const Prog *prog = proc->getProg();
+                const Prog *prog         = proc->getProg();
+                const BinaryImage *image = prog->getBinaryFile()->getImage();
+
+                // Read the whole table at once instead of looking up the section for each entry
+                const std::vector<Address> entries = image->readNativeAddrs4(
+                    swi->tableAddr, swi->numTableEntries);
 
                 for (int entryIdx = 0; entryIdx < swi->numTableEntries; ++entryIdx) {
-                    const BinaryImage *image = prog->getBinaryFile()->getImage();
-                    Address switchEntryAddr  = Address::INVALID;
+                    const Address switchEntryAddr = entryIdx < (int)entries.size()
+                                                        ? entries[entryIdx]
+                                                        : Address::INVALID;
 
-                    if (!image->readNativeAddr4(swi->tableAddr + entryIdx * 4, switchEntryAddr) ||
-                        !Util::inRange(switchEntryAddr, prog->getLimitTextLow(),
+                    if (!Util::inRange(switchEntryAddr, prog->getLimitTextLow(),
                                        prog->getLimitTextHigh())) {
                         if (proc->getProg()->getProject()->getSettings()->debugSwitch) {
                             LOG_WARN("Truncating type A indirect jump array to %1 entries "
@@ -517,19 +544,15 @@ bool IndirectJumpAnalyzer::analyzeCompJump(IRFragment *frag, UserProc *proc)
                 // that <location> could be assigned to in dests
                 std::list<int> dests;
                 findConstantValues(jumpDest->access<RefExp>()->getDef(), dests);
-                // The switch info wants an array of native addresses
-                std::size_t num_dests = dests.size();
+                const std::size_t num_dests = dests.size();
 
                 if (num_dests > 0) {
-                    int *destArray = new int[num_dests];
-                    std::copy(dests.begin(), dests.end(), destArray);
-
                     std::unique_ptr<SwitchInfo> swi(new SwitchInfo);
 
                     swi->switchType = SwitchType::F; // The "Fortran" form
                     swi->switchExp  = jumpDest;
-                    // WARN: HACK HACK HACK Abuse the tableAddr member as a pointer
-                    swi->tableAddr       = Address(HostAddress(destArray).value());
+                    swi->tableAddr  = Address::INVALID;
+                    swi->destValues.assign(dests.begin(), dests.end());
                     swi->lowerBound      = 1; // Not used, except to compute
                     swi->upperBound      = static_cast<int>(num_dests); // the number of options
                     swi->numTableEntries = static_cast<int>(num_dests);
@@ -628,6 +651,22 @@ static const std::vector<std::pair<const SharedConstExp, IndCallPattern>> hlCall
 // clang-format on
 
 
+/// All indirect call patterns, compiled for matching them in a single pass over the call
+/// destination. The index of a pattern is the index in \ref hlCallPatterns.
+static const ExpPatternSet &getCallPatterns()
+{
+    static const ExpPatternSet patterns = [] {
+        ExpPatternSet set(ExpPattern::Mode::NoSubscript);
+        for (const auto &callPattern : hlCallPatterns) {
+            set.addPattern(callPattern.first);
+        }
+        return set;
+    }();
+
+    return patterns;
+}
+
+
 bool IndirectJumpAnalyzer::analyzeCompCall(IRFragment *frag, UserProc *proc)
 {
     Prog *prog = proc->getProg();
@@ -667,14 +706,11 @@ bool IndirectJumpAnalyzer::analyzeCompCall(IRFragment *frag, UserProc *proc)
 
     IndCallPattern foundPatternID = IndCallPattern::Invalid;
 
-    for (auto &[pattern, patternID] : hlCallPatterns) {
-        if (e->equalNoSubscript(*pattern)) {
-            foundPatternID = patternID;
-            if (prog->getProject()->getSettings()->debugSwitch) {
-                LOG_MSG("Indirect call matches pattern '%1'", pattern);
-            }
-
-            break;
+    const int patternIdx = getCallPatterns().findFirstMatch(*e);
+    if (patternIdx != -1) {
+        foundPatternID = hlCallPatterns[patternIdx].second;
+        if (prog->getProject()->getSettings()->debugSwitch) {
+            LOG_MSG("Indirect call matches pattern '%1'", hlCallPatterns[patternIdx].first);
         }
     }
 
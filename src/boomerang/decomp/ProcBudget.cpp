@@ -0,0 +1,70 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProcBudget.h"
+
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/IRFragment.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/RTL.h"
+
+
+ProcBudget::ProcBudget(const Settings *settings, Clock::time_point deadline)
+    : m_timeLimit(std::chrono::seconds(settings->procTimeLimit))
+    , m_passLimit(static_cast<uint64>(settings->procPassLimit))
+    , m_stmtLimit(settings->procStmtLimit)
+    , m_deadline(deadline)
+{
+}
+
+
+void ProcBudget::addUsage(Clock::duration time, uint64 numPasses)
+{
+    m_timeUsed += time;
+    m_numPassesUsed += numPasses;
+}
+
+
+QString ProcBudget::checkLimits(UserProc *proc, Clock::time_point now) const
+{
+    if (now >= m_deadline) {
+        return "time limit for the whole program exceeded";
+    }
+    else if (m_timeLimit > Clock::duration::zero() && m_timeUsed > m_timeLimit) {
+        const auto secs = std::chrono::duration_cast<std::chrono::seconds>(m_timeLimit).count();
+        return QString("time limit of %1 seconds exceeded").arg(secs);
+    }
+    else if (m_passLimit > 0 && m_numPassesUsed > m_passLimit) {
+        return QString("limit of %1 analysis passes exceeded").arg(m_passLimit);
+    }
+    else if (m_stmtLimit > 0 && countStatements(proc) > m_stmtLimit) {
+        return QString("limit of %1 statements exceeded").arg(m_stmtLimit);
+    }
+
+    return "";
+}
+
+
+int ProcBudget::countStatements(UserProc *proc)
+{
+    int numStmts = 0;
+
+    for (IRFragment *frag : *proc->getCFG()) {
+        if (!frag->getRTLs()) {
+            continue;
+        }
+
+        for (const std::unique_ptr<RTL> &rtl : *frag->getRTLs()) {
+            numStmts += static_cast<int>(rtl->size());
+        }
+    }
+
+    return numStmts;
+}
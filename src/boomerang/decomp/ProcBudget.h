@@ -0,0 +1,65 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/util/Types.h"
+
+#include <QString>
+
+#include <chrono>
+
+
+class Settings;
+class UserProc;
+
+
+/**
+ * Keeps track of the resources spent on the analysis of a single procedure
+ * and checks them against the per-procedure budgets in Settings
+ * (procTimeLimit, procPassLimit, procStmtLimit) and against the deadline
+ * for the whole decompilation.
+ *
+ * Only resources spent on the procedure itself are counted;
+ * the time spent on decompiling callees is charged to the callees.
+ */
+class BOOMERANG_API ProcBudget
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+public:
+    /// \param deadline Clock::time_point::max() if there is no deadline
+    ProcBudget(const Settings *settings, Clock::time_point deadline);
+
+public:
+    /// Charge \p time and \p numPasses to the procedure.
+    void addUsage(Clock::duration time, uint64 numPasses);
+
+    /// \returns a description of the first exceeded limit,
+    /// or an empty string if \p proc is still within its budget.
+    QString checkLimits(UserProc *proc, Clock::time_point now) const;
+
+    Clock::duration getTimeUsed() const { return m_timeUsed; }
+    uint64 getNumPassesUsed() const { return m_numPassesUsed; }
+
+private:
+    static int countStatements(UserProc *proc);
+
+private:
+    Clock::duration m_timeLimit; ///< zero if there is no limit
+    uint64 m_passLimit;          ///< 0 if there is no limit
+    int m_stmtLimit;             ///< 0 if there is no limit
+    Clock::time_point m_deadline;
+
+    Clock::duration m_timeUsed = Clock::duration::zero();
+    uint64 m_numPassesUsed     = 0;
+};
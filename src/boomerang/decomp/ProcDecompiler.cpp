@@ -14,6 +14,7 @@
 #include "boomerang/db/BasicBlock.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/decomp/IndirectJumpAnalyzer.h"
+#include "boomerang/decomp/ProcFinalizer.h"
 #include "boomerang/ifc/IFrontEnd.h"
 #include "boomerang/passes/PassManager.h"
 #include "boomerang/ssl/RTL.h"
@@ -25,7 +26,13 @@
 #include "boomerang/util/log/SeparateLogger.h"
 
 
-ProcDecompiler::ProcDecompiler()
+ProcDecompiler::ProcDecompiler(ProcFinalizer *finalizer, ProcBudget::Clock::time_point deadline,
+                               DecompileTier tier)
+    : m_finalizer(finalizer)
+    , m_tier(tier)
+    , m_deadline(deadline)
+    , m_lastCharge(ProcBudget::Clock::now())
+    , m_lastChargedPasses(PassManager::get()->getNumExecutedPasses())
 {
 }
 
@@ -66,15 +73,29 @@ ProcStatus ProcDecompiler::tryDecompileRecursive(UserProc *proc)
         proc->setStatus(ProcStatus::Visited);
     }
 
+    chargeBudget();
     m_callStack.push_back(proc);
 
     if (project->getSettings()->verboseOutput) {
         printCallStack();
     }
 
+    const LiftCheckpoint &checkpoint = proc->getLiftCheckpoint();
+    const int numHitsBefore          = checkpoint.getNumHits();
+    const int numMissesBefore        = checkpoint.getNumMisses();
+
     PassManager::get()->executePass(PassID::StatementInit, proc);
     project->alertDecompileDebugPoint(proc, "after lifting");
 
+    const int numReused = checkpoint.getNumHits() - numHitsBefore;
+    if (numReused > 0) {
+        m_numCheckpointRestarts++;
+        m_numReusedInsns += numReused;
+
+        LOG_VERBOSE("Lifted '%1' from checkpoint: %2 instructions reused, %3 instructions lifted",
+                    proc->getName(), numReused, checkpoint.getNumMisses() - numMissesBefore);
+    }
+
     proc->numberStatements();
 
     earlyDecompile(proc);
@@ -136,6 +157,10 @@ ProcStatus ProcDecompiler::tryDecompileRecursive(UserProc *proc)
         lateDecompile(proc); // Do the whole works
         proc->setStatus(ProcStatus::FinalDone);
         project->alertEndDecompile(proc);
+
+        if (m_finalizer) {
+            m_finalizer->procDecompiled(proc);
+        }
     }
     else if (m_recursionGroups.find(proc) != m_recursionGroups.end()) {
         // This proc's callees, and hence this proc, is/are involved in recursion.
@@ -151,12 +176,19 @@ ProcStatus ProcDecompiler::tryDecompileRecursive(UserProc *proc)
             recursionGroupAnalysis(proc->getRecursionGroup());
             proc->setStatus(ProcStatus::FinalDone);
             project->alertEndDecompile(proc);
+
+            if (m_finalizer) {
+                for (UserProc *groupProc : *proc->getRecursionGroup()) {
+                    m_finalizer->procDecompiled(groupProc);
+                }
+            }
         }
     }
 
     // Remove last element (= this) from path
     assert(!m_callStack.empty());
     assert(m_callStack.back() == proc);
+    chargeBudget();
     m_callStack.pop_back();
 
     LOG_MSG("Finished decompile of '%1'", proc->getName());
@@ -251,16 +283,21 @@ void ProcDecompiler::earlyDecompile(UserProc *proc)
     Project *project = proc->getProg()->getProject();
     project->alertStartDecompile(proc);
     project->alertDecompileDebugPoint(proc, "before earlyDecompile");
+    proc->clearProofCache();
 
     // Remove branches with false guards
     PassManager::get()->executePass(PassID::FragSimplify, proc);
     PassManager::get()->executePass(PassID::Dominators, proc);
 
-    if (proc->getStatus() < ProcStatus::MiddleDone) {
+    // Lifting alone may already exhaust the budget of a huge procedure. In that case, skip the
+    // remaining early passes; middleDecompile() will only rename the locations.
+    if (proc->getStatus() < ProcStatus::MiddleDone && !isOverBudget(proc)) {
         // Update the defines in the calls. Will redo if involved in recursion
         PassManager::get()->executePass(PassID::CallDefineUpdate, proc);
         PassManager::get()->executePass(PassID::GlobalConstReplace, proc);
+    }
 
+    if (proc->getStatus() < ProcStatus::MiddleDone && !isOverBudget(proc)) {
         // First placement of phi functions, renaming, and initial propagation.
         // This is mostly for the stack pointer.
         // TODO: Check if this makes sense. It seems to me that we only want to do one pass of
@@ -283,6 +320,15 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
     Project *project = proc->getProg()->getProject();
 
     project->alertDecompileDebugPoint(proc, "before middleDecompile");
+    proc->clearProofCache();
+
+    if (isQuickTier(proc) || isOverBudget(proc)) {
+        // Only make sure all locations are renamed so that code can be generated
+        renameMemofs(proc);
+        proc->setStatus(ProcStatus::MiddleDone);
+        project->alertDecompileDebugPoint(proc, "after middleDecompile");
+        return;
+    }
 
     // The call bypass logic should be staged as well. For example, consider m[r1{11}]{11} where 11
     // is a call. The first stage bypass yields m[r1{2}]{11}, which needs another round of
@@ -305,6 +351,12 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
 
     project->alertDecompileDebugPoint(proc, "after preservation, bypass and propagation");
 
+    if (isOverBudget(proc)) {
+        renameMemofs(proc);
+        proc->setStatus(ProcStatus::MiddleDone);
+        return;
+    }
+
     if (project->getSettings()->usePromotion) {
         // We want functions other than main to be promoted. Needed before mapExpressionsToLocals
         proc->promoteSignature();
@@ -381,26 +433,17 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
         PassManager::get()->executePass(PassID::AssignRemoval, proc);
         project->alertDecompileDebugPoint(proc,
                                           "after updating returns pass " + QString::number(pass));
-    } while (change && ++pass < 12);
+    } while (change && ++pass < 12 && !isOverBudget(proc));
 
-    // At this point, there will be some memofs that have still not been renamed. They have been
-    // prevented from getting renamed so that they didn't get renamed incorrectly (usually as {-}),
-    // when propagation and/or bypassing may have ended up changing the address expression. There is
-    // now no chance that this will happen, so we need to rename the existing memofs. Note that this
-    // can still link uses to definitions, e.g. 50 r26 := phi(...) 51 m[r26{50}] := 99;
-    //    ... := m[r26{50}]{should be 51}
+    renameMemofs(proc);
 
-    project->alertDecompileDebugPoint(proc, "before renaming memofs");
-    proc->getDataFlow()->setRenameLocalsParams(true);
-
-    PassManager::get()->executePass(PassID::PhiPlacement, proc);
-    PassManager::get()->executePass(PassID::BlockVarRename, proc);
-    PassManager::get()->executePass(PassID::StatementPropagation, proc);
-
-    // Now that memofs are renamed, the bypassing for memofs can work
-    PassManager::get()->executePass(PassID::CallAndPhiFix, proc);
-
-    project->alertDecompileDebugPoint(proc, "after renaming memofs");
+    if (isOverBudget(proc)) {
+        // Do not analyze indirect jumps; decoding them would require
+        // to decompile the procedure again.
+        proc->setStatus(ProcStatus::MiddleDone);
+        project->alertDecompileDebugPoint(proc, "after middleDecompile");
+        return;
+    }
 
     // Check for indirect jumps or calls not already removed by propagation of constants
     bool changed = false;
@@ -446,12 +489,38 @@ void ProcDecompiler::middleDecompile(UserProc *proc)
 }
 
 
+void ProcDecompiler::renameMemofs(UserProc *proc)
+{
+    Project *project = proc->getProg()->getProject();
+
+    // At this point, there will be some memofs that have still not been renamed. They have been
+    // prevented from getting renamed so that they didn't get renamed incorrectly (usually as {-}),
+    // when propagation and/or bypassing may have ended up changing the address expression. There is
+    // now no chance that this will happen, so we need to rename the existing memofs. Note that this
+    // can still link uses to definitions, e.g. 50 r26 := phi(...) 51 m[r26{50}] := 99;
+    //    ... := m[r26{50}]{should be 51}
+
+    project->alertDecompileDebugPoint(proc, "before renaming memofs");
+    proc->getDataFlow()->setRenameLocalsParams(true);
+
+    PassManager::get()->executePass(PassID::PhiPlacement, proc);
+    PassManager::get()->executePass(PassID::BlockVarRename, proc);
+    PassManager::get()->executePass(PassID::StatementPropagation, proc);
+
+    // Now that memofs are renamed, the bypassing for memofs can work
+    PassManager::get()->executePass(PassID::CallAndPhiFix, proc);
+
+    project->alertDecompileDebugPoint(proc, "after renaming memofs");
+}
+
+
 bool ProcDecompiler::decompileProcInRecursionGroup(UserProc *proc, ProcSet &visited)
 {
     bool changed     = false;
     Project *project = proc->getProg()->getProject();
 
     visited.insert(proc);
+    chargeBudget();
     m_callStack.push_back(proc);
 
     for (Function *c : proc->getCallees()) {
@@ -493,6 +562,7 @@ bool ProcDecompiler::decompileProcInRecursionGroup(UserProc *proc, ProcSet &visi
     changed |= PassManager::get()->executePass(PassID::StatementPropagation, proc);
 
     assert(m_callStack.back() == proc);
+    chargeBudget();
     m_callStack.pop_back();
     return changed;
 }
@@ -523,17 +593,23 @@ void ProcDecompiler::recursionGroupAnalysis(const std::shared_ptr<ProcSet> &grou
         LOG_MSG("    %1", proc->getName());
     }
 
-    UserProc *entry = *group->begin();
-    bool changed    = false;
-    int numRepeats  = 0;
+    // The group is about to be re-analysed; summaries of its members are not valid any more
+    for (UserProc *proc : *group) {
+        proc->invalidateCallSummary();
+    }
+
+    UserProc *entry  = *group->begin();
+    bool changed     = false;
+    int numRepeats   = 0;
+    const bool quick = m_tier == DecompileTier::Quick;
 
     do {
         ProcSet visited;
         changed = decompileProcInRecursionGroup(entry, visited);
-    } while (changed && numRepeats++ < 2);
+    } while (changed && !quick && numRepeats++ < 2);
 
     // while no change
-    for (int i = 0; i < 2; i++) {
+    for (int i = 0; i < (quick ? 1 : 2); i++) {
         for (UserProc *proc : *group) {
             lateDecompile(proc); // Also does final parameters and arguments at present
         }
@@ -551,6 +627,7 @@ void ProcDecompiler::lateDecompile(UserProc *proc)
     Project *project = proc->getProg()->getProject();
     project->alertDecompiling(proc);
     project->alertDecompileDebugPoint(proc, "before lateDecompile");
+    proc->clearProofCache();
 
     PassManager::get()->executePass(PassID::UnusedStatementRemoval, proc);
     PassManager::get()->executePass(PassID::FinalParameterSearch, proc);
@@ -583,8 +660,10 @@ ProcStatus ProcDecompiler::reDecompileRecursive(UserProc *proc)
 
     LOG_MSG("Restarting decompilation of '%1'", proc->getName());
     project->alertDecompileDebugPoint(proc, "before restarting decompilation");
+    m_numRestarts++;
 
-    // decode from scratch
+    // Lift again, using the lift checkpoint for all instructions lifted so far.
+    // All data flow information is invalid since it was computed on an incomplete CFG.
     proc->removeRetStmt();
     proc->getCFG()->clear();
 
@@ -593,8 +672,10 @@ ProcStatus ProcDecompiler::reDecompileRecursive(UserProc *proc)
 
     assert(m_callStack.back() == proc);
 
+    chargeBudget();
     m_callStack.pop_back();                          // Remove self from call stack
     ProcStatus status = tryDecompileRecursive(proc); // Restart decompiling this proc
+    chargeBudget();
     m_callStack.push_back(proc);                     // Restore self to call stack
 
     return status;
@@ -735,3 +816,65 @@ ProcStatus ProcDecompiler::decompileCallee(UserProc *callee, UserProc *proc)
 
     return proc->getStatus();
 }
+
+
+void ProcDecompiler::chargeBudget()
+{
+    const ProcBudget::Clock::time_point now = ProcBudget::Clock::now();
+    const uint64 numPasses                  = PassManager::get()->getNumExecutedPasses();
+
+    if (!m_callStack.empty()) {
+        getBudget(m_callStack.back())
+            .addUsage(now - m_lastCharge, numPasses - m_lastChargedPasses);
+    }
+
+    m_lastCharge        = now;
+    m_lastChargedPasses = numPasses;
+}
+
+
+bool ProcDecompiler::isOverBudget(UserProc *proc)
+{
+    if (proc->isAnalysisIncomplete()) {
+        return true;
+    }
+
+    chargeBudget();
+
+    const QString reason = getBudget(proc).checkLimits(proc, ProcBudget::Clock::now());
+    if (reason.isEmpty()) {
+        return false;
+    }
+
+    LOG_WARN("Stopping analysis of '%1' early: %2", proc->getName(), reason);
+    proc->setAnalysisIncomplete(reason);
+    m_numOverBudget++;
+    return true;
+}
+
+
+bool ProcDecompiler::isQuickTier(UserProc *proc)
+{
+    if (m_tier != DecompileTier::Quick) {
+        return false;
+    }
+
+    if (!proc->isAnalysisIncomplete()) {
+        proc->setAnalysisIncomplete("quick decompilation (tier 0), refine for full analysis");
+    }
+
+    return true;
+}
+
+
+ProcBudget &ProcDecompiler::getBudget(UserProc *proc)
+{
+    auto it = m_budgets.find(proc);
+
+    if (it == m_budgets.end()) {
+        const Settings *settings = proc->getProg()->getProject()->getSettings();
+        it = m_budgets.emplace(proc, ProcBudget(settings, m_deadline)).first;
+    }
+
+    return it->second;
+}
@@ -11,22 +11,48 @@
 
 
 #include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/core/Settings.h"
 #include "boomerang/db/proc/UserProc.h"
+#include "boomerang/decomp/ProcBudget.h"
 
 #include <unordered_map>
 
 
+class ProcFinalizer;
+
+
 /**
  * Contains the algorithm that determines how and in which order UserProcs are decompiled.
  */
 class BOOMERANG_API ProcDecompiler
 {
 public:
-    ProcDecompiler();
+    /// \param finalizer If not null, decompiled procedures are reported to \p finalizer
+    /// (streaming decompilation).
+    /// \param deadline After this point in time, all procedures are considered to have
+    /// exceeded their budget.
+    /// \param tier How thoroughly procedures are analysed.
+    ProcDecompiler(ProcFinalizer *finalizer                = nullptr,
+                   ProcBudget::Clock::time_point deadline = ProcBudget::Clock::time_point::max(),
+                   DecompileTier tier                     = DecompileTier::Full);
 
 public:
     void decompileRecursive(UserProc *proc);
 
+    /// \returns the number of times the decompilation of a procedure had to be restarted
+    int getNumRestarts() const { return m_numRestarts; }
+
+    /// \returns the number of restarts that did not have to lift the procedure from scratch
+    /// because the lifted instructions were taken from the lift checkpoint of the procedure.
+    int getNumCheckpointRestarts() const { return m_numCheckpointRestarts; }
+
+    /// \returns the number of instructions taken from lift checkpoints instead of being lifted
+    int getNumReusedInsns() const { return m_numReusedInsns; }
+
+    /// \returns the number of procedures whose analysis was stopped early
+    /// because they exceeded their budget
+    int getNumOverBudget() const { return m_numOverBudget; }
+
 private:
     ProcStatus tryDecompileRecursive(UserProc *proc);
 
@@ -55,6 +81,9 @@ private:
     /// \returns true if any change
     bool decompileProcInRecursionGroup(UserProc *proc, ProcSet &visited);
 
+    /// Rename memofs after all other locations have been renamed (part of middleDecompile).
+    void renameMemofs(UserProc *proc);
+
     /// Remove unused statements etc.
     void lateDecompile(UserProc *proc);
 
@@ -63,6 +92,8 @@ private:
     /**
      * Re-decompile \p proc from scratch. The proc must be at the top of the call stack
      * (i.e. the one that is currently decompiled).
+     * Instructions that were lifted before are taken from the lift checkpoint of \p proc;
+     * only newly discovered instructions are lifted again.
      */
     ProcStatus reDecompileRecursive(UserProc *proc);
 
@@ -88,9 +119,36 @@ private:
      */
     Function *tryDecompileRecursive(Address entryAddr, Prog *prog, UserProc *caller);
 
+    /// Charge the time and the passes used since the last call
+    /// to the procedure on top of the call stack.
+    /// Must be called before every change of the call stack.
+    void chargeBudget();
+
+    /// \returns true if \p proc has exceeded its budget; the remaining optional analyses
+    /// of \p proc should be skipped then. The procedure is flagged as incompletely analysed.
+    bool isOverBudget(UserProc *proc);
+
+    ProcBudget &getBudget(UserProc *proc);
+
+    /// \returns true if only the analyses of DecompileTier::Quick are to be done.
+    /// \p proc is flagged as incompletely analysed then.
+    bool isQuickTier(UserProc *proc);
+
 private:
+    ProcFinalizer *m_finalizer = nullptr;
+    DecompileTier m_tier;
     ProcList m_callStack;
 
+    int m_numRestarts           = 0;
+    int m_numCheckpointRestarts = 0;
+    int m_numReusedInsns        = 0;
+    int m_numOverBudget         = 0;
+
+    ProcBudget::Clock::time_point m_deadline;
+    ProcBudget::Clock::time_point m_lastCharge; ///< When chargeBudget() was last called
+    uint64 m_lastChargedPasses = 0;             ///< Number of executed passes at that time
+    std::unordered_map<UserProc *, ProcBudget> m_budgets;
+
     /**
      * Pointer to a set of procedures involved in a recursion group.
      * The procedures in the ProcSet form a strongly connected component of the call graph.
@@ -0,0 +1,148 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProcFinalizer.h"
+
+#include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/decomp/CFGCompressor.h"
+#include "boomerang/passes/PassManager.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/ExpPattern.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/statements/CallStatement.h"
+#include "boomerang/util/log/Log.h"
+
+
+ProcFinalizer::ProcFinalizer(Prog *prog)
+    : m_prog(prog)
+{
+}
+
+
+void ProcFinalizer::procDecompiled(UserProc *proc)
+{
+    m_decompiled.insert(proc);
+
+    if (canFinalize(proc)) {
+        finalize(proc);
+    }
+
+    // proc might have been the last caller that was still being decompiled
+    for (Function *callee : proc->getCallees()) {
+        if (callee->isLib()) {
+            continue;
+        }
+
+        UserProc *userCallee = static_cast<UserProc *>(callee);
+
+        if (canFinalize(userCallee)) {
+            finalize(userCallee);
+        }
+    }
+}
+
+
+void ProcFinalizer::finalizeAll()
+{
+    for (const auto &module : m_prog->getModuleList()) {
+        for (Function *func : *module) {
+            if (func->isLib()) {
+                continue;
+            }
+
+            UserProc *proc = static_cast<UserProc *>(func);
+
+            if (proc->isDecoded() && !isFinalized(proc)) {
+                finalize(proc);
+            }
+        }
+    }
+}
+
+
+bool ProcFinalizer::isFinalized(const UserProc *proc) const
+{
+    return m_finalized.find(proc) != m_finalized.end();
+}
+
+
+void ProcFinalizer::findUsedGlobals(UserProc *proc, QSet<QString> &usedGlobals)
+{
+    // The procedure of a Location does not take part in comparisons,
+    // so the same pattern can be used for all procedures.
+    static const ExpPattern globalPattern(Location::get(opGlobal, Terminal::get(opWild), nullptr));
+
+    const bool debugUnused = proc->getProg()->getProject()->getSettings()->debugUnused;
+
+    // Search each statement in proc, excepting implicit assignments (their uses don't count,
+    // since they don't really exist in the program representation)
+    const StmtKindMask kinds = STMT_MASK_ALL & ~stmtKindMask(StmtType::ImpAssign);
+    std::list<SharedExp> found;
+
+    for (const SharedStmt &s : proc->getStatementView(kinds)) {
+        if (!s->searchAll(globalPattern, found)) {
+            continue;
+        }
+
+        if (debugUnused) {
+            LOG_VERBOSE("A global is used by stmt %1", s->getNumber());
+        }
+
+        for (const SharedExp &global : found) {
+            usedGlobals.insert(global->access<Const, 1>()->getStr());
+        }
+
+        found.clear();
+    }
+}
+
+
+bool ProcFinalizer::canFinalize(const UserProc *proc) const
+{
+    if (isFinalized(proc) || m_decompiled.find(proc) == m_decompiled.end()) {
+        return false;
+    }
+
+    // Callers that have not been lifted yet are not known here; they will only see
+    // the signature and the call summary of proc.
+    for (const std::shared_ptr<CallStatement> &call : proc->getCallers()) {
+        const UserProc *caller = call->getProc();
+
+        if (caller && caller != proc && m_decompiled.find(caller) == m_decompiled.end()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+
+void ProcFinalizer::finalize(UserProc *proc)
+{
+    LOG_VERBOSE("Finalizing procedure '%1'", proc->getName());
+    m_finalized.insert(proc);
+
+    // This is what the global passes of ProgDecompiler do for all procedures at once
+    PassManager::get()->executePass(PassID::LocalTypeAnalysis, proc);
+
+    m_prog->getProject()->alertDecompiling(proc);
+    proc->numberStatements();
+    PassManager::get()->executePass(PassID::FromSSAForm, proc);
+    CFGCompressor().compressCFG(proc->getCFG());
+
+    findUsedGlobals(proc, m_usedGlobals);
+    m_prog->getProject()->generateProcCode(proc);
+
+    proc->releaseIR();
+}
@@ -0,0 +1,68 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <QSet>
+#include <QString>
+
+#include <set>
+
+
+class Prog;
+class UserProc;
+
+
+/**
+ * Finalizes procedures during streaming decompilation (\sa Settings::streamDecompilation).
+ *
+ * As soon as a procedure and all its known callers are decompiled, the procedure
+ * is transformed out of SSA form, code is generated for it, and its IR is released.
+ * Only the signature, the return statement and the call summary of the procedure
+ * are kept, which is all that is needed to decompile callers discovered later.
+ * This way, the memory needed for decompilation is bounded by the procedures
+ * that are currently being decompiled, not by the size of the whole program.
+ */
+class BOOMERANG_API ProcFinalizer
+{
+public:
+    ProcFinalizer(Prog *prog);
+
+public:
+    /// Called when \p proc is decompiled, i.e. it reached ProcStatus::FinalDone
+    /// or its recursion group has been analysed.
+    /// Finalizes \p proc and its callees if all their callers are decompiled as well.
+    void procDecompiled(UserProc *proc);
+
+    /// Finalize all decoded procedures that have not been finalized yet.
+    void finalizeAll();
+
+    bool isFinalized(const UserProc *proc) const;
+    int getNumFinalized() const { return static_cast<int>(m_finalized.size()); }
+
+    /// \returns the names of the global variables used by all finalized procedures.
+    const QSet<QString> &getUsedGlobals() const { return m_usedGlobals; }
+
+    /// Search all statements of \p proc for uses of global variables
+    /// and add their names to \p usedGlobals.
+    static void findUsedGlobals(UserProc *proc, QSet<QString> &usedGlobals);
+
+private:
+    bool canFinalize(const UserProc *proc) const;
+    void finalize(UserProc *proc);
+
+private:
+    Prog *m_prog;
+    std::set<const UserProc *> m_decompiled;
+    std::set<const UserProc *> m_finalized;
+    QSet<QString> m_usedGlobals;
+};
@@ -11,20 +11,35 @@
 
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
+#include "boomerang/db/FormatStringCache.h"
 #include "boomerang/db/Global.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/module/Module.h"
 #include "boomerang/db/proc/UserProc.h"
+#include "boomerang/db/signature/Signature.h"
 #include "boomerang/decomp/CFGCompressor.h"
+#include "boomerang/decomp/ProcDecompiler.h"
+#include "boomerang/decomp/ProcFinalizer.h"
 #include "boomerang/decomp/UnusedReturnRemover.h"
 #include "boomerang/passes/PassManager.h"
 #include "boomerang/ssl/exp/Const.h"
 #include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/statements/CallStatement.h"
+#include "boomerang/util/ThreadPool.h"
 #include "boomerang/util/log/Log.h"
+#include "boomerang/visitor/expmodifier/ExpNormalizer.h"
 
 
 ProgDecompiler::ProgDecompiler(Prog *prog)
     : m_prog(prog)
+{
+    if (m_prog->getProject()->getSettings()->streamDecompilation) {
+        m_finalizer.reset(new ProcFinalizer(m_prog));
+    }
+}
+
+
+ProgDecompiler::~ProgDecompiler()
 {
 }
 
@@ -34,10 +49,14 @@ void ProgDecompiler::decompile()
     assert(!m_prog->getModuleList().empty());
     LOG_VERBOSE("%1 procedures", m_prog->getNumFunctions(false));
 
+    startDeadline();
+    const bool quick = m_prog->getProject()->getSettings()->decompileTier ==
+                       DecompileTier::Quick;
+
     // Start decompiling each entry point
     for (UserProc *up : m_prog->getEntryProcs()) {
         LOG_MSG("Decompiling entry point '%1'", up->getName());
-        up->decompileRecursive();
+        decompileRecursive(up);
     }
 
     // Just in case there are any Procs not in the call graph.
@@ -60,48 +79,157 @@ void ProgDecompiler::decompile()
                     if (proc->isDecompiled()) {
                         continue;
                     }
-                    proc->decompileRecursive();
+                    decompileRecursive(proc);
                     foundone = true;
                 }
             }
         }
     }
 
-    globalTypeAnalysis();
+    if (m_finalizer) {
+        finishStreaming();
+        return;
+    }
 
-    if (m_prog->getProject()->getSettings()->removeReturns) {
-        // Repeat until no change. Not 100% sure if needed.
-        while (removeUnusedParamsAndReturns()) {
-            for (auto &module : m_prog->getModuleList()) {
-                for (Function *proc : *module) {
-                    if (proc->isLib()) {
-                        continue;
-                    }
+    globalTypeAnalysis();
 
-                    PassManager::get()->executePass(PassID::BranchAnalysis,
-                                                    static_cast<UserProc *>(proc));
-                }
-            }
-        }
+    if (m_prog->getProject()->getSettings()->removeReturns && !quick) {
+        removeUnusedParamsAndReturns();
     }
 
-    globalTypeAnalysis();
+    if (!quick) {
+        globalTypeAnalysis();
+    }
 
     // Now it is OK to transform out of SSA form
     fromSSAForm();
     removeUnusedGlobals();
+    compressCFGs();
 
-    LOG_MSG("Compressing CFG...");
+    LOG_MSG("Decompilation finished.");
+    if (quick) {
+        LOG_MSG("Only quick analyses were done; use 'refine' for a full analysis of procedures.");
+    }
 
-    for (const auto &module : m_prog->getModuleList()) {
-        for (Function *func : *module) {
-            if (!func->isLib()) {
-                CFGCompressor().compressCFG(static_cast<UserProc *>(func)->getCFG());
-            }
+    logSimplificationStatistics();
+    logRestartStatistics();
+    logBudgetStatistics();
+    LOG_VERBOSE("%1 signatures in use", Signature::getNumLive());
+    LOG_VERBOSE("%1 format strings parsed, %2 reused",
+                m_prog->getFormatStringCache().getNumParsed(),
+                m_prog->getFormatStringCache().getNumHits());
+}
+
+
+void ProgDecompiler::refineProc(UserProc *proc)
+{
+    LOG_MSG("Refining procedure '%1'", proc->getName());
+    startDeadline();
+
+    proc->resetAnalysis();
+
+    ProcDecompiler decompiler(nullptr, m_deadline, DecompileTier::Full);
+    decompiler.decompileRecursive(proc);
+
+    m_numRestarts += decompiler.getNumRestarts();
+    m_numCheckpointRestarts += decompiler.getNumCheckpointRestarts();
+    m_numReusedInsns += decompiler.getNumReusedInsns();
+    m_numOverBudget += decompiler.getNumOverBudget();
+
+    // Callers still refer to the return statement before refinement
+    for (const std::shared_ptr<CallStatement> &caller : proc->getCallers()) {
+        caller->setCalleeReturn(proc->getRetStmt());
+    }
+
+    PassManager::get()->executePass(PassID::LocalTypeAnalysis, proc);
+
+    m_prog->getProject()->alertDecompiling(proc);
+    proc->numberStatements();
+    PassManager::get()->executePass(PassID::FromSSAForm, proc);
+    CFGCompressor().compressCFG(proc->getCFG());
+
+    LOG_MSG("Finished refining '%1'", proc->getName());
+    logRestartStatistics();
+    logBudgetStatistics();
+}
+
+
+void ProgDecompiler::startDeadline()
+{
+    const int timeLimit = m_prog->getProject()->getSettings()->decompileTimeLimit;
+    if (timeLimit > 0) {
+        m_deadline = ProcBudget::Clock::now() + std::chrono::seconds(timeLimit);
+    }
+}
+
+
+void ProgDecompiler::decompileRecursive(UserProc *proc)
+{
+    ProcDecompiler decompiler(m_finalizer.get(), m_deadline,
+                              m_prog->getProject()->getSettings()->decompileTier);
+    decompiler.decompileRecursive(proc);
+
+    m_numRestarts += decompiler.getNumRestarts();
+    m_numCheckpointRestarts += decompiler.getNumCheckpointRestarts();
+    m_numReusedInsns += decompiler.getNumReusedInsns();
+    m_numOverBudget += decompiler.getNumOverBudget();
+}
+
+
+void ProgDecompiler::finishStreaming()
+{
+    // Most procedures have been finalized during decompilation already.
+    // The IR of finalized procedures is gone, so global analyses like the removal
+    // of unused parameters and returns cannot be done in streaming mode.
+    m_finalizer->finalizeAll();
+
+    LOG_MSG("Removing unused global variables...");
+    keepUsedGlobals(m_finalizer->getUsedGlobals());
+    m_prog->getProject()->generateGlobalsCode();
+
+    LOG_MSG("Decompilation finished, code for %1 procedures generated.",
+            m_finalizer->getNumFinalized());
+    logSimplificationStatistics();
+    logRestartStatistics();
+    logBudgetStatistics();
+}
+
+
+void ProgDecompiler::logSimplificationStatistics()
+{
+    LOG_VERBOSE("Simplification: %1 rule checks, %2 normalized subexpressions skipped",
+                ExpNormalizer::getNumRuleChecks(), ExpNormalizer::getNumSkipped());
+
+    for (int oper = opInvalid; oper <= opFLF; oper++) {
+        const uint64 hits = ExpNormalizer::getNumRuleHits(static_cast<OPER>(oper));
+        if (hits > 0) {
+            LOG_VERBOSE("    %1: %2 rewrites", operToString(static_cast<OPER>(oper)), hits);
         }
     }
+}
+
+
+void ProgDecompiler::logRestartStatistics()
+{
+    if (m_numRestarts == 0) {
+        return;
+    }
 
-    LOG_MSG("Decompilation finished.");
+    LOG_MSG("Restarted decompilation %1 times, avoided %2 full re-lifts "
+            "(%3 instructions reused from lift checkpoints)",
+            m_numRestarts, m_numCheckpointRestarts, m_numReusedInsns);
+}
+
+
+void ProgDecompiler::logBudgetStatistics()
+{
+    if (m_numOverBudget == 0) {
+        return;
+    }
+
+    LOG_WARN("Analysis of %1 procedures was stopped early because they exceeded their budget; "
+             "they are marked in the generated code",
+             m_numOverBudget);
 }
 
 
@@ -138,70 +266,87 @@ void ProgDecompiler::removeUnusedGlobals()
 {
     LOG_MSG("Removing unused global variables...");
 
-    // seach for used globals
-    std::list<SharedExp> usedGlobals;
-
-    for (const auto &module : m_prog->getModuleList()) {
-        for (Function *func : *module) {
-            if (func->isLib()) {
-                continue;
-            }
-
-            UserProc *proc = static_cast<UserProc *>(func);
-            Location search(opGlobal, Terminal::get(opWild), proc);
-            // Search each statement in u, excepting implicit assignments (their uses don't count,
-            // since they don't really exist in the program representation)
-            StatementList stmts;
-            StatementList::iterator ss;
-            proc->getStatements(stmts);
-
-            for (SharedStmt s : stmts) {
-                if (s->isImplicit()) {
-                    continue; // Ignore the uses in ImplicitAssigns
-                }
+    // seach for used globals; every procedure gets its own set to avoid locking
+    const std::vector<UserProc *> procs = getUserProcs();
+    std::vector<QSet<QString>> usedByProc(procs.size());
 
-                bool found = s->searchAll(search, usedGlobals);
+    getThreadPool().forEach(procs.size(), [&procs, &usedByProc](std::size_t i) {
+        ProcFinalizer::findUsedGlobals(procs[i], usedByProc[i]);
+    });
 
-                if (found && m_prog->getProject()->getSettings()->debugUnused) {
-                    LOG_VERBOSE("A global is used by stmt %1", s->getNumber());
-                }
-            }
-        }
+    QSet<QString> usedGlobals;
+    for (const QSet<QString> &used : usedByProc) {
+        usedGlobals.unite(used);
     }
 
-    // make a map to find a global by its name (could be a global var too)
-    QMap<QString, std::shared_ptr<Global>> namedGlobals;
+    keepUsedGlobals(usedGlobals);
+}
+
 
-    for (auto &g : m_prog->getGlobals()) {
-        namedGlobals[g->getName()] = g;
-    }
+void ProgDecompiler::keepUsedGlobals(const QSet<QString> &usedGlobals)
+{
+    const bool debugUnused = m_prog->getProject()->getSettings()->debugUnused;
 
-    // Rebuild the globals vector. Delete the unused globals only after re-inserting them
+    // Rebuild the globals set. Delete the unused globals only after re-inserting them
     Prog::GlobalSet oldGlobals = m_prog->getGlobals();
     m_prog->getGlobals().clear();
 
-    for (const SharedExp &e : usedGlobals) {
-        if (m_prog->getProject()->getSettings()->debugUnused) {
-            LOG_MSG(" %1 is used", e);
-        }
-
-        QString name(e->access<Const, 1>()->getStr());
-        auto &usedGlobal = namedGlobals[name];
+    int numKept = 0;
+    for (const std::shared_ptr<Global> &global : oldGlobals) {
+        if (usedGlobals.contains(global->getName())) {
+            if (debugUnused) {
+                LOG_MSG(" %1 is used", global->getName());
+            }
 
-        if (usedGlobal) {
-            m_prog->getGlobals().insert(usedGlobal);
-        }
-        else {
-            LOG_WARN("An expression refers to a nonexistent global");
+            m_prog->getGlobals().insert(global);
+            numKept++;
         }
     }
+
+    if (numKept < usedGlobals.size()) {
+        LOG_WARN("%1 expressions refer to nonexistent globals", usedGlobals.size() - numKept);
+    }
 }
 
 
 bool ProgDecompiler::removeUnusedParamsAndReturns()
 {
     LOG_MSG("Removing unused returns...");
-    return UnusedReturnRemover(m_prog).removeUnusedReturns();
+
+    UnusedReturnRemover remover(m_prog);
+    remover.scheduleAll();
+
+    bool change = false;
+
+    // Repeat until no change. Not 100% sure if needed.
+    for (int round = 1;; round++) {
+        const bool roundChange                  = remover.removeUnusedReturns();
+        const UnusedReturnRemover::Stats &stats = remover.getStats();
+
+        LOG_VERBOSE("Unused return removal round %1: %2 procedures processed, %3 changed, "
+                    "%4 requeued",
+                    round, stats.numProcessed, stats.numChanged, stats.numRequeued);
+
+        // Requeues by scheduleWithNeighbours() below are counted for the next round
+        remover.resetStats();
+
+        if (!roundChange) {
+            break;
+        }
+
+        change = true;
+
+        // Removing parameters and returns might make more branches analysable,
+        // but only in procedures that were changed. If branch analysis changes a procedure,
+        // its callers and callees have to be looked at again.
+        for (UserProc *proc : remover.getChangedProcs()) {
+            if (PassManager::get()->executePass(PassID::BranchAnalysis, proc)) {
+                remover.scheduleWithNeighbours(proc);
+            }
+        }
+    }
+
+    return change;
 }
 
 
@@ -209,15 +354,52 @@ void ProgDecompiler::fromSSAForm()
 {
     LOG_MSG("Transforming from SSA form...");
 
+    const std::vector<UserProc *> procs = getUserProcs();
+
+    // Watchers are not thread safe, so notify them before starting the workers
+    for (UserProc *proc : procs) {
+        m_prog->getProject()->alertDecompiling(proc);
+        proc->numberStatements();
+    }
+
+    PassManager::get()->executePassParallel(PassID::FromSSAForm, procs, getThreadPool());
+}
+
+
+void ProgDecompiler::compressCFGs()
+{
+    LOG_MSG("Compressing CFG...");
+
+    const std::vector<UserProc *> procs = getUserProcs();
+
+    getThreadPool().forEach(procs.size(), [&procs](std::size_t i) {
+        CFGCompressor().compressCFG(procs[i]->getCFG());
+    });
+}
+
+
+std::vector<UserProc *> ProgDecompiler::getUserProcs() const
+{
+    std::vector<UserProc *> procs;
+
     for (const auto &module : m_prog->getModuleList()) {
-        for (Function *pp : *module) {
-            if (pp->isLib()) {
-                continue;
+        for (Function *func : *module) {
+            if (!func->isLib()) {
+                procs.push_back(static_cast<UserProc *>(func));
             }
-
-            UserProc *proc = static_cast<UserProc *>(pp);
-            proc->numberStatements();
-            PassManager::get()->executePass(PassID::FromSSAForm, proc);
         }
     }
+
+    return procs;
+}
+
+
+ThreadPool &ProgDecompiler::getThreadPool()
+{
+    if (!m_threadPool) {
+        m_threadPool.reset(new ThreadPool(m_prog->getProject()->getSettings()->numThreads));
+        LOG_VERBOSE("Using %1 threads for late analysis", m_threadPool->getNumThreads());
+    }
+
+    return *m_threadPool;
 }
@@ -11,21 +11,49 @@
 
 
 #include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/decomp/ProcBudget.h"
+
+#include <QSet>
+#include <QString>
+
+#include <memory>
+#include <vector>
 
 
 class Prog;
+class ProcFinalizer;
+class ThreadPool;
+class UserProc;
 
 
 class BOOMERANG_API ProgDecompiler
 {
 public:
     ProgDecompiler(Prog *prog);
+    ~ProgDecompiler();
 
 public:
     /// Do the main non-global decompilation steps
     void decompile();
 
+    /**
+     * Decompile \p proc again from scratch with all analyses (DecompileTier::Full),
+     * e.g. after a quick decompilation of the whole program.
+     * Callees of \p proc are not refined, and callers are not analysed again.
+     */
+    void refineProc(UserProc *proc);
+
 private:
+    /// Set the deadline for the decompilation from Settings::decompileTimeLimit.
+    void startDeadline();
+
+    /// Decompile \p proc and all its callees.
+    void decompileRecursive(UserProc *proc);
+
+    /// Finish streaming decompilation after all procedures have been decompiled.
+    /// Generates code for the remaining procedures and the used globals.
+    void finishStreaming();
+
     /// Do global type analysis.
     /// \note For now, it just does local type analysis for every procedure of the program.
     void globalTypeAnalysis();
@@ -33,6 +61,9 @@ private:
     /// As the name suggests, removes globals unused in the decompiled code.
     void removeUnusedGlobals();
 
+    /// Remove all globals of the program except the ones named in \p usedGlobals.
+    void keepUsedGlobals(const QSet<QString> &usedGlobals);
+
     /// Remove unused or redundant parameters and return values from the program.
     /// \returns true if any change
     bool removeUnusedParamsAndReturns();
@@ -41,6 +72,39 @@ private:
     /// Convert from SSA form
     void fromSSAForm();
 
+    /// Remove empty jumps, orphan fragments and fallthroughs from the CFGs of all procedures.
+    void compressCFGs();
+
+    /// \returns all user procedures of the program in module order.
+    std::vector<UserProc *> getUserProcs() const;
+
+    /// \returns the thread pool for the late per-procedure phases.
+    /// The late phases of different procedures are independent of each other.
+    ThreadPool &getThreadPool();
+
+    /// Log how often the expression simplification rules were applied.
+    void logSimplificationStatistics();
+
+    /// Log how often the decompilation of procedures had to be restarted.
+    void logRestartStatistics();
+
+    /// Log how many procedures exceeded their budget.
+    void logBudgetStatistics();
+
 private:
     Prog *m_prog;
+
+    /// Only set for streaming decompilation (\sa Settings::streamDecompilation)
+    std::unique_ptr<ProcFinalizer> m_finalizer;
+
+    /// Created on first use (\sa Settings::numThreads)
+    std::unique_ptr<ThreadPool> m_threadPool;
+
+    int m_numRestarts           = 0; ///< \sa ProcDecompiler::getNumRestarts
+    int m_numCheckpointRestarts = 0; ///< \sa ProcDecompiler::getNumCheckpointRestarts
+    int m_numReusedInsns        = 0; ///< \sa ProcDecompiler::getNumReusedInsns
+    int m_numOverBudget         = 0; ///< \sa ProcDecompiler::getNumOverBudget
+
+    /// \sa Settings::decompileTimeLimit
+    ProcBudget::Clock::time_point m_deadline = ProcBudget::Clock::time_point::max();
 };
@@ -23,66 +23,82 @@
 #include "boomerang/visitor/expmodifier/ImplicitConverter.h"
 
 
-bool compareUserProc(const UserProc *lhs, const UserProc *rhs)
-{
-    if (lhs && rhs) {
-        return lhs->getEntryAddress() < rhs->getEntryAddress();
-    }
-    else {
-        return lhs < rhs;
-    }
-}
-
-
 UnusedReturnRemover::UnusedReturnRemover(Prog *prog)
     : m_prog(prog)
 {
 }
 
 
-bool UnusedReturnRemover::removeUnusedReturns()
+void UnusedReturnRemover::scheduleAll()
 {
     for (const auto &module : m_prog->getModuleList()) {
         for (Function *proc : *module) {
             if (proc && !proc->isLib() && static_cast<UserProc *>(proc)->isDecoded()) {
-                m_removeRetSet.insert(static_cast<UserProc *>(proc));
+                schedule(static_cast<UserProc *>(proc));
             }
             // else e.g. use -sf file to just prototype the proc
         }
     }
+}
+
+
+void UnusedReturnRemover::scheduleWithNeighbours(UserProc *proc)
+{
+    requeue(proc);
+
+    for (const std::shared_ptr<CallStatement> &call : proc->getCallers()) {
+        requeue(call->getProc());
+    }
+
+    for (Function *callee : proc->getCallees()) {
+        if (!callee->isLib() && static_cast<UserProc *>(callee)->isDecoded()) {
+            requeue(static_cast<UserProc *>(callee));
+        }
+    }
+}
+
+
+bool UnusedReturnRemover::removeUnusedReturns()
+{
+    m_changedProcs.clear();
 
     bool change = false;
-    // The workset is processed in order of entry address. This is to provide a consistent
+    // The worklist is processed in order of entry address. This is to provide a consistent
     // deterministic order of processing. Note that sometimes changes propagate down the call tree
     // (no caller uses potential returns for child), and sometimes up the call tree
     // (removal of returns and/or dead code removes parameters, which affects all callers).
-    while (!m_removeRetSet.empty()) {
-        auto it = std::min_element(m_removeRetSet.begin(), m_removeRetSet.end(), compareUserProc);
-        assert(*it != nullptr);
-        const bool removedReturns = removeUnusedParamsAndReturns(*it);
+    while (!m_workList.empty()) {
+        UserProc *proc = m_workList.top();
+        m_workList.pop();
+        assert(proc != nullptr);
+
+        m_stats.numProcessed++;
+        const bool removedReturns = removeUnusedParamsAndReturns(proc);
 
         if (removedReturns) {
             // Removing returns changes the uses of the callee.
             // So we have to do type analyis to update the use information.
-            PassManager::get()->executePass(PassID::LocalTypeAnalysis, *it);
+            PassManager::get()->executePass(PassID::LocalTypeAnalysis, proc);
 
             // type analysis might propagate statements that could not be propagated before
-            PassManager::get()->executePass(PassID::UnusedStatementRemoval, *it);
+            PassManager::get()->executePass(PassID::UnusedStatementRemoval, proc);
+            m_changedProcs.insert(proc);
         }
         change |= removedReturns;
 
-        // Note: removing the currently processed item here should prevent
+        // Note: unscheduling the currently processed item only here should prevent
         // unnecessary reprocessing of self recursive procedures
-        m_removeRetSet.erase(it);
+        m_scheduled.erase(proc);
     }
 
+    m_stats.numChanged = static_cast<int>(m_changedProcs.size());
     return change;
 }
 
 
 bool UnusedReturnRemover::removeUnusedParamsAndReturns(UserProc *proc)
 {
-    assert(m_removeRetSet.find(proc) != m_removeRetSet.end());
+    assert(m_scheduled.find(proc) != m_scheduled.end());
 
     m_prog->getProject()->alertDecompiling(proc);
     m_prog->getProject()->alertDecompileDebugPoint(proc, "before removing unused returns");
@@ -169,11 +185,17 @@ bool UnusedReturnRemover::removeUnusedParamsAndReturns(UserProc *proc)
     ProcSet updateSet; // Set of procs to update
 
     if (removedParams || removedRets) {
+        // Defines and parameters of this proc have changed
+        proc->invalidateCallSummary();
+
         // Update the statements that call us
-        for (std::shared_ptr<CallStatement> call : proc->getCallers()) {
+        if (!proc->getCallers().empty()) {
             PassManager::get()->executePass(PassID::CallArgumentUpdate, proc);
-            updateSet.insert(call->getProc());      // Make sure we redo the dataflow
-            m_removeRetSet.insert(call->getProc()); // Also schedule caller proc for more analysis
+        }
+
+        for (std::shared_ptr<CallStatement> call : proc->getCallers()) {
+            updateSet.insert(call->getProc()); // Make sure we redo the dataflow
+            requeue(call->getProc());          // Also schedule caller proc for more analysis
         }
 
         // Now update myself
@@ -204,6 +226,8 @@ void UnusedReturnRemover::updateForUseChange(UserProc *proc)
         LOG_MSG("%%% updating dataflow:");
     }
 
+    m_changedProcs.insert(proc);
+
     // Save the old parameters and call liveness
     const size_t oldNumParameters = proc->getParameters().size();
     std::map<std::shared_ptr<CallStatement>, UseCollector> callLiveness;
@@ -224,6 +248,9 @@ void UnusedReturnRemover::updateForUseChange(UserProc *proc)
         callLiveness[c].makeCloneOf(*c->getUseCollector());
     }
 
+    // Uses have changed, so previously failed proofs might succeed now
+    proc->clearProofCache();
+
     // Have to redo dataflow to get the liveness at the calls correct
     PassManager::get()->executePass(PassID::CallLivenessRemoval, proc);
     PassManager::get()->executePass(PassID::BlockVarRename, proc);
@@ -260,6 +287,8 @@ void UnusedReturnRemover::updateForUseChange(UserProc *proc)
     PassManager::get()->executePass(PassID::UnusedParamRemoval, proc);
 
     if (proc->getParameters().size() != oldNumParameters) {
+        proc->invalidateCallSummary();
+
         if (m_prog->getProject()->getSettings()->debugUnused) {
             LOG_MSG("%%%  parameters changed for %1", proc->getName());
         }
@@ -268,8 +297,10 @@ void UnusedReturnRemover::updateForUseChange(UserProc *proc)
 
         for (std::shared_ptr<CallStatement> cc : callers) {
             cc->updateArguments();
+            m_changedProcs.insert(cc->getProc());
+
             // Schedule the callers for analysis
-            m_removeRetSet.insert(cc->getProc());
+            requeue(cc->getProc());
         }
     }
 
@@ -283,7 +314,7 @@ void UnusedReturnRemover::updateForUseChange(UserProc *proc)
                         call->getDestProc()->getName(), proc->getName());
             }
 
-            m_removeRetSet.insert(static_cast<UserProc *>(call->getDestProc()));
+            requeue(static_cast<UserProc *>(call->getDestProc()));
         }
     }
 }
@@ -325,9 +356,30 @@ bool UnusedReturnRemover::removeReturnsToMatchSignature(UserProc *proc)
     }
 
     if (removedRets) {
+        proc->invalidateCallSummary();
+
         // Still may have effects on calls or now unused statements
         updateForUseChange(proc);
     }
 
     return removedRets;
 }
+
+
+bool UnusedReturnRemover::schedule(UserProc *proc)
+{
+    if (!m_scheduled.insert(proc).second) {
+        return false;
+    }
+
+    m_workList.push(proc);
+    return true;
+}
+
+
+void UnusedReturnRemover::requeue(UserProc *proc)
+{
+    if (schedule(proc)) {
+        m_stats.numRequeued++;
+    }
+}
@@ -13,20 +13,46 @@
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/ssl/exp/ExpHelp.h"
 
+#include <queue>
 #include <set>
+#include <unordered_set>
+#include <vector>
 
 
 class Prog;
 
 
+/**
+ * Removes unused parameters and return values of all procedures of a program.
+ *
+ * Procedures to analyse are kept in a worklist ordered by entry address (for a deterministic
+ * order of processing). A procedure is only scheduled again if something it depends on
+ * has changed, i.e. the parameters of one of its callees or the liveness at one of its callers.
+ */
 class UnusedReturnRemover
 {
+public:
+    /// Statistics since the last call to resetStats()
+    struct Stats
+    {
+        int numProcessed = 0; ///< Number of procedures taken from the worklist
+        int numChanged   = 0; ///< Number of procedures modified by the last round
+        int numRequeued  = 0; ///< Number of procedures scheduled again due to changes of others
+    };
+
 public:
     explicit UnusedReturnRemover(Prog *prog);
 
 public:
+    /// Schedule all decoded user procedures of the program.
+    void scheduleAll();
+
+    /// Schedule \p proc, its callers and its user procedure callees,
+    /// e.g. after \p proc has been modified outside of the remover.
+    void scheduleWithNeighbours(UserProc *proc);
+
     /**
-     * Remove unused return locations.
+     * Remove unused return locations of all scheduled procedures.
      * This is the global removing of unused and redundant returns. The initial idea
      * is simple enough: remove some returns according to the formula:
      * returns(p) = modifieds(p) isect union(live at c) for all c calling p.
@@ -40,6 +66,12 @@ public:
      */
     bool removeUnusedReturns();
 
+    /// \returns the procedures modified by the last call to removeUnusedReturns()
+    const ProcSet &getChangedProcs() const { return m_changedProcs; }
+
+    const Stats &getStats() const { return m_stats; }
+    void resetStats() { m_stats = Stats(); }
+
 private:
     /**
      * Remove any returns that are not used by any callers
@@ -58,8 +90,8 @@ private:
      * all callers have to have their arguments trimmed, and a similar process has to be applied to
      * all those caller's removed arguments as is applied here to the removed returns.
      *
-     * The \a removeRetSet is the set of procedures to process with this logic; caller in Prog calls
-     * all elements in this set (only add procs to this set, never remove)
+     * Procedures affected by the changes are added to the worklist and processed
+     * with the same logic later.
      *
      * \returns true if any change
      */
@@ -84,7 +116,33 @@ private:
     /// \returns true if any change
     bool removeReturnsToMatchSignature(UserProc *proc);
 
+    /// Add \p proc to the worklist if it is not scheduled already.
+    /// \returns true if \p proc was added.
+    bool schedule(UserProc *proc);
+
+    /// Schedule \p proc again after a change of \p proc itself or one of its neighbours.
+    void requeue(UserProc *proc);
+
 private:
+    /// Orders the heap so that the procedure with the lowest entry address is on top.
+    struct LaterEntry
+    {
+        bool operator()(const UserProc *lhs, const UserProc *rhs) const
+        {
+            return lessUserProc()(rhs, lhs);
+        }
+    };
+
     Prog *m_prog;
-    ProcSet m_removeRetSet; ///< UserProcs that need their returns updated
+
+    /// UserProcs that need their returns updated
+    std::priority_queue<UserProc *, std::vector<UserProc *>, LaterEntry> m_workList;
+
+    /// All procs in the worklist, and the proc currently processed.
+    /// Procs are not scheduled twice, which also prevents unnecessary reprocessing
+    /// of self recursive procedures.
+    std::unordered_set<UserProc *> m_scheduled;
+
+    ProcSet m_changedProcs; ///< \sa getChangedProcs
+    Stats m_stats;
 };
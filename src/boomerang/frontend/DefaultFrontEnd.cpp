@@ -22,6 +22,7 @@
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/db/signature/Signature.h"
 #include "boomerang/decomp/IndirectJumpAnalyzer.h"
+#include "boomerang/frontend/JumpTableFinder.h"
 #include "boomerang/frontend/LiftedInstruction.h"
 #include "boomerang/ifc/IDecoder.h"
 #include "boomerang/ssl/RTL.h"
@@ -255,6 +256,7 @@ bool DefaultFrontEnd::disassembleProc(UserProc *proc, Address addr)
                 }
 
                 LOG_ERROR("Encountered invalid instruction");
+                m_program->getProject()->alertBadDecode(addr);
                 sequentialDecode = false;
                 break; // try next instruction in queue
             }
@@ -370,8 +372,22 @@ bool DefaultFrontEnd::disassembleProc(UserProc *proc, Address addr)
             case StmtType::Case: {
                 // We create the BB as a COMPJUMP type, then change to an NWAY if it turns out
                 // to be a switch stmt
-                cfg->createBB(BBType::CompJump, bbInsns);
-                sequentialDecode = false;
+                BasicBlock *currentBB = cfg->createBB(BBType::CompJump, bbInsns);
+                sequentialDecode      = false;
+
+                if (currentBB == nullptr) {
+                    break;
+                }
+
+                // Decode the arms of simple jump tables right away, so switch analysis
+                // only has to add the out edges. Edges are not added here since
+                // the number of cases is not known yet.
+                const SharedConstExp dest = s->as<CaseStatement>()->getDest();
+                for (Address target : JumpTableFinder(m_binaryFile).findTargets(dest)) {
+                    LOG_VERBOSE("Found jump table target %1 for computed jump at address %2",
+                                target, addr);
+                    m_targetQueue.pushAddress(cfg, target, currentBB);
+                }
             } break;
 
             case StmtType::Branch: {
@@ -559,6 +575,14 @@ bool DefaultFrontEnd::liftProc(UserProc *proc)
     m_firstFragment.clear();
     m_lastFragment.clear();
 
+    if (m_program->getProject()->getSettings()->insnRetention == InsnRetention::AfterLift) {
+        for (IRFragment *frag : *proc->getCFG()) {
+            if (frag->getBB()) {
+                frag->getBB()->releaseInsns();
+            }
+        }
+    }
+
     return ok;
 }
 
@@ -784,15 +808,25 @@ bool DefaultFrontEnd::liftBB(BasicBlock *currentBB, UserProc *proc,
         return false;
     }
 
-    ProcCFG *procCFG = proc->getCFG();
+    ProcCFG *procCFG           = proc->getCFG();
+    LiftCheckpoint &checkpoint = proc->getLiftCheckpoint();
 
     for (const MachineInstruction &insn : currentBB->getInsns()) {
         LiftedInstruction lifted;
-        if (!m_decoder->liftInstruction(insn, lifted)) {
+        std::unique_ptr<RTL> checkpointRTL = checkpoint.findRTL(insn.m_addr);
+
+        if (checkpointRTL) {
+            // lifted before the decompilation of proc was restarted
+            lifted.addPart(std::move(checkpointRTL));
+        }
+        else if (!m_decoder->liftInstruction(insn, lifted)) {
             LOG_ERROR("Cannot lift instruction '%1 %2 %3'", insn.m_addr, insn.m_mnem.data(),
                       insn.m_opstr.data());
             return false;
         }
+        else if (lifted.isSimple()) {
+            checkpoint.addRTL(insn.m_addr, *lifted.getFirstRTL());
+        }
 
         if (!lifted.isSimple()) {
             // this is bsf/bsr/rep* etc.
@@ -1232,8 +1266,8 @@ void DefaultFrontEnd::preprocessProcGoto(RTL::StmtList::iterator ss, Address des
         // also need to change it in the actual RTL
         assert(std::next(ss) == sl.end());
         assert(!originalRTL->empty());
-        originalRTL->back() = call;
-        *ss                 = call;
+        originalRTL->replace(std::prev(originalRTL->end()), call);
+        *ss = call;
     }
 }
 
@@ -76,6 +76,9 @@ public:
     /// \note Derived classes should implement \ref liftProcImpl
     [[nodiscard]] bool liftProc(UserProc *proc) final override;
 
+    /// \copydoc IFrontEnd::disassembleInstruction
+    [[nodiscard]] bool disassembleInstruction(Address pc, MachineInstruction &insn) override;
+
     /// Disassemble and lift a single instruction at address \p addr
     /// \returns true on success
     [[nodiscard]] bool decodeInstruction(Address pc, MachineInstruction &insn,
@@ -117,10 +120,6 @@ protected:
     virtual bool isHelperFunc(Address dest, Address addr, RTLList &lrtl);
 
 protected:
-    /// Disassemble a single instruction at address \p pc
-    /// \returns true on success
-    bool disassembleInstruction(Address pc, MachineInstruction &insn);
-
     /// Lifts a single instruction \p insn to an RTL.
     /// \returns true on success
     bool liftInstruction(const MachineInstruction &insn, LiftedInstruction &lifted);
@@ -0,0 +1,135 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "JumpTableFinder.h"
+
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/db/binary/BinarySymbol.h"
+#include "boomerang/db/binary/BinarySymbolTable.h"
+#include "boomerang/ssl/exp/Const.h"
+
+#include <algorithm>
+
+
+JumpTableFinder::JumpTableFinder(const BinaryFile *binaryFile)
+    : m_binaryFile(binaryFile)
+{
+}
+
+
+Address JumpTableFinder::findTableAddr(const SharedConstExp &dest)
+{
+    // m[<expr> * 4 + T] or m[T + <expr> * 4]
+    if (!dest || !dest->isMemOf() || dest->getSubExp1()->getOper() != opPlus) {
+        return Address::INVALID;
+    }
+
+    SharedConstExp index = dest->getSubExp1()->getSubExp1();
+    SharedConstExp table = dest->getSubExp1()->getSubExp2();
+
+    if (index->isIntConst()) {
+        std::swap(index, table);
+    }
+
+    if (!table->isIntConst() || index->getOper() != opMult) {
+        return Address::INVALID;
+    }
+
+    const SharedConstExp scale = index->getSubExp2();
+    if (!scale->isIntConst() || scale->access<const Const>()->getInt() != 4) {
+        return Address::INVALID;
+    }
+
+    return table->access<const Const>()->getAddr();
+}
+
+
+std::vector<Address> JumpTableFinder::findTargets(const SharedConstExp &dest) const
+{
+    if (Address::getSourceBits() != 32) {
+        return {};
+    }
+
+    const Address tableAddr = findTableAddr(dest);
+    if (tableAddr == Address::INVALID) {
+        return {};
+    }
+
+    const BinaryImage *image       = m_binaryFile->getImage();
+    const BinarySection *tableSect = image->getSectionByAddr(tableAddr);
+
+    if (tableSect == nullptr) {
+        return {};
+    }
+
+    // In relocatable files, every entry of the table is relocated.
+    const bool checkRelocations = m_binaryFile->isRelocationAt(tableAddr);
+
+    // A table that has a symbol of its own does not extend past the next symbol
+    // in the same section.
+    Address symbolEnd = Address::INVALID;
+    if (m_binaryFile->getSymbols()->findSymbolByAddress(tableAddr) != nullptr) {
+        const BinarySymbol *nextSym = m_binaryFile->getSymbols()->findNextSymbol(tableAddr);
+        if (nextSym && image->getSectionByAddr(nextSym->getLocation()) == tableSect) {
+            symbolEnd = nextSym->getLocation();
+        }
+    }
+
+    // Tables embedded in code end before the first instruction after the table.
+    Address codeEnd = Address::INVALID;
+
+    int maxEntries = MAX_TABLE_ENTRIES;
+    if (symbolEnd != Address::INVALID && symbolEnd < tableAddr + 4 * MAX_TABLE_ENTRIES) {
+        maxEntries = static_cast<int>((symbolEnd - tableAddr).value() / 4);
+    }
+
+    const std::vector<Address> table = image->readNativeAddrs4(tableAddr, maxEntries);
+
+    std::vector<Address> targets;
+    targets.reserve(table.size());
+
+    for (int i = 0; i < static_cast<int>(table.size()); i++) {
+        const Address entryAddr = tableAddr + 4 * i;
+        const Address target    = table[i];
+
+        if ((codeEnd != Address::INVALID && entryAddr >= codeEnd) || !isCodeAddr(target)) {
+            break;
+        }
+        else if (checkRelocations && i > 0 && !m_binaryFile->isRelocationAt(entryAddr)) {
+            break;
+        }
+
+        if (tableSect->isCode() && target > tableAddr &&
+            (codeEnd == Address::INVALID || target < codeEnd)) {
+            codeEnd = target;
+        }
+
+        targets.push_back(target);
+    }
+
+    // Without any of these bounds, the end of the table cannot be told apart from
+    // adjacent tables or other pointers into code; leave it to IndirectJumpAnalyzer,
+    // which knows the number of cases.
+    if (!checkRelocations && symbolEnd == Address::INVALID && codeEnd == Address::INVALID) {
+        return {};
+    }
+
+    std::sort(targets.begin(), targets.end());
+    targets.erase(std::unique(targets.begin(), targets.end()), targets.end());
+    return targets;
+}
+
+
+bool JumpTableFinder::isCodeAddr(Address addr) const
+{
+    const BinarySection *sect = m_binaryFile->getImage()->getSectionByAddr(addr);
+    return sect != nullptr && sect->isCode();
+}
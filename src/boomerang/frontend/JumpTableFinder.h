@@ -0,0 +1,58 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/ssl/exp/ExpHelp.h"
+#include "boomerang/util/Address.h"
+
+#include <vector>
+
+
+class BinaryFile;
+
+
+/**
+ * Finds the targets of jump tables while a procedure is disassembled,
+ * before any data flow analysis has been done.
+ *
+ * Only tables addressed directly by the jump (form A, m[<expr> * 4 + T]) are recognized.
+ * The number of cases is not known at this point, so targets are only reported if the end
+ * of the table is bounded by relocations (every entry of a relocated table is relocated),
+ * by the next symbol in the same section if a symbol starts at the table,
+ * or by the first target after a table embedded in a code section. Reading also stops at the first entry that does not point to code.
+ * The targets found this way are only used to seed the decoder;
+ * the switch is still analyzed properly by IndirectJumpAnalyzer.
+ */
+class BOOMERANG_API JumpTableFinder
+{
+public:
+    /// Maximum number of table entries to read
+    static constexpr int MAX_TABLE_ENTRIES = 512;
+
+public:
+    JumpTableFinder(const BinaryFile *binaryFile);
+
+public:
+    /// \returns the native address of the table indexed by the jump destination \p dest,
+    /// or Address::INVALID if \p dest is not of form A.
+    static Address findTableAddr(const SharedConstExp &dest);
+
+    /// \returns the (deduplicated) targets of the jump table used by the computed jump
+    /// to \p dest, or an empty list if no table was found.
+    std::vector<Address> findTargets(const SharedConstExp &dest) const;
+
+private:
+    /// \returns true if \p addr is in a code section of the image.
+    bool isCodeAddr(Address addr) const;
+
+private:
+    const BinaryFile *m_binaryFile;
+};
@@ -21,6 +21,9 @@
 #include <vector>
 
 
+class TableEntry;
+
+
 constexpr const sint32 MNEM_SIZE  = 32;
 constexpr const sint32 OPSTR_SIZE = 160;
 
@@ -49,6 +52,9 @@ public:
     std::vector<SharedExp> m_operands;
     QString m_templateName; ///< Name of SSL IR template (e.g. REPSTOSB.rm8 or MOVSX.r32.rm8)
 
+    /// SSL IR template, if already looked up by the decoder
+    const TableEntry *m_templateEntry = nullptr;
+
 public:
     /// Enables or disables the membership in a certain group. Does not affect other groups.
     void setGroup(MIGroup groupID, bool enabled);
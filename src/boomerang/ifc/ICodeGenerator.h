@@ -46,4 +46,12 @@ public:
      */
     virtual void generateCode(const Prog *program, Module *module = nullptr,
                               UserProc *proc = nullptr, bool intermixRTL = false) = 0;
+
+    /**
+     * Generate definitions for all global variables of \p program.
+     * When generating code for a single procedure, the globals used by the procedure
+     * are only declared \c extern, so this must be called after code for all procedures
+     * has been generated procedure by procedure (\sa Settings::streamDecompilation).
+     */
+    virtual void generateGlobals(const Prog *program) = 0;
 };
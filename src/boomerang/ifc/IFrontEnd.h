@@ -17,6 +17,7 @@
 
 
 class IDecoder;
+class MachineInstruction;
 class Project;
 class UserProc;
 class QString;
@@ -60,6 +61,10 @@ public:
     /// \returns true on success, false on failure
     [[nodiscard]] virtual bool liftProc(UserProc *proc) = 0;
 
+    /// Disassemble a single instruction at address \p pc
+    /// \returns true on success
+    [[nodiscard]] virtual bool disassembleInstruction(Address pc, MachineInstruction &insn) = 0;
+
 public:
     /// \returns the address of "main", or Address::INVALID if not found
     virtual Address findMainEntryPoint(bool &gotMain) = 0;
@@ -11,6 +11,7 @@
 
 
 #include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/db/binary/BinaryFile.h"
 
 #include <memory>
 
@@ -35,10 +36,19 @@ public:
     /// \returns true on success.
     virtual bool readLibraryCatalog(const Prog *prog, const QString &fileName) = 0;
 
+    /// Parse the signature files of a catalog for \p machine without adding the signatures
+    /// to a program, so that later calls to \ref readLibraryCatalog can reuse them.
+    /// \returns true on success.
+    virtual bool preloadLibraryCatalog(Machine machine, const QString &fileName) = 0;
+
     /// Add symbol information from a symbol file to the program.
     /// \returns true on success.
     virtual bool addSymbolsFromSymbolFile(Prog *prog, const QString &fileName) = 0;
 
     /// \returns a library signature by its name
     virtual std::shared_ptr<Signature> getSignatureByName(const QString &functionName) const = 0;
+
+    /// Forget all library signatures read so far (e.g. before reading the catalogs
+    /// for a different program). Implementations may keep parsed files cached.
+    virtual void clearLibrarySignatures() = 0;
 };
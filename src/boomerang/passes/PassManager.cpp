@@ -38,9 +38,11 @@
 #include "boomerang/passes/middle/PreservationAnalysisPass.h"
 #include "boomerang/passes/middle/SPPreservationPass.h"
 #include "boomerang/passes/middle/StrengthReductionReversalPass.h"
+#include "boomerang/util/ThreadPool.h"
 #include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 
+#include <algorithm>
 #include <cassert>
 
 
@@ -109,13 +111,39 @@ bool PassManager::executePass(IPass *pass, UserProc *proc)
     LOG_VERBOSE("Executing pass '%1' for '%2'", pass->getName(), proc->getName());
 
     const bool change = pass->execute(proc);
+    passExecuted(pass, proc);
+
+    return change;
+}
+
+
+bool PassManager::executePassParallel(PassID passID, const std::vector<UserProc *> &procs,
+                                      ThreadPool &pool)
+{
+    IPass *pass = getPass(passID);
+    assert(pass != nullptr && pass->isProcLocal());
+    LOG_VERBOSE("Executing pass '%1' for %2 procedures", pass->getName(), procs.size());
+
+    std::vector<char> changes(procs.size(), false);
+    pool.forEach(procs.size(), [&](std::size_t i) { changes[i] = pass->execute(procs[i]); });
+
+    for (UserProc *proc : procs) {
+        passExecuted(pass, proc);
+    }
+
+    return std::find(changes.begin(), changes.end(), true) != changes.end();
+}
+
+
+void PassManager::passExecuted(IPass *pass, UserProc *proc)
+{
+    m_numExecutedPasses++;
+    proc->releaseOutdatedStatementIndex();
 
     if (Log::getOrCreateLog().getLogLevel() >= LogLevel::Verbose1) {
         const QString msg = QString("after executing pass '%1'").arg(pass->getName());
         proc->debugPrintAll(msg);
     }
-
-    return change;
 }
 
 
@@ -13,12 +13,16 @@
 #include "boomerang/core/BoomerangAPI.h"
 #include "boomerang/passes/Pass.h"
 
+#include "boomerang/util/Types.h"
+
 #include <QMap>
 
+#include <atomic>
 #include <memory>
 
 
 class Prog;
+class ThreadPool;
 
 
 class BOOMERANG_API PassManager
@@ -44,9 +48,22 @@ public:
     bool executePass(IPass *pass, UserProc *proc);
     bool executePass(PassID passID, UserProc *proc);
 
+    /// Execute a proc local pass on all of \p procs, using the threads of \p pool.
+    /// Debug output is written on the calling thread after all procs are done.
+    /// \returns true iff the pass updated any of \p procs
+    bool executePassParallel(PassID passID, const std::vector<UserProc *> &procs,
+                             ThreadPool &pool);
+
+    /// \returns the total number of passes executed so far
+    uint64 getNumExecutedPasses() const { return m_numExecutedPasses; }
+
 private:
     void registerPass(PassID passType, std::unique_ptr<IPass> pass);
 
+    /// Bookkeeping after \p pass was executed on \p proc
+    void passExecuted(IPass *pass, UserProc *proc);
+
 private:
     std::vector<std::unique_ptr<IPass>> m_passes;
+    std::atomic<uint64> m_numExecutedPasses{ 0 };
 };
@@ -12,6 +12,7 @@
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/CallEffectSummary.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/db/signature/Signature.h"
 #include "boomerang/ssl/statements/CallStatement.h"
@@ -29,16 +30,9 @@ CallDefineUpdatePass::CallDefineUpdatePass()
 
 bool CallDefineUpdatePass::execute(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
-
     bool changed = false;
 
-    for (SharedStmt s : stmts) {
-        if (!s->isCall()) {
-            continue;
-        }
-
+    for (const SharedStmt &s : proc->getStatementsOfKind(StmtType::Call)) {
         changed |= updateCallDefines(proc, s->as<CallStatement>());
     }
 
@@ -71,6 +65,13 @@ bool CallDefineUpdatePass::updateCallDefines(UserProc *proc,
     StatementList newDefines(callStmt->getDefines());
     callStmt->getDefines().clear();
 
+    // If the callee is final, its summary answers the "still defined by the callee?" queries below
+    std::shared_ptr<const CallEffectSummary> calleeSummary;
+    if (callee && callStmt->getCalleeReturn() &&
+        callStmt->getCalleeReturn() == static_cast<UserProc *>(callee)->getRetStmt()) {
+        calleeSummary = static_cast<UserProc *>(callee)->getCallSummary();
+    }
+
     if (callee && callStmt->getCalleeReturn()) {
         assert(!callee->isLib());
         const StatementList
@@ -112,7 +113,12 @@ bool CallDefineUpdatePass::updateCallDefines(UserProc *proc,
         std::shared_ptr<Assignment> as = stmt->as<Assignment>();
         SharedExp lhs                  = as->getLeft();
 
-        if (callStmt->getCalleeReturn()) {
+        if (calleeSummary) {
+            if (!calleeSummary->definesLoc(lhs)) {
+                continue; // Not in callee returns -> delete it
+            }
+        }
+        else if (callStmt->getCalleeReturn()) {
             if (!callStmt->getCalleeReturn()->definesLoc(lhs)) {
                 continue; // Not in callee returns -> delete it
             }
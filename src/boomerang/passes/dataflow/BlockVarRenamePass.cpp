@@ -18,23 +18,18 @@
 #include "boomerang/ssl/statements/CallStatement.h"
 #include "boomerang/ssl/statements/PhiAssign.h"
 #include "boomerang/ssl/statements/ReturnStatement.h"
-#include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ExpSubscripter.h"
 #include "boomerang/visitor/stmtmodifier/StmtSubscripter.h"
 
 
 static const SharedExp defineAll = Terminal::get(opDefineAll); // An expression representing <all>
 
-// There is an entry in stacks[defineAll] that represents the latest definition
+// There is an entry in m_stacks for defineAll that represents the latest definition
 // from a define-all source. It is needed for variables that don't have a definition as yet
-// (i.e. stacks[x].empty() is true). As soon as a real definition to x appears,
-// stacks[defineAll] does not apply for variable x. This is needed to get correct
+// (i.e. m_stacks.getTop(x) == nullptr). As soon as a real definition to x appears,
+// the defineAll entry does not apply for variable x. This is needed to get correct
 // operation of the use collectors in calls.
 
-// Care with the Stacks object (a map from expression to stack);
-// using Stacks[q].empty() can needlessly insert an empty stack
-#define STACKS_EMPTY(q) (stacks.find(q) == stacks.end() || stacks[q].empty())
-
 
 BlockVarRenamePass::BlockVarRenamePass()
     : IPass("BlockVarRename", PassID::BlockVarRename)
@@ -53,27 +48,74 @@ bool BlockVarRenamePass::execute(UserProc *proc)
     const FragIndex entryIdx = proc->getDataFlow()->fragToIdx(entryFrag);
     const bool changed       = renameBlockVars(proc, entryIdx);
 
-#ifndef NDEBUG
-    for (auto &[var, stack] : stacks) {
-        Q_UNUSED(var);
-        assert(stack.empty());
-    }
-#endif
-
-    stacks.clear();
+    assert(m_stacks.empty());
+    m_stacks.clear();
     return changed;
 }
 
 
-bool BlockVarRenamePass::renameBlockVars(UserProc *proc, std::size_t n)
+bool BlockVarRenamePass::renameBlockVars(UserProc *proc, FragIndex entryIdx)
 {
-    if (proc->getCFG()->getNumFragments() == 0) {
+    const std::size_t numFrags = proc->getCFG()->getNumFragments();
+    if (numFrags == 0) {
         return false;
     }
 
-    bool changed                   = false;
     const bool assumeABICompliance = proc->getProg()->getProject()->getSettings()->assumeABI;
 
+    // Children of each fragment in the dominator tree, in order of their index
+    std::vector<std::vector<FragIndex>> domChildren(numFrags);
+
+    for (FragIndex X = 0; X < numFrags; ++X) {
+        const FragIndex idom = proc->getDataFlow()->getIdom(X);
+        if (idom < numFrags && idom != X) { // if 'idom' is immediate dominator of X
+            domChildren[idom].push_back(X);
+        }
+    }
+
+    // Explicit stack instead of recursion; deeply nested dominator trees
+    // would overflow the call stack otherwise.
+    struct Visit
+    {
+        FragIndex frag;
+        std::size_t nextChild;
+        std::size_t stackHeight; ///< Height of m_stacks before the fragment was renamed
+    };
+
+    std::vector<Visit> toVisit;
+    bool changed = false;
+
+    toVisit.push_back({ entryIdx, 0, m_stacks.getHeight() });
+    changed |= renameFragment(proc, entryIdx, assumeABICompliance);
+
+    while (!toVisit.empty()) {
+        Visit &current = toVisit.back();
+
+        if (current.nextChild < domChildren[current.frag].size()) {
+            // For each child X of n
+            const FragIndex X = domChildren[current.frag][current.nextChild++];
+
+            // current is invalidated by the push
+            toVisit.push_back({ X, 0, m_stacks.getHeight() });
+            changed |= renameFragment(proc, X, assumeABICompliance);
+        }
+        else {
+            // All definitions of the fragment (including the definitions of childless calls)
+            // go out of scope at the same time, so there is no need to process
+            // the statements of the fragment again.
+            m_stacks.popTo(current.stackHeight);
+            toVisit.pop_back();
+        }
+    }
+
+    return changed;
+}
+
+
+bool BlockVarRenamePass::renameFragment(UserProc *proc, FragIndex n, bool assumeABICompliance)
+{
+    bool changed = false;
+
     // For each statement S in block n
     IRFragment::RTLIterator rit;
     StatementList::iterator sit;
@@ -113,7 +155,7 @@ bool BlockVarRenamePass::renameBlockVars(UserProc *proc, std::size_t n)
                 col = stmt->as<ReturnStatement>()->getCollector();
             }
 
-            col->updateDefs(stacks, proc);
+            col->updateDefs(m_stacks, proc);
         }
 
         pushDefinitions(stmt, assumeABICompliance);
@@ -138,39 +180,11 @@ bool BlockVarRenamePass::renameBlockVars(UserProc *proc, std::size_t n)
                 continue;
             }
 
-            SharedStmt def = nullptr; // assume No reaching definition
-
-            if (!STACKS_EMPTY(a)) {
-                def = stacks[a].top();
-            }
-
-            // "Replace jth operand with a_i"
-            pa->putAt(frag, def, a);
+            // "Replace jth operand with a_i" (nullptr if no reaching definition)
+            pa->putAt(frag, m_stacks.getTop(a), a);
         }
     }
 
-    // For each child X of n
-    // Note: linear search!
-    const std::size_t numFrags = proc->getCFG()->getNumFragments();
-
-    for (FragIndex X = 0; X < numFrags; ++X) {
-        const FragIndex idom = proc->getDataFlow()->getIdom(X);
-        if (idom == n && X != n) { // if 'n' is immediate dominator of X
-            renameBlockVars(proc, X);
-        }
-    }
-
-    // NOTE: Because of the need to pop childless calls from the Stacks, it is important in my
-    // algorithm to process the statments in the fragments *backwards*.
-    // (It is not important in Appel's algorithm, since he always pushes a definition
-    // for every variable defined on the Stacks).
-    IRFragment::RTLRIterator rrit;
-    StatementList::reverse_iterator srit;
-
-    for (SharedStmt S = frag->getLastStmt(rrit, srit); S; S = frag->getPrevStmt(rrit, srit)) {
-        popDefinitions(S, assumeABICompliance);
-    }
-
     return changed;
 }
 
@@ -233,13 +247,13 @@ bool BlockVarRenamePass::subscriptUsedLocations(SharedStmt stmt)
             continue; // Don't re-rename the renamed variable
         }
 
-        if (!STACKS_EMPTY(location)) {
-            def = stacks[location].top();
-        }
-        else if (!STACKS_EMPTY(defineAll)) {
-            def = stacks[defineAll].top();
+        def = m_stacks.getTop(location);
+
+        if (!def) {
+            def = m_stacks.getTop(defineAll);
         }
-        else {
+
+        if (!def) {
             // If the both stacks are empty, use a nullptr definition. This will be changed
             // into a pointer to an implicit definition at the start of type analysis, but
             // not until all the m[...] have stopped changing their expressions (complicates
@@ -285,16 +299,11 @@ void BlockVarRenamePass::pushDefinitions(SharedStmt stmt, bool assumeABIComplian
 
         if (suitable) {
             // Push i onto Stacks[a]
-            // Note: we clone a because otherwise it could be an expression
+            // Note: the stacks keep a clone of a, because otherwise it could be an expression
             // that gets deleted through various modifications.
             // This is necessary because we do several passes of this algorithm
             // to sort out the memory expressions.
-            if (stacks.find(a) != stacks.end()) { // expression exists, no need for clone ?
-                stacks[a].push(stmt);
-            }
-            else {
-                stacks[a->clone()].push(stmt);
-            }
+            m_stacks.push(a, stmt);
 
             // Replace definition of 'a' with definition of a_i in S (we don't do this)
         }
@@ -306,7 +315,7 @@ void BlockVarRenamePass::pushDefinitions(SharedStmt stmt, bool assumeABIComplian
 
             // Stacks already has a definition for a (as just the bare local)
             if (suitable) {
-                stacks[a1->clone()].push(stmt);
+                m_stacks.push(a1->clone(), stmt);
             }
         }
     }
@@ -316,45 +325,11 @@ void BlockVarRenamePass::pushDefinitions(SharedStmt stmt, bool assumeABIComplian
     if (stmt->isCall() && stmt->as<CallStatement>()->isChildless() &&
         !proc->getProg()->getProject()->getSettings()->assumeABI) {
         // S is a childless call (and we're not assuming ABI compliance)
-        stacks[defineAll]; // Ensure that there is an entry for defineAll
+        m_stacks.pushAll(stmt); // Add a definition for all vars
 
-        for (auto &elem : stacks) {
-            // if (dd->first->isMemDepth(memDepth))
-            elem.second.push(stmt); // Add a definition for all vars
+        if (m_stacks.findLoc(defineAll) == RenameStacks::NO_LOC) {
+            m_stacks.push(defineAll, stmt);
         }
     }
 }
 
-
-void BlockVarRenamePass::popDefinitions(SharedStmt stmt, bool assumeABICompliance)
-{
-    UserProc *proc = stmt->getProc();
-
-    // For each definition of some variable a in S
-    LocationSet defs;
-    stmt->getDefinitions(defs, assumeABICompliance);
-
-    for (const auto &def : defs) {
-        if (!proc->canRename(def)) {
-            continue;
-        }
-
-        auto stackIt = stacks.find(def);
-        if (stackIt == stacks.end() || stackIt->second.empty()) {
-            LOG_FATAL("Tried to pop '%1' from Stacks; does not exist", def);
-        }
-
-        stackIt->second.pop();
-    }
-
-    // Pop all defs due to childless calls
-    if (stmt->isCall() && stmt->as<CallStatement>()->isChildless()) {
-        for (auto &[var, lastDef] : stacks) {
-            Q_UNUSED(var);
-
-            if (!lastDef.empty() && (lastDef.top() == stmt)) {
-                lastDef.pop();
-            }
-        }
-    }
-}
@@ -10,12 +10,12 @@
 #pragma once
 
 
+#include "boomerang/db/DataFlow.h"
+#include "boomerang/db/RenameStacks.h"
 #include "boomerang/passes/Pass.h"
-#include "boomerang/ssl/exp/ExpHelp.h"
 #include "boomerang/ssl/statements/Statement.h"
 
-#include <map>
-#include <stack>
+#include <vector>
 
 
 /// Rewrites Statements in BasicBlocks into SSA form.
@@ -29,7 +29,13 @@ public:
     bool execute(UserProc *proc) override;
 
 private:
-    bool renameBlockVars(UserProc *proc, std::size_t n);
+    /// Rename the variables of all fragments dominated by \p entryIdx,
+    /// walking the dominator tree in pre-order.
+    bool renameBlockVars(UserProc *proc, FragIndex entryIdx);
+
+    /// Rename the variables in fragment \p n and the phis of its successors.
+    /// The definitions of \p n stay on the stacks until they are popped by the caller.
+    bool renameFragment(UserProc *proc, FragIndex n, bool assumeABI);
 
     /// For all expressions in \p stmt, replace \p var with var{varDef}
     void subscriptVar(const SharedStmt &stmt, SharedExp var, const SharedStmt &varDef);
@@ -39,10 +45,7 @@ private:
     /// push definitions in this statement onto the stacks
     void pushDefinitions(SharedStmt stmt, bool assumeABI);
 
-    /// pop definitions in this statement from the stacks
-    void popDefinitions(SharedStmt stmt, bool assumeABI);
-
 private:
     /// stores the last definition of a variable
-    std::map<SharedExp, std::stack<SharedStmt>, lessExpStar> stacks;
+    RenameStacks m_stacks;
 };
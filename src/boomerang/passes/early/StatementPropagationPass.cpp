@@ -29,14 +29,11 @@ StatementPropagationPass::StatementPropagationPass()
 
 bool StatementPropagationPass::execute(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
-
     // count the number of times each assignment LHS would be propagated somewhere
     std::map<SharedExp, int, lessExpStar> destCounts;
 
     // Also maintain a set of locations which are used by phi statements
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : proc->getStatementView()) {
         ExpDestCounter edc(destCounts);
         StmtDestCounter sdc(&edc);
         s->accept(&sdc);
@@ -44,20 +41,17 @@ bool StatementPropagationPass::execute(UserProc *proc)
 
     // A fourth pass to propagate only the flags
     // (these must be propagated even if it results in extra locals)
-    bool change = false;
+    bool change                = false;
+    const StmtKindMask nonPhis = STMT_MASK_ALL & ~stmtKindMask(StmtType::PhiAssign);
 
-    for (SharedStmt s : stmts) {
-        if (!s->isPhi()) {
-            change |= s->propagateFlagsToThis();
-        }
+    for (const SharedStmt &s : proc->getStatementView(nonPhis)) {
+        change |= s->propagateFlagsToThis();
     }
 
     // Finally the actual propagation
     const int propMaxDepth = proc->getProg()->getProject()->getSettings()->propMaxDepth;
-    for (SharedStmt s : stmts) {
-        if (!s->isPhi()) {
-            change |= s->propagateToThis(propMaxDepth, &destCounts);
-        }
+    for (const SharedStmt &s : proc->getStatementView(nonPhis)) {
+        change |= s->propagateToThis(propMaxDepth, &destCounts);
     }
 
     PassManager::get()->executePass(PassID::FragSimplify, proc);
@@ -37,12 +37,7 @@ FromSSAFormPass::FromSSAFormPass()
 
 bool FromSSAFormPass::execute(UserProc *proc)
 {
-    proc->getProg()->getProject()->alertDecompiling(proc);
-
-    StatementList stmts;
-    proc->getStatements(stmts);
-
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : proc->getStatementView()) {
         // Map registers to initial local variables
         mapRegistersToLocals(s);
 
@@ -260,14 +255,7 @@ bool FromSSAFormPass::execute(UserProc *proc)
 
 void FromSSAFormPass::nameParameterPhis(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
-
-    for (SharedStmt insn : stmts) {
-        if (!insn->isPhi()) {
-            continue; // Might be able to optimise this a bit
-        }
-
+    for (const SharedStmt &insn : proc->getStatementsOfKind(StmtType::PhiAssign)) {
         std::shared_ptr<PhiAssign> pi = insn->as<PhiAssign>();
         // See if the destination has a symbol already
         SharedExp lhs = pi->getLeft();
@@ -374,14 +362,7 @@ void FromSSAFormPass::removeSubscriptsFromParameters(UserProc *proc)
 
 void FromSSAFormPass::findPhiUnites(UserProc *proc, ConnectionGraph &pu)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
-
-    for (SharedStmt stmt : stmts) {
-        if (!stmt->isPhi()) {
-            continue;
-        }
-
+    for (const SharedStmt &stmt : proc->getStatementsOfKind(StmtType::PhiAssign)) {
         std::shared_ptr<PhiAssign> pa = stmt->as<PhiAssign>();
         SharedExp lhs                 = pa->getLeft();
         auto reLhs                    = RefExp::get(lhs, pa);
@@ -419,14 +400,10 @@ void FromSSAFormPass::mapRegistersToLocals(const SharedStmt &stmt)
 
 void FromSSAFormPass::removePhis(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
-
-    for (SharedStmt s : stmts) {
-        if (!s->isPhi()) {
-            continue;
-        }
+    // Copy the phis, since they are removed or replaced below
+    const std::vector<SharedStmt> phis = proc->getStatementsOfKind(StmtType::PhiAssign);
 
+    for (const SharedStmt &s : phis) {
         // Check if the base variables are all the same
         std::shared_ptr<PhiAssign> phi = s->as<PhiAssign>();
 
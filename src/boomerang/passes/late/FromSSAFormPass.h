@@ -24,6 +24,9 @@ public:
     FromSSAFormPass();
 
 public:
+    /// \copydoc IPass::isProcLocal
+    bool isProcLocal() const override { return true; }
+
     /// \copydoc IPass::execute
     bool execute(UserProc *proc) override;
 
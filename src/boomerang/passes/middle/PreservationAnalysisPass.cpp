@@ -58,6 +58,8 @@ bool PreservationAnalysisPass::execute(UserProc *proc)
         }
 
         LOG_MSG("### End proven true for procedure %1", proc->getName());
+        LOG_MSG("Proof cache of %1: %2 hits, %3 misses", proc->getName(),
+                proc->getProofCache().getNumHits(), proc->getProofCache().getNumMisses());
     }
 
     // Remove the preserved locations from the modifieds and the returns
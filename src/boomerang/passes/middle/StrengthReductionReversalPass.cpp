@@ -12,6 +12,7 @@
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/ssl/exp/Binary.h"
 #include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/ExpPattern.h"
 #include "boomerang/ssl/exp/RefExp.h"
 #include "boomerang/ssl/statements/Assign.h"
 #include "boomerang/ssl/statements/PhiAssign.h"
@@ -64,10 +65,11 @@ bool StrengthReductionReversalPass::execute(UserProc *proc)
                         StatementList stmts2;
                         proc->getStatements(stmts2);
 
+                        const ExpPattern pattern(*r);
                         for (SharedStmt stmt2 : stmts2) {
                             if (stmt2 != as) {
                                 stmt2->searchAndReplace(
-                                    *r, Binary::get(opMult, r->clone(), Const::get(c)));
+                                    pattern, Binary::get(opMult, r->clone(), Const::get(c)));
                             }
                         }
 
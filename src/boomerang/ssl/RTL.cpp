@@ -20,6 +20,7 @@
 #include <QTextStreamManipulator>
 #include <QtAlgorithms>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdio>
 #include <cstring>
@@ -30,6 +31,7 @@ RTL::RTL(Address instrAddr, const StmtList *listStmt /*= nullptr*/)
 {
     if (listStmt) {
         m_stmts = *listStmt;
+        attachAll();
     }
 }
 
@@ -38,6 +40,7 @@ RTL::RTL(Address instrAddr, const std::initializer_list<SharedStmt> &statements)
     : m_stmts(statements)
     , m_nativeAddr(instrAddr)
 {
+    attachAll();
 }
 
 
@@ -48,8 +51,18 @@ RTL::RTL(const RTL &other)
 }
 
 
+RTL::RTL(RTL &&other)
+    : m_stmts(std::move(other.m_stmts))
+    , m_nativeAddr(std::move(other.m_nativeAddr))
+{
+    // iterators of the moved nodes remain valid
+    attachAll();
+}
+
+
 RTL::~RTL()
 {
+    detachAll();
 }
 
 
@@ -65,6 +78,22 @@ RTL &RTL::operator=(const RTL &other)
     clear();
 
     other.deepCopyList(m_stmts);
+    attachAll();
+    return *this;
+}
+
+
+RTL &RTL::operator=(RTL &&other)
+{
+    if (this == &other) {
+        return *this;
+    }
+
+    detachAll();
+    m_stmts      = std::move(other.m_stmts);
+    m_nativeAddr = std::move(other.m_nativeAddr);
+    attachAll();
+
     return *this;
 }
 
@@ -81,6 +110,7 @@ void RTL::append(const SharedStmt &s)
 {
     assert(s != nullptr);
     m_stmts.push_back(s);
+    attach(std::prev(m_stmts.end()));
 }
 
 
@@ -88,6 +118,7 @@ void RTL::append(const StmtList &stmts)
 {
     for (const SharedStmt &stmt : stmts) {
         m_stmts.push_back(stmt->clone());
+        attach(std::prev(m_stmts.end()));
     }
 }
 
@@ -151,7 +182,8 @@ void RTL::simplify()
                 LOG_VERBOSE("Replacing branch with true condition with goto at %1 %2", getAddress(),
                             *it);
                 IRFragment *frag = (*it)->getFragment();
-                *it = std::make_shared<GotoStatement>(s->as<BranchStatement>()->getFixedDest());
+                const Address dest = s->as<BranchStatement>()->getFixedDest();
+                replace(it, std::make_shared<GotoStatement>(dest));
                 (*it)->setFragment(frag);
             }
         }
@@ -187,7 +219,105 @@ SharedStmt RTL::getHlStmt() const
 }
 
 
-void RTL::insert(RTL::iterator where, const RTL::value_type &val)
+RTL::iterator RTL::find(const SharedConstStmt &stmt)
+{
+    if (!stmt) {
+        return end();
+    }
+    else if (stmt->m_rtl == this && *stmt->m_rtlPos == stmt) {
+        return stmt->m_rtlPos;
+    }
+
+    // stmt was inserted into another RTL after being inserted into this one
+    return std::find(begin(), end(), stmt);
+}
+
+
+void RTL::replace(iterator it, const SharedStmt &stmt)
 {
-    m_stmts.insert(where, val);
+    assert(stmt != nullptr);
+    detach(it);
+    *it = stmt;
+    attach(it);
+}
+
+
+void RTL::pop_front()
+{
+    detach(m_stmts.begin());
+    m_stmts.pop_front();
+}
+
+
+void RTL::pop_back()
+{
+    detach(std::prev(m_stmts.end()));
+    m_stmts.pop_back();
+}
+
+
+void RTL::push_front(const value_type &val)
+{
+    m_stmts.push_front(val);
+    attach(m_stmts.begin());
+}
+
+
+RTL::iterator RTL::insert(RTL::iterator where, const RTL::value_type &val)
+{
+    iterator it = m_stmts.insert(where, val);
+    attach(it);
+    return it;
+}
+
+
+void RTL::clear()
+{
+    detachAll();
+    m_stmts.clear();
+}
+
+
+RTL::iterator RTL::erase(iterator it)
+{
+    detach(it);
+    return m_stmts.erase(it);
+}
+
+
+void RTL::attach(iterator it)
+{
+    touch();
+
+    if (*it) {
+        (*it)->m_rtl    = this;
+        (*it)->m_rtlPos = it;
+    }
+}
+
+
+void RTL::detach(iterator it)
+{
+    touch();
+
+    if (*it && (*it)->m_rtl == this && (*it)->m_rtlPos == it) {
+        (*it)->m_rtl    = nullptr;
+        (*it)->m_rtlPos = StmtList::iterator();
+    }
+}
+
+
+void RTL::attachAll()
+{
+    for (iterator it = m_stmts.begin(); it != m_stmts.end(); ++it) {
+        attach(it);
+    }
+}
+
+
+void RTL::detachAll()
+{
+    for (iterator it = m_stmts.begin(); it != m_stmts.end(); ++it) {
+        detach(it);
+    }
 }
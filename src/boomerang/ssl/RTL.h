@@ -12,6 +12,7 @@
 
 #include "boomerang/ssl/statements/Statement.h"
 #include "boomerang/util/Address.h"
+#include "boomerang/util/Types.h"
 
 #include <list>
 #include <memory>
@@ -51,13 +52,13 @@ public:
     explicit RTL(Address instrAddr, const std::initializer_list<SharedStmt> &statements);
 
     explicit RTL(const RTL &other); ///< Deep copies the content
-    explicit RTL(RTL &&other) = default;
+    explicit RTL(RTL &&other);
 
     ~RTL();
 
     /// Makes this RTL a deep copy of \p other.
     RTL &operator=(const RTL &other);
-    RTL &operator=(RTL &&other) = default;
+    RTL &operator=(RTL &&other);
 
 public:
     /// Return RTL's native address
@@ -98,6 +99,21 @@ public:
 
     const StmtList &getStatements() const { return m_stmts; }
 
+    /**
+     * \returns the position of \p stmt in this RTL, or end() if \p stmt is not part of this RTL.
+     * This is O(1) if this is the RTL \p stmt was last inserted into (\sa Statement::getRTL),
+     * and a linear search otherwise.
+     */
+    iterator find(const SharedConstStmt &stmt);
+
+    /// Replace the statement at \p it by \p stmt.
+    void replace(iterator it, const SharedStmt &stmt);
+
+    /// Count insertions and removals of statements in \p stamp. Set by the fragment
+    /// owning this RTL, so that caches of the statements of a procedure can detect
+    /// changes (\sa ProcCFG::getModificationStamp).
+    void setModificationStamp(uint64 *stamp) { m_modificationStamp = stamp; }
+
     // delegates to std::list
 public:
     bool empty() const { return m_stmts.empty(); }
@@ -119,19 +135,37 @@ public:
     const_reverse_iterator rbegin() const { return m_stmts.rbegin(); }
     const_reverse_iterator rend() const { return m_stmts.rend(); }
 
-    void pop_front() { m_stmts.pop_front(); }
-    void pop_back() { m_stmts.pop_back(); }
+    void pop_front();
+    void pop_back();
+
+    void push_front(const value_type &val);
+
+    iterator insert(iterator where, const value_type &val);
+    void clear();
+
+    iterator erase(iterator it);
+
+private:
+    /// Remember that \p it is the position of its statement.
+    void attach(iterator it);
 
-    void push_front(const value_type &val) { m_stmts.push_front(val); }
+    /// Forget the position of the statement at \p it, if it is in this RTL.
+    void detach(iterator it);
 
-    void insert(iterator where, const value_type &val);
-    void clear() { m_stmts.clear(); }
+    void attachAll();
+    void detachAll();
 
-    iterator erase(iterator it) { return m_stmts.erase(it); }
+    void touch()
+    {
+        if (m_modificationStamp) {
+            ++*m_modificationStamp;
+        }
+    }
 
 private:
     StmtList m_stmts;
-    Address m_nativeAddr; ///< RTL's source program instruction address
+    Address m_nativeAddr;                  ///< RTL's source program instruction address
+    uint64 *m_modificationStamp = nullptr; ///< Modification stamp of the owning ProcCFG
 };
 
 using SharedRTL = std::shared_ptr<RTL>;
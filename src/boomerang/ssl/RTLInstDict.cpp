@@ -113,26 +113,37 @@ void RTLInstDict::print(OStream &os /*= std::cout*/)
 std::unique_ptr<RTL> RTLInstDict::instantiateRTL(const QString &name, Address natPC,
                                                  const std::vector<SharedExp> &args)
 {
-    // TODO try to retrieve fast instruction mappings
-    // before trying the verbose instructions
-    auto dict_entry = m_instructions.find({ name, args.size() });
-    if (dict_entry == m_instructions.end()) {
+    const TableEntry *entry = findEntry(name, args.size());
+    if (entry == nullptr) {
         LOG_ERROR("Cannot instantiate instruction '%1' at address %2: "
                   "No instruction template takes %3 arguments",
                   name, natPC, args.size());
         return nullptr; // instruction not found
     }
 
-    TableEntry &entry(dict_entry->second);
-    return instantiateRTL(entry.m_rtl, natPC, entry.m_params, args);
+    return instantiateRTL(*entry, natPC, args);
+}
+
+
+std::unique_ptr<RTL> RTLInstDict::instantiateRTL(const TableEntry &entry, Address natPC,
+                                                 const std::vector<SharedExp> &args)
+{
+    return instantiateRTL(entry.m_rtl, natPC, entry.m_formals, args);
+}
+
+
+const TableEntry *RTLInstDict::findEntry(const QString &name, std::size_t numParams) const
+{
+    auto it = m_instructions.find({ name, static_cast<int>(numParams) });
+    return it != m_instructions.end() ? &it->second : nullptr;
 }
 
 
 std::unique_ptr<RTL> RTLInstDict::instantiateRTL(const RTL &existingRTL, Address natPC,
-                                                 const std::list<QString> &params,
+                                                 const std::vector<ExpPattern> &formals,
                                                  const std::vector<SharedExp> &args)
 {
-    assert(params.size() == args.size());
+    assert(formals.size() == args.size());
 
     // Get a deep copy of the template RTL
     std::unique_ptr<RTL> newList(new RTL(existingRTL));
@@ -141,15 +152,10 @@ std::unique_ptr<RTL> RTLInstDict::instantiateRTL(const RTL &existingRTL, Address
     // Iterate through each Statement of the new list of stmts
     for (SharedStmt ss : *newList) {
         // Search for the formals and replace them with the actual arguments
-        auto arg = args.begin();
-
-        for (QString paramName : params) {
-            /* Simple parameter - just construct the formal to search for */
-            Location param(opParam, Const::get(paramName), nullptr);
-            ss->searchAndReplace(param, *arg);
-            ++arg;
+        for (std::size_t i = 0; i < formals.size(); i++) {
+            ss->searchAndReplace(formals[i], args[i]);
         }
-        assert(arg == args.end());
+
         fixSuccessorForStmt(ss);
 
         if (m_verboseOutput) {
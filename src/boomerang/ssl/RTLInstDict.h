@@ -71,6 +71,15 @@ public:
     std::unique_ptr<RTL> instantiateRTL(const QString &name, Address pc,
                                         const std::vector<SharedExp> &args);
 
+    /// Same as above, for an instruction template previously found by \ref findEntry.
+    std::unique_ptr<RTL> instantiateRTL(const TableEntry &entry, Address pc,
+                                        const std::vector<SharedExp> &args);
+
+    /// \returns the template of the instruction with name \p name taking \p numParams
+    /// parameters, or nullptr if there is no such instruction.
+    /// The template stays valid until the dictionary is modified.
+    const TableEntry *findEntry(const QString &name, std::size_t numParams) const;
+
     RegDB *getRegDB();
     const RegDB *getRegDB() const;
 
@@ -84,12 +93,12 @@ private:
      *
      * \param   rtls    a register transfer list
      * \param   pc      address at which the named instruction is located
-     * \param   params  a list of formal parameters
+     * \param   formals compiled patterns of the formal parameters (\sa TableEntry::m_formals)
      * \param   args    the actual parameter values
      * \returns the instantiated list of Exps
      */
     std::unique_ptr<RTL> instantiateRTL(const RTL &rtls, Address pc,
-                                        const std::list<QString> &params,
+                                        const std::vector<ExpPattern> &formals,
                                         const std::vector<SharedExp> &args);
 
     /**
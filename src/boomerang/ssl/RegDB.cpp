@@ -35,6 +35,9 @@ void RegDB::clear()
     m_regNums.clear();
     m_regInfo.clear();
     m_specialRegInfo.clear();
+    m_parent.clear();
+    m_offsetInParent.clear();
+    m_children.clear();
 }
 
 
@@ -164,6 +167,60 @@ bool RegDB::createRegRelation(const QString &parent, const QString &child, int o
 }
 
 
+std::set<RegNum> RegDB::getCoveredRegs(RegNum regNum) const
+{
+    std::set<RegNum> result;
+    const Register *reg = getRegByNum(regNum);
+    if (!reg) {
+        return result;
+    }
+
+    std::stack<QString> toVisit({ reg->getName() });
+
+    while (!toVisit.empty()) {
+        const QString current = toVisit.top();
+        toVisit.pop();
+
+        const auto it = m_children.find(current);
+        if (it == m_children.end()) {
+            continue;
+        }
+
+        for (const auto &offsetAndChild : it->second) {
+            const RegNum childNum = getRegNumByName(offsetAndChild.second);
+            if (childNum != RegNumSpecial) {
+                result.insert(childNum);
+            }
+
+            toVisit.push(offsetAndChild.second);
+        }
+    }
+
+    return result;
+}
+
+
+std::set<RegNum> RegDB::getOverlappingRegs(RegNum regNum) const
+{
+    std::set<RegNum> result = getCoveredRegs(regNum);
+    const Register *reg     = getRegByNum(regNum);
+    if (!reg) {
+        return result;
+    }
+
+    // all ancestors overlap as well
+    for (auto it = m_parent.find(reg->getName()); it != m_parent.end();
+         it      = m_parent.find(it->second)) {
+        const RegNum parentNum = getRegNumByName(it->second);
+        if (parentNum != RegNumSpecial) {
+            result.insert(parentNum);
+        }
+    }
+
+    return result;
+}
+
+
 std::unique_ptr<RTL> RegDB::processOverlappedRegs(const std::shared_ptr<Assignment> &stmt,
                                                   const std::set<RegNum> &usedRegs) const
 {
@@ -219,7 +276,7 @@ std::unique_ptr<RTL> RegDB::processOverlappedRegs(const std::shared_ptr<Assignme
             std::stack<std::pair<const Register *, int>> toVisit({ { base, 0 } });
 
             while (!toVisit.empty()) {
-                const auto &[current, offset] = toVisit.top();
+                const auto [current, offset] = toVisit.top();
                 toVisit.pop();
 
                 if (current != base) {
@@ -86,6 +86,15 @@ public:
     /// \returns true on success, false on failure.
     bool createRegRelation(const QString &parent, const QString &child, int offsetInParent);
 
+    /// \returns all registers that are completely covered by \p regNum, excluding \p regNum itself.
+    /// Example: For x86 %ax, this is { %al, %ah }.
+    std::set<RegNum> getCoveredRegs(RegNum regNum) const;
+
+    /// \returns all registers that share at least one bit with \p regNum,
+    /// excluding \p regNum itself.
+    /// Example: For x86 %ax, this is { %eax, %al, %ah }.
+    std::set<RegNum> getOverlappingRegs(RegNum regNum) const;
+
     /// Process the effects of overlapped registers for \p stmt.
     /// Example: (x86 register overlap)
     ///   Suppose \p stmt is %ax := 0x1234, and %eax and %ah are used in the procedure that contains
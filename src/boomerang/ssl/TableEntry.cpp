@@ -9,6 +9,9 @@
 #pragma endregion License
 #include "TableEntry.h"
 
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+
 
 TableEntry::TableEntry()
     : m_rtl(Address::INVALID)
@@ -20,6 +23,11 @@ TableEntry::TableEntry(const std::list<QString> &params, const RTL &rtl)
     : m_rtl(rtl)
 {
     std::copy(params.begin(), params.end(), std::back_inserter(m_params));
+
+    m_formals.reserve(m_params.size());
+    for (const QString &paramName : m_params) {
+        m_formals.emplace_back(Location::get(opParam, Const::get(paramName), nullptr));
+    }
 }
 
 
@@ -11,6 +11,9 @@
 
 
 #include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/ExpPattern.h"
+
+#include <vector>
 
 
 /**
@@ -37,4 +40,7 @@ public:
 public:
     std::list<QString> m_params;
     RTL m_rtl;
+
+    /// Compiled search patterns for the formal parameters, in the same order as \ref m_params.
+    std::vector<ExpPattern> m_formals;
 };
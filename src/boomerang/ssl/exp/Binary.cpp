@@ -57,7 +57,8 @@ std::shared_ptr<Binary> Binary::get(OPER op, SharedExp e1, SharedExp e2)
 
 void Binary::setSubExp2(SharedExp e)
 {
-    m_subExp2 = e;
+    m_subExp2    = e;
+    m_normalForm = false;
     assert(m_subExp1 && m_subExp2);
 }
 
@@ -72,6 +73,7 @@ SharedExp Binary::getSubExp2()
 SharedExp &Binary::refSubExp2()
 {
     assert(m_subExp1 && m_subExp2);
+    m_normalForm = false; // the caller may replace the subexpression
     return m_subExp2;
 }
 
@@ -79,6 +81,7 @@ SharedExp &Binary::refSubExp2()
 void Binary::commute()
 {
     std::swap(m_subExp1, m_subExp2);
+    m_normalForm = false;
     assert(m_subExp1 && m_subExp2);
 }
 
@@ -163,16 +166,16 @@ bool Binary::equalNoSubscript(const Exp &o) const
 }
 
 
-void Binary::doSearchChildren(const Exp &pattern, std::list<SharedExp *> &li, bool once)
+void Binary::doSearchChildren(const ExpPattern &pattern, ExpMatchList &li, bool once)
 {
     assert(m_subExp1 && m_subExp2);
-    doSearch(pattern, m_subExp1, li, once);
+    doSearch(pattern, m_subExp1, this, li, once);
 
-    if (once && !li.empty()) {
+    if (once && !li.isEmpty()) {
         return;
     }
 
-    doSearch(pattern, m_subExp2, li, once);
+    doSearch(pattern, m_subExp2, this, li, once);
 }
 
 
@@ -531,8 +534,8 @@ SharedExp Binary::acceptPreModifier(ExpModifier *mod, bool &visitChildren)
 
 SharedExp Binary::acceptChildModifier(ExpModifier *mod)
 {
-    m_subExp1 = m_subExp1->acceptModifier(mod);
-    m_subExp2 = m_subExp2->acceptModifier(mod);
+    replaceSubExp(m_subExp1, m_subExp1->acceptModifier(mod));
+    replaceSubExp(m_subExp2, m_subExp2->acceptModifier(mod));
     return shared_from_this();
 }
 
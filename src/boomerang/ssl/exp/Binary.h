@@ -59,7 +59,7 @@ public:
     void commute();
 
     /// \copydoc Unary::doSearchChildren
-    void doSearchChildren(const Exp &search, std::list<SharedExp *> &li, bool once) override;
+    void doSearchChildren(const ExpPattern &pattern, ExpMatchList &li, bool once) override;
 
     /// \copydoc Unary::ascendType
     SharedType ascendType() override;
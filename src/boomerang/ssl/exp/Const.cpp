@@ -221,37 +221,43 @@ QString Const::getFuncName() const
 
 void Const::setInt(int value)
 {
-    m_value = value;
+    m_value      = value;
+    m_normalForm = false;
 }
 
 
 void Const::setLong(QWord value)
 {
-    m_value = value;
+    m_value      = value;
+    m_normalForm = false;
 }
 
 
 void Const::setFlt(double value)
 {
-    m_value = value;
+    m_value      = value;
+    m_normalForm = false;
 }
 
 
 void Const::setStr(const QString &value)
 {
-    m_value = value;
+    m_value      = value;
+    m_normalForm = false;
 }
 
 
 void Const::setRawStr(const char *p)
 {
-    m_value = p;
+    m_value      = p;
+    m_normalForm = false;
 }
 
 
 void Const::setAddr(Address addr)
 {
-    m_value = (QWord)addr.value();
+    m_value      = (QWord)addr.value();
+    m_normalForm = false;
 }
 
 
@@ -340,13 +346,13 @@ bool Const::descendType(SharedType newType)
         // May need to change the representation
         if (m_type->resolvesToFloat()) {
             if (m_oper == opIntConst) {
-                m_oper  = opFltConst;
+                setOper(opFltConst);
                 m_type  = FloatType::get(64);
                 int i   = getInt();
                 m_value = *reinterpret_cast<float *>(&i);
             }
             else if (m_oper == opLongConst) {
-                m_oper  = opFltConst;
+                setOper(opFltConst);
                 m_type  = FloatType::get(64);
                 QWord i = getLong();
                 m_value = *reinterpret_cast<double *>(&i);
@@ -33,9 +33,9 @@
 #include "boomerang/visitor/expmodifier/CallBypasser.h"
 #include "boomerang/visitor/expmodifier/ExpAddressSimplifier.h"
 #include "boomerang/visitor/expmodifier/ExpArithSimplifier.h"
+#include "boomerang/visitor/expmodifier/ExpNormalizer.h"
 #include "boomerang/visitor/expmodifier/ExpPropagator.h"
 #include "boomerang/visitor/expmodifier/ExpSSAXformer.h"
-#include "boomerang/visitor/expmodifier/ExpSimplifier.h"
 #include "boomerang/visitor/expmodifier/ExpSubscripter.h"
 #include "boomerang/visitor/expvisitor/BadMemofFinder.h"
 #include "boomerang/visitor/expvisitor/ComplexityFinder.h"
@@ -176,16 +176,22 @@ bool Exp::isFalse() const
 
 bool Exp::search(const Exp &pattern, SharedExp &result)
 {
-    std::list<SharedExp *> li;
+    return search(ExpPattern(pattern), result);
+}
+
+
+bool Exp::search(const ExpPattern &pattern, SharedExp &result)
+{
+    ExpMatchList matches;
     result = nullptr; // In case it fails; don't leave it unassigned
     // The search requires a reference to a pointer to this object.
     // This isn't needed for searches, only for replacements, but we want to re-use the same search
     // routine
     SharedExp top = shared_from_this();
-    doSearch(pattern, top, li, false);
+    doSearch(pattern, top, nullptr, matches, true);
 
-    if (!li.empty()) {
-        result = *li.front();
+    if (!matches.isEmpty()) {
+        result = *matches.front().slot;
         return true;
     }
 
@@ -195,19 +201,25 @@ bool Exp::search(const Exp &pattern, SharedExp &result)
 
 bool Exp::searchAll(const Exp &pattern, std::list<SharedExp> &result)
 {
-    std::list<SharedExp *> matches;
+    return searchAll(ExpPattern(pattern), result);
+}
+
+
+bool Exp::searchAll(const ExpPattern &pattern, std::list<SharedExp> &result)
+{
+    ExpMatchList matches;
 
     // The search requires a reference to a pointer to this object.
     // This isn't needed for searches, only for replacements,
     // but we want to re-use the same search routine
     SharedExp toSearch = shared_from_this();
-    doSearch(pattern, toSearch, matches, false);
+    doSearch(pattern, toSearch, nullptr, matches, false);
 
-    for (auto it : matches) {
-        result.push_back(*it);
+    for (const ExpMatch &match : matches) {
+        result.push_back(*match.slot);
     }
 
-    return !matches.empty();
+    return !matches.isEmpty();
 }
 
 
@@ -219,20 +231,31 @@ SharedExp Exp::searchReplace(const Exp &pattern, const SharedExp &replace, bool
 
 SharedExp Exp::searchReplaceAll(const Exp &pattern, const SharedExp &replace, bool &change,
                                 bool once /* = false */)
+{
+    return searchReplaceAll(ExpPattern(pattern), replace, change, once);
+}
+
+
+SharedExp Exp::searchReplaceAll(const ExpPattern &pattern, const SharedExp &replace,
+                                bool &change, bool once /* = false */)
 {
     // TODO: consider working on base object, and only in case when we find the search, use clone
     // call to return the new object ?
-    if (*this == pattern) {
+    if (pattern.matches(*this)) {
         change = true;
         return replace->clone();
     }
 
-    std::list<SharedExp *> matches;
+    ExpMatchList matches;
     SharedExp top = shared_from_this(); // top may change; that's why we have to return it
-    doSearch(pattern, top, matches, false);
+    doSearch(pattern, top, nullptr, matches, false);
+
+    for (const ExpMatch &match : matches) {
+        *match.slot = replace->clone(); // Do the replacement
 
-    for (SharedExp *pexp : matches) {
-        *pexp = replace->clone(); // Do the replacement
+        if (match.parent) {
+            match.parent->setNormalForm(false);
+        }
 
         if (once) {
             change = true;
@@ -240,18 +263,18 @@ SharedExp Exp::searchReplaceAll(const Exp &pattern, const SharedExp &replace, bo
         }
     }
 
-    change = !matches.empty();
+    change = !matches.isEmpty();
     return top;
 }
 
 
-void Exp::doSearch(const Exp &pattern, SharedExp &toSearch, std::list<SharedExp *> &matches,
-                   bool once)
+void Exp::doSearch(const ExpPattern &pattern, SharedExp &toSearch, Exp *parent,
+                   ExpMatchList &matches, bool once)
 {
-    const bool compare = (pattern == *toSearch);
+    const bool compare = pattern.matches(*toSearch);
 
     if (compare) {
-        matches.push_back(&toSearch); // Success
+        matches.append(ExpMatch{ parent, &toSearch }); // Success
 
         if (once) {
             return; // No more to do
@@ -266,7 +289,7 @@ void Exp::doSearch(const Exp &pattern, SharedExp &toSearch, std::list<SharedExp
 }
 
 
-void Exp::doSearchChildren(const Exp &pattern, std::list<SharedExp *> &matches, bool once)
+void Exp::doSearchChildren(const ExpPattern &pattern, ExpMatchList &matches, bool once)
 {
     Q_UNUSED(pattern);
     Q_UNUSED(matches);
@@ -354,16 +377,7 @@ SharedExp Exp::accumulate(std::list<SharedExp> &exprs)
 
 SharedExp Exp::simplify()
 {
-    bool changed  = false; // True if simplified at this or lower level
-    SharedExp res = shared_from_this();
-
-    do {
-        ExpSimplifier es;
-        res     = res->acceptModifier(&es);
-        changed = es.isModified();
-    } while (changed); // If modified at this (or a lower) level, redo
-
-    return res;
+    return ExpNormalizer().normalize(shared_from_this());
 }
 
 
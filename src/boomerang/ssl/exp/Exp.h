@@ -11,6 +11,7 @@
 
 
 #include "boomerang/ssl/exp/ExpHelp.h"
+#include "boomerang/ssl/exp/ExpPattern.h"
 #include "boomerang/ssl/exp/Operator.h"
 #include "boomerang/ssl/statements/Statement.h"
 #include "boomerang/util/OStream.h"
@@ -92,7 +93,17 @@ public:
     OPER getOper() const { return m_oper; }
 
     /// A few simplifications use this
-    void setOper(OPER oper) { m_oper = oper; }
+    void setOper(OPER oper)
+    {
+        m_oper       = oper;
+        m_normalForm = false;
+    }
+
+    /// \returns true if no simplification rule applied to this expression the last time it was
+    /// simplified, and it has not been modified since. Subexpressions carry their own flag.
+    /// \sa ExpNormalizer
+    bool isNormalForm() const { return m_normalForm; }
+    void setNormalForm(bool normalForm) { m_normalForm = normalForm; }
 
     /// Return the number of subexpressions. This is only needed in rare cases.
     /// Could use polymorphism for all those cases, but this is easier
@@ -277,6 +288,9 @@ public:
      */
     virtual bool search(const Exp &pattern, SharedExp &result);
 
+    /// \copydoc Exp::search
+    bool search(const ExpPattern &pattern, SharedExp &result);
+
     /**
      * Search this expression for the given subexpression, and for each found,
      * append the found subexpression to \p results.
@@ -287,6 +301,10 @@ public:
      */
     bool searchAll(const Exp &pattern, std::list<SharedExp> &results);
 
+    /// \copydoc Exp::searchAll
+    /// Use this overload when searching many expressions for the same pattern.
+    bool searchAll(const ExpPattern &pattern, std::list<SharedExp> &results);
+
     /**
      * Search for the given subexpression, and replace if found
      * \note    If the top level expression matches, return val != this
@@ -315,26 +333,32 @@ public:
     SharedExp searchReplaceAll(const Exp &pattern, const SharedExp &replacement, bool &change,
                                bool once = false);
 
+    /// \copydoc Exp::searchReplaceAll
+    /// Use this overload when searching many expressions for the same pattern.
+    SharedExp searchReplaceAll(const ExpPattern &pattern, const SharedExp &replacement,
+                               bool &change, bool once = false);
+
     /**
      * Search for the given sub-expression in \p toSearch and all children.
      * \note    Mostly not for public use.
      *
-     * \param   pattern  Exp we are searching for
+     * \param   pattern  compiled pattern we are searching for
      * \param   toSearch Exp to search for \p pattern.
-     * \param   matches  list of Exp** where pointers to the matches are found
+     * \param   parent   Exp owning \p toSearch, or nullptr for the top level expression
+     * \param   matches  list of slots where the matches are found
      * \param   once     true to return after the first match, false to return all matches in \p
      * toSearch
      */
-    static void doSearch(const Exp &pattern, SharedExp &toSearch, std::list<SharedExp *> &matches,
-                         bool once);
+    static void doSearch(const ExpPattern &pattern, SharedExp &toSearch, Exp *parent,
+                         ExpMatchList &matches, bool once);
 
     /**
      * Search for the given subexpression in all children
-     * \param pattern ptr to Exp we are searching for
-     * \param matches list of Exp** where pointers to the matches are found
+     * \param pattern compiled pattern we are searching for
+     * \param matches list of slots where the matches are found
      * \param once    true to return after the first match, false to return all matches in *this
      */
-    virtual void doSearchChildren(const Exp &pattern, std::list<SharedExp *> &matches, bool once);
+    virtual void doSearchChildren(const ExpPattern &pattern, ExpMatchList &matches, bool once);
 
     /// Propagate all possible assignments to components of this expression.
     SharedExp propagateAll();
@@ -402,7 +426,7 @@ public:
      * 8/7/2002
      *
      * \returns the simplified expression.
-     * \sa ExpSimplifier
+     * \sa ExpSimplifier, ExpNormalizer
      */
     SharedExp simplify();
 
@@ -506,6 +530,17 @@ protected:
     /// Accept an exppression modifier to modify this expression after modifying all subexpressions.
     virtual SharedExp acceptPostModifier(ExpModifier *mod) = 0;
 
+protected:
+    /// Set the subexpression \p subExp to \p newSubExp.
+    /// This expression is no longer in normal form if the subexpression changes.
+    void replaceSubExp(SharedExp &subExp, const SharedExp &newSubExp)
+    {
+        if (subExp != newSubExp) {
+            subExp       = newSubExp;
+            m_normalForm = false;
+        }
+    }
+
 protected:
     template<typename CHILD>
     std::shared_ptr<CHILD> shared_from_base()
@@ -520,7 +555,8 @@ protected:
     }
 
 protected:
-    OPER m_oper; ///< The operator (e.g. opPlus)
+    OPER m_oper;               ///< The operator (e.g. opPlus)
+    bool m_normalForm = false; ///< Set by ExpNormalizer, cleared by all mutators
 };
 
 
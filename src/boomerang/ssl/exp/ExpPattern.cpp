@@ -0,0 +1,277 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ExpPattern.h"
+
+#include "boomerang/ssl/exp/RefExp.h"
+
+#include <cassert>
+
+
+static SharedConstExp getSubExp(const Exp &exp, int i)
+{
+    switch (i) {
+    case 1: return exp.getSubExp1();
+    case 2: return exp.getSubExp2();
+    case 3: return exp.getSubExp3();
+    default: assert(false); return nullptr;
+    }
+}
+
+
+/// \returns the operator of the expressions matched by a wildcard like opWildIntConst
+static OPER getWildcardOper(OPER wildcard)
+{
+    switch (wildcard) {
+    case opWildIntConst: return opIntConst;
+    case opWildStrConst: return opStrConst;
+    case opWildMemOf: return opMemOf;
+    case opWildRegOf: return opRegOf;
+    case opWildAddrOf: return opAddrOf;
+    default: assert(false); return opInvalid;
+    }
+}
+
+
+ExpPattern::ExpPattern(const Exp &pattern, Mode mode)
+    : m_mode(mode)
+{
+    compile(pattern);
+}
+
+
+ExpPattern::ExpPattern(const SharedConstExp &pattern, Mode mode)
+    : m_owner(pattern)
+    , m_mode(mode)
+{
+    assert(pattern != nullptr);
+    compile(*pattern);
+}
+
+
+bool ExpPattern::matches(const Exp &exp) const
+{
+    int pc = 0;
+    return matchAt(exp, pc);
+}
+
+
+void ExpPattern::compile(const Exp &pattern)
+{
+    const int start = m_program.size();
+    m_program.append(Instruction{ InstrKind::Fallback, opInvalid, 0, 1, &pattern });
+
+    // equalNoSubscript ignores one level of subscripts on both sides
+    const Exp *node = &pattern;
+    SharedConstExp stripped;
+
+    if (m_mode == Mode::NoSubscript && pattern.isSubscript()) {
+        stripped = pattern.getSubExp1();
+        node     = stripped.get();
+    }
+
+    Instruction &instr = m_program[start];
+    instr.oper         = node->getOper();
+    instr.arity        = node->getArity();
+
+    switch (node->getOper()) {
+    case opWild: instr.kind = InstrKind::Any; return;
+
+    case opWildIntConst:
+    case opWildStrConst:
+    case opWildMemOf:
+    case opWildRegOf:
+    case opWildAddrOf:
+        instr.kind = InstrKind::Oper;
+        instr.oper = getWildcardOper(node->getOper());
+        return;
+
+    case opTypedExp: return; // types are compared as well
+
+    case opSubscript:
+        // References to specific statements (and nested subscripts when ignoring subscripts)
+        // are left to RefExp
+        if (m_mode == Mode::NoSubscript ||
+            static_cast<const RefExp *>(node)->getDef() != STMT_WILD) {
+            return;
+        }
+        break;
+
+    default: break;
+    }
+
+    if (instr.arity == 0) {
+        instr.kind = InstrKind::Leaf;
+        return;
+    }
+
+    instr.kind = InstrKind::Node;
+
+    for (int i = 1; i <= node->getArity(); i++) {
+        compile(*getSubExp(*node, i));
+    }
+
+    // m_program may have been reallocated
+    m_program[start].size = m_program.size() - start;
+}
+
+
+bool ExpPattern::matchAt(const Exp &exp, int &pc) const
+{
+    const Instruction &instr = m_program[pc];
+    const Exp &subject       = getSubject(exp);
+
+    switch (matchInstruction(instr, exp, subject)) {
+    case Result::Mismatch: return false;
+
+    case Result::Match: pc += instr.size; return true;
+
+    case Result::MatchChildren:
+        pc++;
+        for (int i = 1; i <= subject.getArity(); i++) {
+            if (!matchAt(*getSubExp(subject, i), pc)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+
+ExpPattern::Result ExpPattern::matchInstruction(const Instruction &instr, const Exp &exp,
+                                                const Exp &subject) const
+{
+    if (subject.isWildcard() || (m_mode == Mode::NoSubscript && subject.isSubscript())) {
+        // Wildcards or nested subscripts in the searched expression are rare;
+        // let Exp handle them.
+        return compareSlow(*instr.pattern, exp) ? Result::Match : Result::Mismatch;
+    }
+
+    switch (instr.kind) {
+    case InstrKind::Any: return Result::Match;
+
+    case InstrKind::Oper:
+        return subject.getOper() == instr.oper ? Result::Match : Result::Mismatch;
+
+    case InstrKind::Leaf:
+        if (subject.getOper() != instr.oper) {
+            return Result::Mismatch;
+        }
+
+        return compareSlow(*instr.pattern, exp) ? Result::Match : Result::Mismatch;
+
+    case InstrKind::Node:
+        if (subject.getOper() != instr.oper) {
+            return Result::Mismatch;
+        }
+        else if (subject.getArity() != instr.arity) {
+            return compareSlow(*instr.pattern, exp) ? Result::Match : Result::Mismatch;
+        }
+
+        return Result::MatchChildren;
+
+    case InstrKind::Fallback:
+        return compareSlow(*instr.pattern, exp) ? Result::Match : Result::Mismatch;
+    }
+
+    return Result::Mismatch;
+}
+
+
+bool ExpPattern::compareSlow(const Exp &pattern, const Exp &exp) const
+{
+    return m_mode == Mode::Exact ? pattern == exp : exp.equalNoSubscript(pattern);
+}
+
+
+const Exp &ExpPattern::getSubject(const Exp &exp) const
+{
+    if (m_mode == Mode::NoSubscript && exp.isSubscript()) {
+        // The subexpression is owned by exp, so it is safe to return a reference.
+        return *exp.getSubExp1();
+    }
+
+    return exp;
+}
+
+
+ExpPatternSet::ExpPatternSet(ExpPattern::Mode mode)
+    : m_mode(mode)
+{
+}
+
+
+int ExpPatternSet::addPattern(const SharedConstExp &pattern)
+{
+    m_patterns.emplace_back(pattern, m_mode);
+    return getNumPatterns() - 1;
+}
+
+
+int ExpPatternSet::findFirstMatch(const Exp &exp) const
+{
+    StateList states;
+    for (int i = 0; i < getNumPatterns(); i++) {
+        states.append(State{ i, 0 });
+    }
+
+    step(exp, states);
+
+    int firstMatch = -1;
+    for (const State &state : states) {
+        if (firstMatch == -1 || state.patternIdx < firstMatch) {
+            firstMatch = state.patternIdx;
+        }
+    }
+
+    return firstMatch;
+}
+
+
+void ExpPatternSet::step(const Exp &exp, StateList &states) const
+{
+    if (states.isEmpty()) {
+        return;
+    }
+
+    const Exp &subject = m_patterns.front().getSubject(exp);
+    StateList matchChildren;
+    int numMatched = 0;
+
+    for (int i = 0; i < states.size(); i++) {
+        const State state                    = states[i];
+        const ExpPattern &pattern            = m_patterns[state.patternIdx];
+        const ExpPattern::Instruction &instr = pattern.m_program[state.pc];
+
+        switch (pattern.matchInstruction(instr, exp, subject)) {
+        case ExpPattern::Result::Mismatch: break;
+
+        case ExpPattern::Result::Match:
+            states[numMatched++] = State{ state.patternIdx, state.pc + instr.size };
+            break;
+
+        case ExpPattern::Result::MatchChildren:
+            matchChildren.append(State{ state.patternIdx, state.pc + 1 });
+            break;
+        }
+    }
+
+    states.resize(numMatched);
+
+    // All remaining patterns agree on the operator of subject, so they all have the same
+    // children; match them against each child in turn.
+    for (int i = 1; i <= subject.getArity() && !matchChildren.isEmpty(); i++) {
+        step(*getSubExp(subject, i), matchChildren);
+    }
+
+    states.append(matchChildren.constData(), matchChildren.size());
+}
@@ -0,0 +1,166 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/ssl/exp/ExpHelp.h"
+#include "boomerang/ssl/exp/Operator.h"
+
+#include <QVarLengthArray>
+
+#include <cstdint>
+#include <vector>
+
+
+/// A subexpression matching a pattern. Writing to *slot replaces the subexpression.
+struct ExpMatch
+{
+    Exp *parent;     ///< Expression owning the slot; nullptr for the top level expression
+    SharedExp *slot; ///< Pointer to the matching subexpression
+};
+
+/// Buffer for search results. Most searches find only a handful of matches.
+typedef QVarLengthArray<ExpMatch, 8> ExpMatchList;
+
+
+/**
+ * A search pattern (an expression that may contain wildcards like opWild, opWildIntConst
+ * or opWildRegOf) compiled into a flat program, so that it can be matched against
+ * many expressions without going through the virtual comparison operators
+ * for every node of the pattern.
+ *
+ * The program is the pattern in prefix order. Each instruction either matches a complete
+ * subexpression (wildcards and leaves) or checks the operator of a subexpression
+ * and continues with its children. Parts of the pattern without a cheap structural test
+ * (e.g. TypedExps or references to specific statements) fall back to the comparison operators
+ * of Exp, so matching always gives the same result as the uncompiled pattern.
+ *
+ * \note The pattern expression must not be modified or destroyed while it is in use.
+ */
+class BOOMERANG_API ExpPattern
+{
+    friend class ExpPatternSet;
+
+public:
+    enum class Mode : uint8_t
+    {
+        Exact,      ///< Match like pattern == exp
+        NoSubscript ///< Match like exp.equalNoSubscript(pattern)
+    };
+
+public:
+    explicit ExpPattern(const Exp &pattern, Mode mode = Mode::Exact);
+    explicit ExpPattern(const SharedConstExp &pattern, Mode mode = Mode::Exact);
+
+    ExpPattern(const ExpPattern &other) = default;
+    ExpPattern(ExpPattern &&other)      = default;
+
+    ~ExpPattern() = default;
+
+    ExpPattern &operator=(const ExpPattern &other) = default;
+    ExpPattern &operator=(ExpPattern &&other) = default;
+
+public:
+    /// \returns true if \p exp matches this pattern
+    bool matches(const Exp &exp) const;
+
+    Mode getMode() const { return m_mode; }
+
+    /// \returns the number of instructions of the compiled pattern
+    int getProgramSize() const { return m_program.size(); }
+
+private:
+    enum class InstrKind : uint8_t
+    {
+        Any,     ///< Matches anything (opWild)
+        Oper,    ///< Matches any expression with operator \ref Instruction::oper
+        Leaf,    ///< Matches an equal Const or Terminal
+        Node,    ///< Checks the operator and the arity, then matches the children
+        Fallback ///< Matches using the comparison operators of Exp
+    };
+
+    struct Instruction
+    {
+        InstrKind kind;
+        OPER oper;
+        int arity;
+        int size;           ///< Number of instructions for the pattern subexpression
+        const Exp *pattern; ///< Pattern subexpression (before stripping subscripts)
+    };
+
+    enum class Result : uint8_t
+    {
+        Mismatch,
+        Match,        ///< The complete subexpression matches
+        MatchChildren ///< The operator matches; the children have to be matched next
+    };
+
+private:
+    void compile(const Exp &pattern);
+
+    /// Match the instruction at \p pc against \p exp, advancing \p pc past the
+    /// pattern subexpression if successful.
+    bool matchAt(const Exp &exp, int &pc) const;
+
+    /// Match a single instruction against the top level of \p exp.
+    /// \p subject is \p exp with subscripts removed if required by the mode.
+    Result matchInstruction(const Instruction &instr, const Exp &exp, const Exp &subject) const;
+
+    /// Compare using the comparison operators of Exp.
+    bool compareSlow(const Exp &pattern, const Exp &exp) const;
+
+    /// \returns the expression to match against the instructions
+    /// (\p exp itself, or \p exp without its subscript)
+    const Exp &getSubject(const Exp &exp) const;
+
+private:
+    SharedConstExp m_owner; ///< Keeps the pattern alive if constructed from a shared pointer
+    QVarLengthArray<Instruction, 8> m_program;
+    Mode m_mode;
+};
+
+
+/**
+ * Matches an expression against several patterns at once.
+ * All patterns are matched in a single traversal of the expression,
+ * dropping patterns as soon as they cannot match any more.
+ */
+class BOOMERANG_API ExpPatternSet
+{
+public:
+    explicit ExpPatternSet(ExpPattern::Mode mode = ExpPattern::Mode::Exact);
+
+public:
+    /// Add a pattern. Patterns added earlier take precedence over patterns added later.
+    /// \returns the index of the new pattern.
+    int addPattern(const SharedConstExp &pattern);
+
+    /// \returns the index of the first pattern matching \p exp, or -1 if no pattern matches.
+    int findFirstMatch(const Exp &exp) const;
+
+    int getNumPatterns() const { return static_cast<int>(m_patterns.size()); }
+
+private:
+    struct State
+    {
+        int patternIdx;
+        int pc;
+    };
+
+    typedef QVarLengthArray<State, 16> StateList;
+
+    /// Advance all \p states over \p exp. States that do not match are removed.
+    void step(const Exp &exp, StateList &states) const;
+
+private:
+    ExpPattern::Mode m_mode;
+    std::vector<ExpPattern> m_patterns;
+};
@@ -155,7 +155,8 @@ SharedExp RefExp::addSubscript(const SharedStmt &def)
 
 void RefExp::setDef(const SharedStmt &def)
 {
-    m_def = def;
+    m_def        = def;
+    m_normalForm = false;
 }
 
 
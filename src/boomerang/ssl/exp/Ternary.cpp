@@ -50,7 +50,8 @@ std::shared_ptr<Ternary> Ternary::get(OPER op, SharedExp e1, SharedExp e2, Share
 
 void Ternary::setSubExp3(SharedExp e)
 {
-    m_subExp3 = e;
+    m_subExp3    = e;
+    m_normalForm = false;
     assert(m_subExp1 && m_subExp2 && m_subExp3);
 }
 
@@ -72,6 +73,7 @@ SharedConstExp Ternary::getSubExp3() const
 SharedExp &Ternary::refSubExp3()
 {
     assert(m_subExp1 && m_subExp2 && m_subExp3);
+    m_normalForm = false; // the caller may replace the subexpression
     return m_subExp3;
 }
 
@@ -146,21 +148,21 @@ bool Ternary::equalNoSubscript(const Exp &o) const
 }
 
 
-void Ternary::doSearchChildren(const Exp &pattern, std::list<SharedExp *> &li, bool once)
+void Ternary::doSearchChildren(const ExpPattern &pattern, ExpMatchList &li, bool once)
 {
-    doSearch(pattern, m_subExp1, li, once);
+    doSearch(pattern, m_subExp1, this, li, once);
 
-    if (once && !li.empty()) {
+    if (once && !li.isEmpty()) {
         return;
     }
 
-    doSearch(pattern, m_subExp2, li, once);
+    doSearch(pattern, m_subExp2, this, li, once);
 
-    if (once && !li.empty()) {
+    if (once && !li.isEmpty()) {
         return;
     }
 
-    doSearch(pattern, m_subExp3, li, once);
+    doSearch(pattern, m_subExp3, this, li, once);
 }
 
 
@@ -229,9 +231,9 @@ SharedExp Ternary::acceptPreModifier(ExpModifier *mod, bool &visitChildren)
 
 SharedExp Ternary::acceptChildModifier(ExpModifier *mod)
 {
-    m_subExp1 = m_subExp1->acceptModifier(mod);
-    m_subExp2 = m_subExp2->acceptModifier(mod);
-    m_subExp3 = m_subExp3->acceptModifier(mod);
+    replaceSubExp(m_subExp1, m_subExp1->acceptModifier(mod));
+    replaceSubExp(m_subExp2, m_subExp2->acceptModifier(mod));
+    replaceSubExp(m_subExp3, m_subExp3->acceptModifier(mod));
     return shared_from_this();
 }
 
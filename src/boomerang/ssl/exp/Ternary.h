@@ -57,7 +57,7 @@ public:
     SharedExp &refSubExp3() override;
 
     /// \copydoc Binary::doSearchChildren
-    void doSearchChildren(const Exp &search, std::list<SharedExp *> &li, bool once) override;
+    void doSearchChildren(const ExpPattern &pattern, ExpMatchList &li, bool once) override;
 
     /// \copydoc Binary::ascendType
     SharedType ascendType() override;
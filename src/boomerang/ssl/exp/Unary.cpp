@@ -55,7 +55,8 @@ SharedExp Unary::get(OPER op, SharedExp e1)
 
 void Unary::setSubExp1(SharedExp e)
 {
-    m_subExp1 = e;
+    m_subExp1    = e;
+    m_normalForm = false;
     assert(m_subExp1);
 }
 
@@ -77,6 +78,7 @@ SharedConstExp Unary::getSubExp1() const
 SharedExp &Unary::refSubExp1()
 {
     assert(m_subExp1);
+    m_normalForm = false; // the caller may replace the subexpression
     return m_subExp1;
 }
 
@@ -156,9 +158,9 @@ bool Unary::equalNoSubscript(const Exp &o) const
 }
 
 
-void Unary::doSearchChildren(const Exp &pattern, std::list<SharedExp *> &li, bool once)
+void Unary::doSearchChildren(const ExpPattern &pattern, ExpMatchList &li, bool once)
 {
-    doSearch(pattern, m_subExp1, li, once);
+    doSearch(pattern, m_subExp1, this, li, once);
 }
 
 
@@ -282,7 +284,7 @@ SharedExp Unary::acceptPreModifier(ExpModifier *mod, bool &visitChildren)
 
 SharedExp Unary::acceptChildModifier(ExpModifier *mod)
 {
-    m_subExp1 = m_subExp1->acceptModifier(mod);
+    replaceSubExp(m_subExp1, m_subExp1->acceptModifier(mod));
     return shared_from_this();
 }
 
@@ -46,7 +46,7 @@ public:
     int getArity() const override { return 1; }
 
     /// \copydoc Exp::doSearchChildren
-    void doSearchChildren(const Exp &search, std::list<SharedExp *> &li, bool once) override;
+    void doSearchChildren(const ExpPattern &pattern, ExpMatchList &li, bool once) override;
 
     /// \copydoc Exp::getSubExp1
     SharedExp getSubExp1() override;
@@ -123,13 +123,13 @@ void Assign::printCompact(OStream &os) const
 }
 
 
-bool Assign::search(const Exp &pattern, SharedExp &result) const
+bool Assign::search(const ExpPattern &pattern, SharedExp &result) const
 {
     return m_lhs->search(pattern, result) || m_rhs->search(pattern, result);
 }
 
 
-bool Assign::searchAll(const Exp &pattern, std::list<SharedExp> &result) const
+bool Assign::searchAll(const ExpPattern &pattern, std::list<SharedExp> &result) const
 {
     bool res;
 
@@ -146,7 +146,7 @@ bool Assign::searchAll(const Exp &pattern, std::list<SharedExp> &result) const
 }
 
 
-bool Assign::searchAndReplace(const Exp &pattern, SharedExp replace, bool /*cc*/)
+bool Assign::searchAndReplace(const ExpPattern &pattern, SharedExp replace, bool /*cc*/)
 {
     bool chl = false, chr = false, chg = false;
 
@@ -50,14 +50,18 @@ public:
     /// \copydoc Assignment::printCompact
     void printCompact(OStream &os) const override;
 
+    using Statement::search;
+    using Statement::searchAll;
+    using Statement::searchAndReplace;
+
     /// \copydoc Assignment::search
-    bool search(const Exp &search, SharedExp &result) const override;
+    bool search(const ExpPattern &search, SharedExp &result) const override;
 
     /// \copydoc Assignment::searchAll
-    bool searchAll(const Exp &search, std::list<SharedExp> &result) const override;
+    bool searchAll(const ExpPattern &search, std::list<SharedExp> &result) const override;
 
     /// \copydoc Assignment::searchAndReplace
-    bool searchAndReplace(const Exp &search, SharedExp replace, bool cc = false) override;
+    bool searchAndReplace(const ExpPattern &search, SharedExp replace, bool cc = false) override;
 
     /// \copydoc Assignment::simplify
     void simplify() override;
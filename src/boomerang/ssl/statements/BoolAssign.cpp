@@ -142,7 +142,7 @@ void BoolAssign::getDefinitions(LocationSet &defs, bool) const
 }
 
 
-bool BoolAssign::search(const Exp &pattern, SharedExp &result) const
+bool BoolAssign::search(const ExpPattern &pattern, SharedExp &result) const
 {
     assert(m_lhs != nullptr);
     assert(m_cond != nullptr);
@@ -151,7 +151,7 @@ bool BoolAssign::search(const Exp &pattern, SharedExp &result) const
 }
 
 
-bool BoolAssign::searchAll(const Exp &pattern, std::list<SharedExp> &result) const
+bool BoolAssign::searchAll(const ExpPattern &pattern, std::list<SharedExp> &result) const
 {
     assert(m_lhs != nullptr);
     assert(m_cond != nullptr);
@@ -165,7 +165,7 @@ bool BoolAssign::searchAll(const Exp &pattern, std::list<SharedExp> &result) con
 }
 
 
-bool BoolAssign::searchAndReplace(const Exp &pattern, SharedExp replace, bool)
+bool BoolAssign::searchAndReplace(const ExpPattern &pattern, SharedExp replace, bool)
 {
     assert(m_lhs != nullptr);
     assert(m_cond != nullptr);
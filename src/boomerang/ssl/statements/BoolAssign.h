@@ -82,14 +82,18 @@ public:
     /// \copydoc Assignment::getRight
     SharedExp getRight() const override;
 
+    using Statement::search;
+    using Statement::searchAll;
+    using Statement::searchAndReplace;
+
     /// \copydoc Statement::search
-    bool search(const Exp &search, SharedExp &result) const override;
+    bool search(const ExpPattern &search, SharedExp &result) const override;
 
     /// \copydoc Statement::searchAll
-    bool searchAll(const Exp &search, std::list<SharedExp> &result) const override;
+    bool searchAll(const ExpPattern &search, std::list<SharedExp> &result) const override;
 
     /// \copydoc Statement::searchAndReplace
-    bool searchAndReplace(const Exp &search, SharedExp replace, bool cc = false) override;
+    bool searchAndReplace(const ExpPattern &search, SharedExp replace, bool cc = false) override;
 
 private:
     BranchType m_jumpType = BranchType::INVALID; ///< the condition for setting true
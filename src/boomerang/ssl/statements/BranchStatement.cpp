@@ -127,7 +127,7 @@ void BranchStatement::setTakenFragment(IRFragment *destFrag)
 }
 
 
-bool BranchStatement::search(const Exp &pattern, SharedExp &result) const
+bool BranchStatement::search(const ExpPattern &pattern, SharedExp &result) const
 {
     if (GotoStatement::search(pattern, result)) {
         return true;
@@ -141,7 +141,7 @@ bool BranchStatement::search(const Exp &pattern, SharedExp &result) const
 }
 
 
-bool BranchStatement::searchAndReplace(const Exp &pattern, SharedExp replace, bool cc)
+bool BranchStatement::searchAndReplace(const ExpPattern &pattern, SharedExp replace, bool cc)
 {
     bool change = GotoStatement::searchAndReplace(pattern, replace, cc);
 
@@ -155,7 +155,7 @@ bool BranchStatement::searchAndReplace(const Exp &pattern, SharedExp replace, bo
 }
 
 
-bool BranchStatement::searchAll(const Exp &pattern, std::list<SharedExp> &result) const
+bool BranchStatement::searchAll(const ExpPattern &pattern, std::list<SharedExp> &result) const
 {
     bool found = GotoStatement::searchAll(pattern, result);
 
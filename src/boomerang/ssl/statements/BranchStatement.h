@@ -85,14 +85,18 @@ public:
     /// \copydoc GotoStatement::print
     void print(OStream &os) const override;
 
+    using Statement::search;
+    using Statement::searchAll;
+    using Statement::searchAndReplace;
+
     /// \copydoc GotoStatement::search
-    bool search(const Exp &search, SharedExp &result) const override;
+    bool search(const ExpPattern &search, SharedExp &result) const override;
 
     /// \copydoc GotoStatement::searchAndReplace
-    bool searchAndReplace(const Exp &search, SharedExp replace, bool cc = false) override;
+    bool searchAndReplace(const ExpPattern &search, SharedExp replace, bool cc = false) override;
 
     /// \copydoc GotoStatement::searchAll
-    bool searchAll(const Exp &search, std::list<SharedExp> &result) const override;
+    bool searchAll(const ExpPattern &search, std::list<SharedExp> &result) const override;
 
     /// \copydoc GotoStatement::simplify
     void simplify() override;
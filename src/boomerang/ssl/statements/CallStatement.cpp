@@ -9,8 +9,10 @@
 #pragma endregion License
 #include "CallStatement.h"
 
+#include "boomerang/db/FormatStringCache.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/proc/CallEffectSummary.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/db/signature/Signature.h"
 #include "boomerang/ifc/ICodeGenerator.h"
@@ -22,11 +24,8 @@
 #include "boomerang/ssl/statements/Assign.h"
 #include "boomerang/ssl/statements/ImplicitAssign.h"
 #include "boomerang/ssl/statements/PhiAssign.h"
-#include "boomerang/ssl/type/ArrayType.h"
 #include "boomerang/ssl/type/CharType.h"
-#include "boomerang/ssl/type/FloatType.h"
 #include "boomerang/ssl/type/FuncType.h"
-#include "boomerang/ssl/type/IntegerType.h"
 #include "boomerang/ssl/type/PointerType.h"
 #include "boomerang/ssl/type/VoidType.h"
 #include "boomerang/util/ArgSourceProvider.h"
@@ -40,7 +39,6 @@
 #include "boomerang/visitor/stmtmodifier/StmtPartModifier.h"
 #include "boomerang/visitor/stmtvisitor/StmtVisitor.h"
 
-#include <QRegularExpression>
 #include <QTextStreamManipulator>
 
 
@@ -261,7 +259,7 @@ bool CallStatement::definesLoc(SharedExp loc) const
 }
 
 
-bool CallStatement::search(const Exp &pattern, SharedExp &result) const
+bool CallStatement::search(const ExpPattern &pattern, SharedExp &result) const
 {
     if (GotoStatement::search(pattern, result)) {
         return true;
@@ -283,7 +281,7 @@ bool CallStatement::search(const Exp &pattern, SharedExp &result) const
 }
 
 
-bool CallStatement::searchAll(const Exp &pattern, std::list<SharedExp> &result) const
+bool CallStatement::searchAll(const ExpPattern &pattern, std::list<SharedExp> &result) const
 {
     bool found = GotoStatement::searchAll(pattern, result);
 
@@ -303,7 +301,7 @@ bool CallStatement::searchAll(const Exp &pattern, std::list<SharedExp> &result)
 }
 
 
-bool CallStatement::searchAndReplace(const Exp &pattern, SharedExp replace, bool cc)
+bool CallStatement::searchAndReplace(const ExpPattern &pattern, SharedExp replace, bool cc)
 {
     bool change = GotoStatement::searchAndReplace(pattern, replace, cc);
 
@@ -491,6 +489,13 @@ void CallStatement::setArguments(const StatementList &args)
 }
 
 
+void CallStatement::setSignature(const std::shared_ptr<Signature> &sig)
+{
+    m_signature              = sig;
+    m_isSignatureSpecialized = false;
+}
+
+
 void CallStatement::setSigArguments()
 {
     if (m_signature) {
@@ -502,9 +507,7 @@ void CallStatement::setSigArguments()
         return;
     }
 
-    // Clone here because each call to procDest could have a different signature,
-    // modified by doEllipsisProcessing()
-    m_signature = m_procDest->getSignature()->clone();
+    useSignatureOf(m_procDest);
     m_procDest->addCaller(shared_from_this()->as<CallStatement>());
 
     if (!m_procDest->isLib()) {
@@ -516,16 +519,18 @@ void CallStatement::setSigArguments()
 
     const int n = m_signature->getNumParams();
     for (int i = 0; i < n; i++) {
-        SharedExp e = m_signature->getArgumentExp(i);
-        assert(e);
-        auto l = std::dynamic_pointer_cast<Location>(e);
+        assert(m_signature->getArgumentExp(i));
+
+        // Don't modify the parameters of the (shared) signature
+        SharedExp e = m_signature->getArgumentExp(i)->clone();
+        auto l      = std::dynamic_pointer_cast<Location>(e);
 
         if (l) {
             l->setProc(m_proc); // Needed?
         }
 
         std::shared_ptr<Assign> asgn = std::make_shared<Assign>(
-            m_signature->getParamType(i)->clone(), e->clone(), e->clone());
+            m_signature->getParamType(i)->clone(), e, e->clone());
 
         asgn->setProc(m_proc);
         asgn->setFragment(m_fragment);
@@ -877,6 +882,15 @@ SharedExp CallStatement::getProven(SharedExp e)
     if (!m_procDest) {
         return nullptr;
     }
+    else if (!m_procDest->isLib()) {
+        // Use the summary of the callee if it is final, which avoids re-querying the callee
+        const std::shared_ptr<const CallEffectSummary>
+            summary = static_cast<UserProc *>(m_procDest)->getCallSummary();
+
+        if (summary) {
+            return summary->getProven(e);
+        }
+    }
 
     return m_procDest->getProven(e);
 }
@@ -937,7 +951,7 @@ SharedExp CallStatement::bypassRef(const std::shared_ptr<RefExp> &r, bool &chang
             return ret;
         }
 
-        proven = m_procDest->getProven(base); // e.g. r28+4
+        proven = getProven(base); // e.g. r28+4
     }
 
     if (proven == nullptr) {
@@ -1067,6 +1081,7 @@ bool CallStatement::doEllipsisProcessing()
     assert(n >= 0);
 
     setNumArguments((formatstrIdx + 1) + n);
+    specializeSignature();
     m_signature->setHasEllipsis(false); // So we don't do this again
 
     return true;
@@ -1075,233 +1090,17 @@ bool CallStatement::doEllipsisProcessing()
 
 int CallStatement::parseFmtStr(const QString &fmtStr, bool isScanf)
 {
-    // clang-format off
-    const QRegularExpression re(
-        "%("                                 // '%' followed by either ...
-          "(?<flags>[+-0 #]*)"               //   flags (opt), ...
-          "(?<width>([0-9\\*]*))"            //   width (opt, digits or *), ...
-          "(?<prec>((\\.[0-9\\*]+)?))"       //   precision (opt, dot followed by digits or *), ...
-          "(?<mod>[hlLzjt]*)"                //   size modifier (opt), and ...
-          "(?<spec>([%diufFeEgGxXaAoscpn]))" //   the actual specifier, ...
-        "|"                                  // or ...
-          "(?<list>l?\\[\\^?[^\\]]+\\])"     //   a list of characters to (not) match (scanf only)
-        ")");
-    // clang-format on
-
-    auto it = re.globalMatch(fmtStr);
-    int n   = 0;
-
-    while (it.hasNext()) {
-        auto match = it.next();
-
-        const QString width = match.captured("width");
-        const QString prec  = match.captured("prec");
-        const QString mod   = match.captured("mod");
-        const QString list  = match.captured("list");
-        const QString spec  = match.captured("spec");
-
-        if (isScanf && list != "") {
-            if (list[0] == "l") {
-                addSigParam(ArrayType::get(IntegerType::get(16, Sign::Signed)), true); // wchar_t
-                n++;
-            }
-            else {
-                addSigParam(ArrayType::get(CharType::get()), true);
-                n++;
-            }
+    Prog *prog = m_procDest ? m_procDest->getProg() : nullptr;
 
-            continue;
-        }
-
-        if (isScanf && width.startsWith("*")) {
-            // We have something like %*3d. No output parameter.
-            continue;
-        }
-
-        if (width == "*") {
-            addSigParam(IntegerType::get(32, Sign::Signed), false);
-            n++;
-        }
-
-        if (prec == ".*") {
-            addSigParam(IntegerType::get(32, Sign::Signed), false);
-            n++;
-        }
-
-        switch (spec[0].toLatin1()) {
-        case 'd':
-        case 'i':
-            if (mod == "") {
-                addSigParam(IntegerType::get(32, Sign::Signed), isScanf);
-                n++;
-            }
-            else if (mod == "hh") {
-                addSigParam(IntegerType::get(8, Sign::Signed), isScanf);
-                n++;
-            }
-            else if (mod == "h") {
-                addSigParam(IntegerType::get(16, Sign::Signed), isScanf);
-                n++;
-            }
-            else if (mod == "l") {
-                addSigParam(IntegerType::get(32, Sign::Signed), isScanf);
-                n++;
-            }
-            else if (mod == "ll") {
-                addSigParam(IntegerType::get(64, Sign::Signed), isScanf);
-                n++;
-            }
-            else if (mod == "j") {
-                addSigParam(IntegerType::get(32, Sign::Signed), isScanf);
-                n++;
-            }
-            else if (mod == "z") { // size_t
-                addSigParam(IntegerType::get(STD_SIZE, Sign::Unsigned), isScanf);
-                n++;
-            }
-            else if (mod == "t") { // ptrdiff_t
-                addSigParam(IntegerType::get(STD_SIZE, Sign::Signed), isScanf);
-                n++;
-            }
-            break;
+    const FormatParams params = prog ? prog->getFormatStringCache().getParams(fmtStr, isScanf)
+                                     : FormatStringCache::parse(fmtStr, isScanf);
 
-        case 'X':
-            if (isScanf) {
-                break; // not valid for scanf
-            }
-            // fallthrough
-        case 'u':
-        case 'o':
-        case 'x':
-            if (mod == "") {
-                addSigParam(IntegerType::get(32, Sign::Unsigned), isScanf);
-                n++;
-            }
-            else if (mod == "hh") {
-                addSigParam(IntegerType::get(8, Sign::Unsigned), isScanf);
-                n++;
-            }
-            else if (mod == "h") {
-                addSigParam(IntegerType::get(16, Sign::Unsigned), isScanf);
-                n++;
-            }
-            else if (mod == "l") {
-                addSigParam(IntegerType::get(32, Sign::Unsigned), isScanf);
-                n++;
-            }
-            else if (mod == "ll") {
-                addSigParam(IntegerType::get(64, Sign::Unsigned), isScanf);
-                n++;
-            }
-            else if (mod == "j") {
-                addSigParam(IntegerType::get(32, Sign::Unsigned), isScanf);
-                n++;
-            }
-            else if (mod == "z") { // size_t
-                addSigParam(IntegerType::get(STD_SIZE, Sign::Unsigned), isScanf);
-                n++;
-            }
-            else if (mod == "t") { // ptrdiff_t
-                addSigParam(IntegerType::get(STD_SIZE, Sign::Signed), isScanf);
-                n++;
-            }
-            break;
-
-        case 'A':
-        case 'E':
-        case 'F':
-        case 'G':
-            if (isScanf) {
-                break; // these are not valid for scanf
-            }
-            // fallthrough
-        case 'a':
-        case 'f':
-        case 'e':
-        case 'g':
-            if (mod == "") {
-                addSigParam(FloatType::get(isScanf ? 32 : 64), isScanf);
-                n++;
-            }
-            else if (mod == "L") {
-                addSigParam(FloatType::get(128), isScanf);
-                n++;
-            }
-            else if (mod == "l" && isScanf) {
-                addSigParam(FloatType::get(64), true);
-                n++;
-            }
-            break;
-
-        case 'c':
-            if (mod == "") {
-                addSigParam(CharType::get(), isScanf);
-                n++;
-            }
-            else if (mod == "l") {
-                addSigParam(IntegerType::get(16, Sign::Signed), isScanf);
-                n++;
-            }
-            break;
-
-        case 's':
-            if (mod == "") {
-                addSigParam(ArrayType::get(CharType::get()), true);
-                n++;
-            }
-            else if (mod == "l") {
-                addSigParam(ArrayType::get(IntegerType::get(16, Sign::Signed)), true);
-                n++;
-            }
-            break;
-
-        case 'p':
-            if (mod == "") {
-                addSigParam(PointerType::get(VoidType::get()), isScanf);
-                n++;
-            }
-            break;
-
-        case 'n':
-            if (mod == "") {
-                addSigParam(IntegerType::get(32, Sign::Signed), true);
-                n++;
-            }
-            else if (mod == "hh") {
-                addSigParam(IntegerType::get(8, Sign::Signed), true);
-                n++;
-            }
-            else if (mod == "h") {
-                addSigParam(IntegerType::get(16, Sign::Signed), true);
-                n++;
-            }
-            else if (mod == "l") {
-                addSigParam(IntegerType::get(32, Sign::Signed), true);
-                n++;
-            }
-            else if (mod == "ll") {
-                addSigParam(IntegerType::get(64, Sign::Signed), true);
-                n++;
-            }
-            else if (mod == "j") {
-                addSigParam(IntegerType::get(32, Sign::Signed), true);
-                n++;
-            }
-            else if (mod == "z") { // size_t
-                addSigParam(IntegerType::get(STD_SIZE, Sign::Unsigned), true);
-                n++;
-            }
-            else if (mod == "t") { // ptrdiff_t
-                addSigParam(IntegerType::get(STD_SIZE, Sign::Signed), true);
-                n++;
-            }
-            break;
-
-        case '%': break;
-        }
+    for (const FormatParam &param : params) {
+        // The cached types are shared by all calls using the same format string
+        addSigParam(param.type->clone(), param.addPointer);
     }
 
-    return n;
+    return static_cast<int>(params.size());
 }
 
 
@@ -1425,7 +1224,7 @@ bool CallStatement::tryConvertToDirect()
     // assert((int)implicitArguments.size() == sig->getNumImplicitParams());
 
     // 3b
-    m_signature = p->getSignature()->clone();
+    useSignatureOf(p);
 
     // 4
     m_isComputed = false;
@@ -1459,6 +1258,7 @@ bool CallStatement::doObjCEllipsisProcessing(const QString &formatStr)
             }
 
             setNumArguments(format + n);
+            specializeSignature();
             m_signature->setHasEllipsis(false); // So we don't do this again
             return true;
         }
@@ -1498,6 +1298,7 @@ void CallStatement::addSigParam(SharedType ty, bool isScanf)
         ty = PointerType::get(ty);
     }
 
+    specializeSignature();
     m_signature->addParameter(nullptr, ty);
     SharedExp paramExp = m_signature->getParamExp(m_signature->getNumParams() - 1);
 
@@ -1509,6 +1310,30 @@ void CallStatement::addSigParam(SharedType ty, bool isScanf)
 }
 
 
+void CallStatement::useSignatureOf(const Function *callee)
+{
+    if (callee->isLib()) {
+        // Signatures of library functions do not change, so all calls can share them
+        // until a call needs a different signature, e.g. by doEllipsisProcessing()
+        setSignature(callee->getSignature());
+    }
+    else {
+        // The signature of a user procedure changes during its decompilation
+        m_signature              = callee->getSignature()->clone();
+        m_isSignatureSpecialized = true;
+    }
+}
+
+
+void CallStatement::specializeSignature()
+{
+    if (m_signature && !m_isSignatureSpecialized) {
+        m_signature              = m_signature->clone();
+        m_isSignatureSpecialized = true;
+    }
+}
+
+
 std::shared_ptr<Assign> CallStatement::makeArgAssign(SharedType ty, SharedExp e)
 {
     SharedExp lhs = e->clone();
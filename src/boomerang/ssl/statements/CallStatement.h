@@ -65,14 +65,18 @@ public:
     /// \copydoc Statement::definesLoc
     bool definesLoc(SharedExp loc) const override; // True if this Statement defines loc
 
+    using Statement::search;
+    using Statement::searchAll;
+    using Statement::searchAndReplace;
+
     /// \copydoc GotoStatement::search
-    bool search(const Exp &search, SharedExp &result) const override;
+    bool search(const ExpPattern &search, SharedExp &result) const override;
 
     /// \copydoc GotoStatement::searchAll
-    bool searchAll(const Exp &search, std::list<SharedExp> &result) const override;
+    bool searchAll(const ExpPattern &search, std::list<SharedExp> &result) const override;
 
     /// \copydoc GotoStatement::searchAndReplace
-    bool searchAndReplace(const Exp &search, SharedExp replace, bool cc = false) override;
+    bool searchAndReplace(const ExpPattern &search, SharedExp replace, bool cc = false) override;
 
     /// \copydoc GotoStatement::simplify
     void simplify() override;
@@ -144,8 +148,13 @@ public:
 
     bool isCallToMemOffset() const;
 
+    /// \returns the signature of this call. The signature might be shared with the callee
+    /// and other calls, so it must not be modified.
     std::shared_ptr<Signature> getSignature() { return m_signature; }
-    void setSignature(const std::shared_ptr<Signature> &sig) { m_signature = sig; }
+
+    /// Set the signature of this call. \p sig is not modified by this call;
+    /// it is copied before it is specialized (e.g. by ellipsis processing).
+    void setSignature(const std::shared_ptr<Signature> &sig);
 
 public:
     /// \returns pointer to the def collector object
@@ -241,6 +250,13 @@ private:
     /// If addPointer is true, add type 'ty *' to the signature instead of type 'ty'
     void addSigParam(SharedType ty, bool addPointer);
 
+    /// Set the signature of this call to the signature of \p callee.
+    /// Signatures of library functions are shared, other signatures are copied.
+    void useSignatureOf(const Function *callee);
+
+    /// Replace a signature shared with other calls by a private copy before modifying it.
+    void specializeSignature();
+
     /// Make an assign suitable for use as an argument from a callee context expression
     std::shared_ptr<Assign> makeArgAssign(SharedType ty, SharedExp e);
 
@@ -263,10 +279,12 @@ private:
     /// this will be nullptr
     Function *m_procDest = nullptr;
 
-    /// The signature for this call.
+    /// The signature for this call. It is shared with the callee
+    /// until this call needs a signature of its own (\sa specializeSignature).
     /// \note this used to be stored in the Proc, but this does not make sense
     /// when the proc happens to have varargs
     std::shared_ptr<Signature> m_signature;
+    bool m_isSignatureSpecialized = false; ///< true if m_signature is owned by this call
 
     /// A UseCollector object to collect the live variables at this call.
     /// Used as part of the calculation of results
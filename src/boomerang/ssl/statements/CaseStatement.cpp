@@ -71,7 +71,7 @@ void CaseStatement::setSwitchInfo(std::unique_ptr<SwitchInfo> psi)
 }
 
 
-bool CaseStatement::searchAndReplace(const Exp &pattern, SharedExp replace, bool cc)
+bool CaseStatement::searchAndReplace(const ExpPattern &pattern, SharedExp replace, bool cc)
 {
     bool ch  = GotoStatement::searchAndReplace(pattern, replace, cc);
     bool ch2 = false;
@@ -84,7 +84,7 @@ bool CaseStatement::searchAndReplace(const Exp &pattern, SharedExp replace, bool
 }
 
 
-bool CaseStatement::searchAll(const Exp &pattern, std::list<SharedExp> &result) const
+bool CaseStatement::searchAll(const ExpPattern &pattern, std::list<SharedExp> &result) const
 {
     return GotoStatement::searchAll(pattern, result) ||
            (m_switchInfo && m_switchInfo->switchExp &&
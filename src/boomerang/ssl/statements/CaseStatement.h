@@ -12,6 +12,8 @@
 
 #include "boomerang/ssl/statements/GotoStatement.h"
 
+#include <vector>
+
 
 enum class SwitchType : char
 {
@@ -30,22 +32,14 @@ enum class SwitchType : char
 struct SwitchInfo
 {
 public:
-    ~SwitchInfo()
-    {
-        if (switchType == SwitchType::F) {
-            int *arr = reinterpret_cast<int *>(tableAddr.value());
-            delete[] arr;
-        }
-    }
-
-public:
-    SharedExp switchExp;   ///< Expression to switch on, e.g. v[7]
-    SwitchType switchType; ///< Switch type: 'A', 'O', 'R', 'H', or 'F' etc
-    int lowerBound;        ///< Lower bound of the switch variable
-    int upperBound;        ///< Upper bound for the switch variable
-    Address tableAddr;     ///< Native address of the table, or ptr to array of values for form F
-    int numTableEntries;   ///< Number of entries in the table (form H only)
-    int offsetFromJumpTbl = 0; ///< Distance from jump to table (form R only)
+    SharedExp switchExp;         ///< Expression to switch on, e.g. v[7]
+    SwitchType switchType;       ///< Switch type: 'A', 'O', 'R', 'H', or 'F' etc
+    int lowerBound;              ///< Lower bound of the switch variable
+    int upperBound;              ///< Upper bound for the switch variable
+    Address tableAddr;           ///< Native address of the table (invalid for form F)
+    int numTableEntries;         ///< Number of entries in the table (form H only)
+    int offsetFromJumpTbl = 0;   ///< Distance from jump to table (form R only)
+    std::vector<int> destValues; ///< Values of the switch expression (form F only)
 };
 
 
@@ -84,11 +78,14 @@ public:
     /// \copydoc GotoStatement::print
     void print(OStream &os) const override;
 
+    using Statement::searchAll;
+    using Statement::searchAndReplace;
+
     /// \copydoc GotoStatement::searchAndReplace
-    bool searchAndReplace(const Exp &search, SharedExp replace, bool cc = false) override;
+    bool searchAndReplace(const ExpPattern &search, SharedExp replace, bool cc = false) override;
 
     /// \copydoc GotoStatement::searchAll
-    bool searchAll(const Exp &search, std::list<SharedExp> &result) const override;
+    bool searchAll(const ExpPattern &search, std::list<SharedExp> &result) const override;
 
     /// \copydoc GotoStatement::simplify
     void simplify() override;
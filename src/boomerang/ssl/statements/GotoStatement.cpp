@@ -74,13 +74,13 @@ const SharedExp GotoStatement::getDest() const
 }
 
 
-bool GotoStatement::search(const Exp &pattern, SharedExp &result) const
+bool GotoStatement::search(const ExpPattern &pattern, SharedExp &result) const
 {
     return m_dest->search(pattern, result);
 }
 
 
-bool GotoStatement::searchAndReplace(const Exp &pattern, SharedExp replace, bool /*cc*/)
+bool GotoStatement::searchAndReplace(const ExpPattern &pattern, SharedExp replace, bool /*cc*/)
 {
     bool change = false;
     m_dest      = m_dest->searchReplaceAll(pattern, replace, change);
@@ -89,7 +89,7 @@ bool GotoStatement::searchAndReplace(const Exp &pattern, SharedExp replace, bool
 }
 
 
-bool GotoStatement::searchAll(const Exp &pattern, std::list<SharedExp> &result) const
+bool GotoStatement::searchAll(const ExpPattern &pattern, std::list<SharedExp> &result) const
 {
     return m_dest->searchAll(pattern, result);
 }
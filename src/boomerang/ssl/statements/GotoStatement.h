@@ -83,14 +83,18 @@ public:
     /// \copydoc Statement::print
     void print(OStream &os) const override;
 
+    using Statement::search;
+    using Statement::searchAll;
+    using Statement::searchAndReplace;
+
     /// \copydoc Statement::search
-    bool search(const Exp &pattern, SharedExp &result) const override;
+    bool search(const ExpPattern &pattern, SharedExp &result) const override;
 
     /// \copydoc Statement::searchAndReplace
-    bool searchAll(const Exp &search, std::list<SharedExp> &result) const override;
+    bool searchAll(const ExpPattern &search, std::list<SharedExp> &result) const override;
 
     /// \copydoc Statement::searchAndReplace
-    bool searchAndReplace(const Exp &pattern, SharedExp replace, bool cc = false) override;
+    bool searchAndReplace(const ExpPattern &pattern, SharedExp replace, bool cc = false) override;
 
     // simplify all the uses/defs in this Statement
     void simplify() override;
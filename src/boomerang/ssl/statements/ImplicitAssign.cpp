@@ -65,19 +65,19 @@ void ImplicitAssign::printCompact(OStream &os) const
 }
 
 
-bool ImplicitAssign::search(const Exp &pattern, SharedExp &result) const
+bool ImplicitAssign::search(const ExpPattern &pattern, SharedExp &result) const
 {
     return m_lhs->search(pattern, result);
 }
 
 
-bool ImplicitAssign::searchAll(const Exp &pattern, std::list<SharedExp> &result) const
+bool ImplicitAssign::searchAll(const ExpPattern &pattern, std::list<SharedExp> &result) const
 {
     return m_lhs->searchAll(pattern, result);
 }
 
 
-bool ImplicitAssign::searchAndReplace(const Exp &pattern, SharedExp replace, bool cc)
+bool ImplicitAssign::searchAndReplace(const ExpPattern &pattern, SharedExp replace, bool cc)
 {
     Q_UNUSED(cc);
     bool change;
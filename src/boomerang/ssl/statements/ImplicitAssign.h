@@ -36,14 +36,18 @@ public:
     /// \copydoc Statement::clone
     SharedStmt clone() const override;
 
+    using Statement::search;
+    using Statement::searchAll;
+    using Statement::searchAndReplace;
+
     /// \copydoc Statement::search
-    bool search(const Exp &search, SharedExp &result) const override;
+    bool search(const ExpPattern &search, SharedExp &result) const override;
 
     /// \copydoc Statement::searchAll
-    bool searchAll(const Exp &search, std::list<SharedExp> &result) const override;
+    bool searchAll(const ExpPattern &search, std::list<SharedExp> &result) const override;
 
     /// \copydoc Statement::searchAndReplace
-    bool searchAndReplace(const Exp &search, SharedExp replace, bool cc = false) override;
+    bool searchAndReplace(const ExpPattern &search, SharedExp replace, bool cc = false) override;
 
     /// \copydoc Statement::printCompact
     void printCompact(OStream &os) const override;
@@ -82,7 +82,7 @@ void PhiAssign::printCompact(OStream &os) const
 }
 
 
-bool PhiAssign::search(const Exp &pattern, SharedExp &result) const
+bool PhiAssign::search(const ExpPattern &pattern, SharedExp &result) const
 {
     if (m_lhs->search(pattern, result)) {
         return true;
@@ -100,7 +100,7 @@ bool PhiAssign::search(const Exp &pattern, SharedExp &result) const
 }
 
 
-bool PhiAssign::searchAll(const Exp &pattern, std::list<SharedExp> &result) const
+bool PhiAssign::searchAll(const ExpPattern &pattern, std::list<SharedExp> &result) const
 {
     // FIXME: is this the right semantics for searching a phi statement,
     // disregarding the RHS?
@@ -108,7 +108,7 @@ bool PhiAssign::searchAll(const Exp &pattern, std::list<SharedExp> &result) cons
 }
 
 
-bool PhiAssign::searchAndReplace(const Exp &pattern, SharedExp replace, bool /*cc*/)
+bool PhiAssign::searchAndReplace(const ExpPattern &pattern, SharedExp replace, bool /*cc*/)
 {
     bool change = false;
 
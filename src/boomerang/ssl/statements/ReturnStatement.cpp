@@ -96,7 +96,7 @@ bool ReturnStatement::definesLoc(SharedExp loc) const
 }
 
 
-bool ReturnStatement::search(const Exp &pattern, SharedExp &result) const
+bool ReturnStatement::search(const ExpPattern &pattern, SharedExp &result) const
 {
     result = nullptr;
 
@@ -110,7 +110,7 @@ bool ReturnStatement::search(const Exp &pattern, SharedExp &result) const
 }
 
 
-bool ReturnStatement::searchAll(const Exp &pattern, std::list<SharedExp> &result) const
+bool ReturnStatement::searchAll(const ExpPattern &pattern, std::list<SharedExp> &result) const
 {
     bool found = false;
 
@@ -124,7 +124,7 @@ bool ReturnStatement::searchAll(const Exp &pattern, std::list<SharedExp> &result
 }
 
 
-bool ReturnStatement::searchAndReplace(const Exp &pattern, SharedExp replace, bool cc)
+bool ReturnStatement::searchAndReplace(const ExpPattern &pattern, SharedExp replace, bool cc)
 {
     bool change = false;
 
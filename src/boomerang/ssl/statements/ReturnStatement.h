@@ -53,14 +53,18 @@ public:
     /// \copydoc Statement::definesLoc
     bool definesLoc(SharedExp loc) const override;
 
+    using Statement::search;
+    using Statement::searchAll;
+    using Statement::searchAndReplace;
+
     /// \copydoc Statement::search
-    bool search(const Exp &, SharedExp &) const override;
+    bool search(const ExpPattern &, SharedExp &) const override;
 
     /// \copydoc Statement::searchAll
-    bool searchAll(const Exp &search, std::list<SharedExp> &result) const override;
+    bool searchAll(const ExpPattern &search, std::list<SharedExp> &result) const override;
 
     /// \copydoc Statement::searchAndReplace
-    bool searchAndReplace(const Exp &search, SharedExp replace, bool cc = false) override;
+    bool searchAndReplace(const ExpPattern &search, SharedExp replace, bool cc = false) override;
 
     /// \copydoc Statement::getTypeForExp
     SharedConstType getTypeForExp(SharedConstExp exp) const override;
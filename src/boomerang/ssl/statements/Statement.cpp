@@ -15,6 +15,7 @@
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/ssl/exp/Binary.h"
 #include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/ExpPattern.h"
 #include "boomerang/ssl/exp/Location.h"
 #include "boomerang/ssl/exp/RefExp.h"
 #include "boomerang/ssl/statements/Assign.h"
@@ -25,9 +26,11 @@
 #include "boomerang/visitor/stmtexpvisitor/UsedLocsVisitor.h"
 #include "boomerang/visitor/stmtmodifier/StmtPartModifier.h"
 
+#include <atomic>
+
 
 SharedStmt Statement::wild = SharedStmt(new Assign(Terminal::get(opNil), Terminal::get(opNil)));
-static uint32 m_nextStmtID = 0;
+static std::atomic<uint32> m_nextStmtID{ 0 }; // statements are created on several threads
 
 
 Statement::Statement(StmtType kind)
@@ -142,6 +145,24 @@ QString Statement::toString() const
 }
 
 
+bool Statement::search(const Exp &pattern, SharedExp &result) const
+{
+    return search(ExpPattern(pattern), result);
+}
+
+
+bool Statement::searchAll(const Exp &pattern, std::list<SharedExp> &result) const
+{
+    return searchAll(ExpPattern(pattern), result);
+}
+
+
+bool Statement::searchAndReplace(const Exp &pattern, SharedExp replacement, bool changeCols)
+{
+    return searchAndReplace(ExpPattern(pattern), replacement, changeCols);
+}
+
+
 bool Statement::canPropagateToExp(const Exp &exp)
 {
     if (!exp.isSubscript()) {
@@ -285,6 +306,9 @@ bool Statement::replaceRef(SharedExp e, const std::shared_ptr<Assignment> &def)
     // Could be propagating %flags into %CF
     SharedExp lhs = def->getLeft();
 
+    // e is base{def}. Compile it once for all replacements below.
+    const ExpPattern pattern(*e);
+
     /* When one of the main flags is used bare, and was defined via a flag function,
      * apply the semantics for it. For example, the x86 'sub lhs, rhs' instruction effectively
      * sets the CF flag to 'lhs <u rhs'.
@@ -310,7 +334,7 @@ bool Statement::replaceRef(SharedExp e, const std::shared_ptr<Assignment> &def)
         }
         else if (rhs->isIntConst() && *lhs != *rhs) {
             // e.g. %flags := 0
-            searchAndReplace(*e, rhs, true);
+            searchAndReplace(pattern, rhs, true);
             return true;
         }
         else if (!rhs->isFlagCall()) {
@@ -325,14 +349,14 @@ bool Statement::replaceRef(SharedExp e, const std::shared_ptr<Assignment> &def)
                 // for float cf we'll replace the CF with (P1<P2)
                 SharedExp replacement = Binary::get(opLess, rhs->access<Exp, 2, 1>(),
                                                     rhs->access<Exp, 2, 2, 1>());
-                searchAndReplace(*RefExp::get(Terminal::get(opCF), def), replacement, true);
+                searchAndReplace(pattern, replacement, true);
                 return true;
             }
             case opZF: {
                 // for float zf we'll replace the ZF with (P1==P2)
                 SharedExp replacement = Binary::get(opEquals, rhs->access<Exp, 2, 1>(),
                                                     rhs->access<Exp, 2, 2, 1>());
-                searchAndReplace(*RefExp::get(Terminal::get(opZF), def), replacement, true);
+                searchAndReplace(pattern, replacement, true);
                 return true;
             }
 
@@ -347,19 +371,19 @@ bool Statement::replaceRef(SharedExp e, const std::shared_ptr<Assignment> &def)
             switch (base->getOper()) {
             case opCF: {
                 const SharedExp replacement = Binary::get(opLessUns, subLhs, subRhs);
-                searchAndReplace(*RefExp::get(Terminal::get(opCF), def), replacement, true);
+                searchAndReplace(pattern, replacement, true);
                 return true;
             }
             case opZF: {
                 // for zf we only want to check if the result part of the subflags is equal to zero
                 const SharedExp replacement = Binary::get(opEquals, subResult, Const::get(0));
-                searchAndReplace(*RefExp::get(Terminal::get(opZF), def), replacement, true);
+                searchAndReplace(pattern, replacement, true);
                 return true;
             }
             case opNF: {
                 // for sf we only want to check if the result part of the subflags is less than zero
                 const SharedExp replacement = Binary::get(opLess, subResult, Const::get(0));
-                searchAndReplace(*RefExp::get(Terminal::get(opNF), def), replacement, true);
+                searchAndReplace(pattern, replacement, true);
                 return true;
             }
             case opOF: {
@@ -374,7 +398,7 @@ bool Statement::replaceRef(SharedExp e, const std::shared_ptr<Assignment> &def)
                                 Binary::get(opAnd, Binary::get(opGtrEq, subLhs, Const::get(0)),
                                             Binary::get(opLess, subRhs, Const::get(0))),
                                 Binary::get(opLess, subResult, Const::get(0))));
-                searchAndReplace(*RefExp::get(Terminal::get(opOF), def), replacement, true);
+                searchAndReplace(pattern, replacement, true);
                 return true;
             }
             default: break;
@@ -385,22 +409,22 @@ bool Statement::replaceRef(SharedExp e, const std::shared_ptr<Assignment> &def)
             switch (base->getOper()) {
             case opNF: {
                 SharedExp replacement = Binary::get(opLess, param, Const::get(0));
-                searchAndReplace(*RefExp::get(Terminal::get(opNF), def), replacement, true);
+                searchAndReplace(pattern, replacement, true);
                 return true;
             }
             case opZF: {
                 SharedExp replacement = Binary::get(opEquals, param, Const::get(0));
-                searchAndReplace(*RefExp::get(Terminal::get(opZF), def), replacement, true);
+                searchAndReplace(pattern, replacement, true);
                 return true;
             }
             case opCF: {
                 SharedExp replacement = Const::get(0);
-                searchAndReplace(*RefExp::get(Terminal::get(opCF), def), replacement, true);
+                searchAndReplace(pattern, replacement, true);
                 return true;
             }
             case opOF: {
                 const SharedExp replacement = Const::get(0);
-                searchAndReplace(*RefExp::get(Terminal::get(opOF), def), replacement, true);
+                searchAndReplace(pattern, replacement, true);
                 return true;
             }
             default: break;
@@ -411,17 +435,17 @@ bool Statement::replaceRef(SharedExp e, const std::shared_ptr<Assignment> &def)
             switch (base->getOper()) {
             case opOF: {
                 const SharedExp replacement = Const::get(0);
-                searchAndReplace(*RefExp::get(Terminal::get(opOF), def), replacement, true);
+                searchAndReplace(pattern, replacement, true);
                 return true;
             }
             case opZF: {
                 const SharedExp replacement = Binary::get(opEquals, param, Const::get(0));
-                searchAndReplace(*RefExp::get(Terminal::get(opZF), def), replacement, true);
+                searchAndReplace(pattern, replacement, true);
                 return true;
             }
             case opNF: {
                 const SharedExp replacement = Binary::get(opLess, param, Const::get(0));
-                searchAndReplace(*RefExp::get(Terminal::get(opNF), def), replacement, true);
+                searchAndReplace(pattern, replacement, true);
                 return true;
             }
             default: break;
@@ -430,7 +454,7 @@ bool Statement::replaceRef(SharedExp e, const std::shared_ptr<Assignment> &def)
     }
 
     // do the replacement; last parameter true to also change collectors
-    return searchAndReplace(*e, rhs, true);
+    return searchAndReplace(pattern, rhs, true);
 }
 
 
@@ -20,9 +20,11 @@
 
 
 class IRFragment;
+class RTL;
 class Function;
 class UserProc;
 class Exp;
+class ExpPattern;
 class Type;
 class StmtVisitor;
 class StmtExpVisitor;
@@ -144,6 +146,10 @@ public:
     /// Changes the fragment that this statment is part of.
     void setFragment(IRFragment *frag) { m_fragment = frag; }
 
+    /// \returns the RTL this statement was last inserted into, or nullptr if it is not part
+    /// of any RTL. \sa RTL::find
+    RTL *getRTL() const { return m_rtl; }
+
     /// \returns the procedure this statement is part of.
     UserProc *getProc() const { return m_proc; }
 
@@ -228,7 +234,11 @@ public:
     /// Search for the expression \p pattern in this statement.
     /// If found, put the found expression into \p result and return true.
     /// Otherwise, return false.
-    virtual bool search(const Exp &pattern, SharedExp &result) const = 0;
+    bool search(const Exp &pattern, SharedExp &result) const;
+
+    /// \copydoc Statement::search
+    /// Use this overload when searching many statements for the same pattern.
+    virtual bool search(const ExpPattern &pattern, SharedExp &result) const = 0;
 
     /**
      * Find all instances of \p pattern and add all found expressions
@@ -239,7 +249,11 @@ public:
      *                  appended to it in reverse nesting order.
      * \returns true if there were any matches
      */
-    virtual bool searchAll(const Exp &pattern, std::list<SharedExp> &result) const = 0;
+    bool searchAll(const Exp &pattern, std::list<SharedExp> &result) const;
+
+    /// \copydoc Statement::searchAll
+    /// Use this overload when searching many statements for the same pattern.
+    virtual bool searchAll(const ExpPattern &pattern, std::list<SharedExp> &result) const = 0;
 
     /**
      * Replace all instances of \p pattern with \p replacement.
@@ -249,7 +263,11 @@ public:
      * \returns True if any change
      * \todo consider constness
      */
-    virtual bool searchAndReplace(const Exp &pattern, SharedExp replacement,
+    bool searchAndReplace(const Exp &pattern, SharedExp replacement, bool changeCols = false);
+
+    /// \copydoc Statement::searchAndReplace
+    /// Use this overload when searching many statements for the same pattern.
+    virtual bool searchAndReplace(const ExpPattern &pattern, SharedExp replacement,
                                   bool changeCols = false) = 0;
 
     /**
@@ -315,6 +333,14 @@ private:
     /// \returns true if change
     bool replaceRef(SharedExp e, const std::shared_ptr<Assignment> &def);
 
+private:
+    friend class RTL;
+
+    /// Position of this statement in the list of statements of m_rtl.
+    /// Maintained by RTL; not copied when the statement is copied.
+    RTL *m_rtl = nullptr;
+    std::list<SharedStmt>::iterator m_rtlPos;
+
 protected:
     IRFragment *m_fragment = nullptr; ///< contains a pointer to the enclosing fragment
     UserProc *m_proc       = nullptr; ///< procedure containing this statement
@@ -0,0 +1,304 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "StackFrameLayout.h"
+
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/db/signature/Signature.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/type/ArrayType.h"
+#include "boomerang/ssl/type/CompoundType.h"
+#include "boomerang/util/log/Log.h"
+
+#include <algorithm>
+
+
+static bool isUnboundedArray(const SharedType &ty)
+{
+    return ty->resolvesToArray() && ty->as<ArrayType>()->isUnbounded();
+}
+
+
+FrameSlot::FrameSlot(int _offset, QString _name, SharedType _type)
+    : offset(_offset)
+    , size(_type->getSizeInBytes())
+    , name(_name)
+    , type(_type)
+{
+}
+
+
+StackFrameLayout::StackFrameLayout(UserProc *proc)
+    : m_proc(proc)
+{
+}
+
+
+std::pair<StackFrameLayout::iterator, StackFrameLayout::iterator>
+StackFrameLayout::overlapping(sint64 lower, sint64 upper)
+{
+    // first slot starting at or after upper
+    iterator last = std::lower_bound(
+        m_slots.begin(), m_slots.end(), upper,
+        [](const FrameSlot &slot, sint64 off) { return slot.offset < off; });
+
+    // Slots do not overlap, so their ends are sorted as well.
+    iterator first = std::upper_bound(
+        m_slots.begin(), last, lower,
+        [](sint64 off, const FrameSlot &slot) { return off < slot.getEnd(); });
+
+    return { first, last };
+}
+
+
+std::pair<StackFrameLayout::const_iterator, StackFrameLayout::const_iterator>
+StackFrameLayout::overlapping(sint64 lower, sint64 upper) const
+{
+    return const_cast<StackFrameLayout *>(this)->overlapping(lower, upper);
+}
+
+
+bool StackFrameLayout::isClear(int offset, Type::Size size) const
+{
+    const_iterator first, last;
+    std::tie(first, last) = overlapping(offset, static_cast<sint64>(offset) + size);
+
+    // since we don't know the length of unbounded arrays (yet),
+    // it is possible that the array ends before offset.
+    return std::all_of(first, last, [](const FrameSlot &slot) { return isUnboundedArray(slot.type); });
+}
+
+
+const FrameSlot *StackFrameLayout::find(int offset) const
+{
+    const_iterator first, last;
+    std::tie(first, last) = overlapping(offset, static_cast<sint64>(offset) + 1);
+
+    return first != last ? &*first : nullptr;
+}
+
+
+const FrameSlot *StackFrameLayout::insertSlot(int offset, QString name, SharedType type,
+                                              bool forced)
+{
+    if (!type || type->getSizeInBytes() == 0) {
+        return nullptr;
+    }
+    else if (name.isEmpty()) {
+        name = "<noname>";
+    }
+
+    const FrameSlot newSlot(offset, name, type);
+
+    iterator first, last;
+    std::tie(first, last) = overlapping(newSlot.offset, newSlot.getEnd());
+
+    if (first == last) {
+        // not overlapped by any variable -> just insert directly
+        return &*m_slots.insert(first, newSlot);
+    }
+
+    FrameSlot &slot = *first;
+
+    if (slot.offset <= newSlot.offset && newSlot.getEnd() <= slot.getEnd()) {
+        if (slot.offset == newSlot.offset && slot.size == newSlot.size) {
+            // both types are of equal size
+            bool changed;
+            slot.type = slot.type->meetWith(type, changed);
+        }
+        else {
+            // new type may be part of an existing type
+            insertComponentType(slot, offset, type);
+        }
+
+        return &slot;
+    }
+    else if (newSlot.offset <= slot.offset && slot.getEnd() <= newSlot.getEnd()) {
+        // the new type is a larger/derived type which contains the old type
+        return replaceComponents(offset, name, type);
+    }
+    else if (forced) {
+        // the new and the old type do not completely overlap
+        clearRange(newSlot.offset, newSlot.getEnd());
+        std::tie(first, last) = overlapping(newSlot.offset, newSlot.getEnd());
+        return &*m_slots.insert(last, newSlot);
+    }
+
+    LOG_ERROR("TYPE ERROR: Cannot insert variable of type %1 at SP offset %2", type->getCtype(),
+              offset);
+    LOG_ERROR("TYPE ERROR: because it conflicts with variable of type %1 at SP offset %2",
+              slot.type->getCtype(), slot.offset);
+    return nullptr;
+}
+
+
+void StackFrameLayout::insertComponentType(FrameSlot &slot, int offset, SharedType type)
+{
+    assert(slot.offset <= offset);
+
+    if (slot.type->resolvesToCompound()) {
+        const uint64 bitOffset = static_cast<uint64>(offset - slot.offset) * 8;
+        SharedType memberType  = slot.type->as<CompoundType>()->getMemberTypeByOffset(bitOffset);
+
+        if (!memberType || !memberType->isCompatibleWith(*type)) {
+            LOG_ERROR("TYPE ERROR: At SP offset %1 type %2 is not compatible with existing "
+                      "structure type %3",
+                      offset, type->getCtype(), slot.type->getCtype());
+            return;
+        }
+
+        bool ch;
+        memberType = memberType->meetWith(type, ch);
+        slot.type->as<CompoundType>()->setMemberTypeByOffset(bitOffset, memberType);
+    }
+    else if (slot.type->resolvesToArray()) {
+        SharedType baseType = slot.type->as<ArrayType>()->getBaseType();
+        assert(baseType);
+
+        if (!baseType->isCompatibleWith(*type)) {
+            LOG_ERROR("TYPE ERROR: At SP offset %1 type %2 is not compatible with existing array "
+                      "member type %3",
+                      offset, type->getCtype(), baseType->getCtype());
+            return;
+        }
+
+        bool ch;
+        slot.type->as<ArrayType>()->setBaseType(baseType->meetWith(type, ch));
+    }
+    else {
+        LOG_ERROR("TYPE ERROR: Existing type at SP offset %1 is not structure or array type",
+                  slot.offset);
+    }
+}
+
+
+const FrameSlot *StackFrameLayout::replaceComponents(int offset, const QString &name,
+                                                     SharedType type)
+{
+    const sint64 endOffset = static_cast<sint64>(offset) + type->getSizeInBytes();
+
+    iterator first, last;
+    std::tie(first, last) = overlapping(offset, endOffset);
+
+    // First check that the new variable will be compatible with everything it will overlap
+    if (type->resolvesToCompound()) {
+        for (iterator it = first; it != last; ++it) {
+            const uint64 bitOffset = static_cast<uint64>(it->offset - offset) * 8;
+            SharedType memberType  = type->as<CompoundType>()->getMemberTypeByOffset(bitOffset);
+
+            if (!memberType || !memberType->isCompatibleWith(*it->type, true)) {
+                LOG_ERROR("TYPE ERROR: At SP offset %1 struct type %2 is not compatible with "
+                          "existing type %3",
+                          offset, type->getCtype(), it->type->getCtype());
+                return nullptr;
+            }
+
+            bool ch;
+            memberType = it->type->meetWith(memberType, ch);
+            type->as<CompoundType>()->setMemberTypeByOffset(bitOffset, memberType);
+        }
+    }
+    else if (type->resolvesToArray()) {
+        SharedType memberType = type->as<ArrayType>()->getBaseType();
+
+        for (iterator it = first; it != last; ++it) {
+            if (!memberType->isCompatibleWith(*it->type, true)) {
+                LOG_ERROR("TYPE ERROR: At SP offset %1 array type %2 is not compatible with "
+                          "existing type %3",
+                          offset, type->getCtype(), it->type->getCtype());
+                return nullptr;
+            }
+
+            bool ch;
+            memberType = memberType->meetWith(it->type, ch);
+            type->as<ArrayType>()->setBaseType(memberType);
+        }
+    }
+    else if (!isClear(offset, type->getSizeInBytes())) {
+        LOG_ERROR("TYPE ERROR: At SP offset %1, overlapping type %2 "
+                  "does not resolve to compound or array",
+                  offset, type->getCtype());
+        return nullptr;
+    }
+
+    // Existing locals in a new structure become members of the structure
+    if (m_proc && type->resolvesToCompound()) {
+        SharedExp rsp = Location::regOf(m_proc->getSignature()->getStackRegister());
+        auto rsp0     = RefExp::get(rsp, m_proc->getCFG()->findTheImplicitAssign(rsp)); // sp{0}
+        auto compound = type->as<CompoundType>();
+
+        SharedExp s = Location::memOf(Binary::get(opPlus, rsp0->clone(), Const::get(offset)));
+        s->simplifyArith();
+
+        for (iterator it = first; it != last; ++it) {
+            SharedExp locl = Location::memOf(
+                Binary::get(opPlus, rsp0->clone(), Const::get(it->offset)));
+            locl->simplifyArith(); // Convert m[sp{0} + -4] to m[sp{0} - 4]
+
+            const uint64 bitOffset = static_cast<uint64>(it->offset - offset) * 8;
+            const QString locName  = m_proc->findLocal(locl, compound->getMemberTypeByOffset(
+                                                                bitOffset));
+
+            if (!locName.isEmpty()) {
+                // want s.m where s is the new compound object and m is the member at bitOffset
+                const QString memName = compound->getMemberNameByOffset(bitOffset);
+                m_proc->mapSymbolTo(locl, Binary::get(opMemberAccess, s, Const::get(memName)));
+            }
+        }
+    }
+
+    // The compound or array type is compatible. Replace the variables it overlaps.
+    first = m_slots.erase(first, last);
+    return &*m_slots.insert(first, FrameSlot(offset, name, type));
+}
+
+
+void StackFrameLayout::clearRange(sint64 lower, sint64 upper)
+{
+    iterator first, last;
+    std::tie(first, last) = overlapping(lower, upper);
+
+    // Only the first variable can start before the range.
+    if (first != last && first->offset < lower && isUnboundedArray(first->type)) {
+        // unbounded array -> just adjust the length of the array
+        // to not overlap with the range
+        auto arrayType             = first->type->as<ArrayType>();
+        const Type::Size elemBytes = arrayType->getBaseType()->getSizeInBytes();
+        const uint64 numElems = elemBytes > 0 ? static_cast<uint64>(lower - first->offset) / elemBytes
+                                              : 0;
+
+        if (numElems > 0) {
+            LOG_VERBOSE("Adjusting size of unbounded array at SP offset %1 to %2 bytes",
+                        first->offset, numElems * elemBytes);
+            arrayType->setLength(numElems);
+            first->size = numElems * elemBytes;
+            ++first;
+        }
+    }
+
+    // types are in the way -> just delete them
+    m_slots.erase(first, last);
+}
+
+
+QString StackFrameLayout::toString() const
+{
+    QString tgt;
+    OStream ost(&tgt);
+
+    for (const FrameSlot &slot : m_slots) {
+        ost << slot.offset << ".." << QString::number(slot.getEnd()) << " " << slot.name << " "
+            << slot.type->getCtype() << "\n";
+    }
+
+    return tgt;
+}
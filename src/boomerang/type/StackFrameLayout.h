@@ -0,0 +1,118 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/ssl/type/Type.h"
+
+#include <QString>
+
+#include <vector>
+
+
+class UserProc;
+
+
+/// A local variable in the stack frame of a procedure.
+struct FrameSlot
+{
+    FrameSlot(int _offset, QString _name, SharedType _type);
+
+    /// \returns the SP offset of the first byte after the variable
+    sint64 getEnd() const { return static_cast<sint64>(offset) + size; }
+
+    /// \returns true if the variable contains the byte at SP offset \p off
+    bool contains(sint64 off) const { return offset <= off && off < getEnd(); }
+
+    int offset;      ///< SP offset of the variable (from sp{0})
+    Type::Size size; ///< The size of the variable in bytes
+    QString name;    ///< The name of the variable
+    SharedType type; ///< The type of the variable
+};
+
+
+/**
+ * Layout of the local variables in the stack frame of a procedure.
+ *
+ * This is the counterpart of DataIntervalMap for stack locals: When a new variable overlaps
+ * existing ones, the types are reconciled the same way (the smaller type becomes a member of the
+ * larger structure or array type, or the types are met if both have the same size).
+ *
+ * Stack frames are small and dense, so instead of a node based interval map the slots are kept
+ * in a flat array sorted by SP offset. Since slots never overlap, the slot containing an offset
+ * is found by binary search, and merging or splitting variables only erases a contiguous range
+ * of the array. Offsets are signed, so variables that end exactly at sp{0} are represented
+ * correctly.
+ *
+ * \note Pointers to slots are invalidated by any modification of the layout.
+ */
+class BOOMERANG_API StackFrameLayout
+{
+public:
+    typedef std::vector<FrameSlot>::const_iterator const_iterator;
+
+public:
+    /// \param proc The user proc for which the stack variables are determined.
+    /// Required to rename existing locals that become members of a structure.
+    StackFrameLayout(UserProc *proc = nullptr);
+
+    const_iterator begin() const { return m_slots.begin(); }
+    const_iterator end() const { return m_slots.end(); }
+
+public:
+    UserProc *getProc() const { return m_proc; }
+
+    /// \returns the number of variables in the stack frame.
+    int getNumSlots() const { return static_cast<int>(m_slots.size()); }
+
+    /// \returns true iff the range [offset; offset+size) does not contain a variable.
+    /// Unbounded arrays do not block the range since their real size is not known yet.
+    bool isClear(int offset, Type::Size size) const;
+
+    /// \returns the variable that contains the byte at SP offset \p offset,
+    /// or nullptr if no such variable exists.
+    const FrameSlot *find(int offset) const;
+
+    /**
+     * Insert a new variable into the stack frame.
+     * If the space of the new variable is occupied, insertion fails unless \p forced is set to
+     * true. If \p forced is true, existing variables are erased or truncated to make room
+     * for the new variable. Types without size are not recorded.
+     *
+     * \returns the variable containing the new variable, or nullptr if insertion failed.
+     */
+    const FrameSlot *insertSlot(int offset, QString name, SharedType type, bool forced = false);
+
+    /// For test and debug
+    QString toString() const;
+
+private:
+    typedef std::vector<FrameSlot>::iterator iterator;
+
+    /// \returns the range of variables overlapping [lower; upper)
+    std::pair<iterator, iterator> overlapping(sint64 lower, sint64 upper);
+    std::pair<const_iterator, const_iterator> overlapping(sint64 lower, sint64 upper) const;
+
+    /// The new variable is part of the larger variable \p slot.
+    /// Check for compatibility, meet if necessary.
+    void insertComponentType(FrameSlot &slot, int offset, SharedType type);
+
+    /// The new structure or array contains existing variables. Check for compatibility,
+    /// and merge the existing variables into the new one.
+    const FrameSlot *replaceComponents(int offset, const QString &name, SharedType type);
+
+    /// Erase all variables intersecting [lower; upper),
+    /// and truncate unbounded arrays starting before \p lower.
+    void clearRange(sint64 lower, sint64 upper);
+
+private:
+    std::vector<FrameSlot> m_slots; ///< sorted by offset, never overlapping
+    UserProc *m_proc;
+};
@@ -0,0 +1,129 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+
+ThreadPool::ThreadPool(int numThreads)
+{
+    if (numThreads <= 0) {
+        numThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    for (int i = 1; i < numThreads; i++) {
+        m_workers.emplace_back(&ThreadPool::run, this);
+    }
+}
+
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_wakeWorkers.notify_all();
+
+    for (std::thread &worker : m_workers) {
+        worker.join();
+    }
+}
+
+
+void ThreadPool::forEach(std::size_t numTasks, const Task &task)
+{
+    if (numTasks == 0) {
+        return;
+    }
+    else if (m_workers.empty() || numTasks == 1) {
+        for (std::size_t i = 0; i < numTasks; i++) {
+            task(i);
+        }
+
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task      = &task;
+        m_numTasks  = numTasks;
+        m_numActive = static_cast<int>(m_workers.size());
+        m_nextTask  = 0;
+        m_batch++;
+    }
+
+    m_wakeWorkers.notify_all();
+    runTasks(task, numTasks);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_batchDone.wait(lock, [this]() { return m_numActive == 0; });
+    m_task = nullptr;
+
+    if (m_error) {
+        std::exception_ptr error = m_error;
+        m_error                  = nullptr;
+        lock.unlock();
+        std::rethrow_exception(error);
+    }
+}
+
+
+void ThreadPool::run()
+{
+    uint64 lastBatch = 0;
+
+    while (true) {
+        const Task *task     = nullptr;
+        std::size_t numTasks = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeWorkers.wait(lock,
+                               [this, lastBatch]() { return m_stop || m_batch != lastBatch; });
+
+            if (m_stop) {
+                return;
+            }
+
+            lastBatch = m_batch;
+            task      = m_task;
+            numTasks  = m_numTasks;
+        }
+
+        runTasks(*task, numTasks);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_numActive == 0) {
+            m_batchDone.notify_all();
+        }
+    }
+}
+
+
+void ThreadPool::runTasks(const Task &task, std::size_t numTasks)
+{
+    std::size_t i;
+    while ((i = m_nextTask.fetch_add(1)) < numTasks) {
+        try {
+            task(i);
+        }
+        catch (...) {
+            // Do not start any more tasks of this batch
+            m_nextTask = numTasks;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_error) {
+                m_error = std::current_exception();
+            }
+        }
+    }
+}
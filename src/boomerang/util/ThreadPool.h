@@ -0,0 +1,81 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/util/Types.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/**
+ * A fixed set of worker threads running batches of independent tasks.
+ *
+ * Tasks of a batch are identified by their index. Tasks are scheduled dynamically,
+ * so callers that need deterministic results should store the result of each task
+ * in its own slot and combine the results in index order afterwards.
+ */
+class BOOMERANG_API ThreadPool
+{
+public:
+    typedef std::function<void(std::size_t)> Task;
+
+public:
+    /// \param numThreads Number of threads running tasks, including the thread calling
+    /// \ref forEach (0 = number of hardware threads). With 1, all tasks are run serially.
+    explicit ThreadPool(int numThreads = 0);
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool(ThreadPool &&)      = delete;
+
+    ~ThreadPool();
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    ThreadPool &operator=(ThreadPool &&) = delete;
+
+public:
+    /// Run \p task for all indices in [0, numTasks) and wait until all of them are done.
+    /// The calling thread runs tasks as well. Must not be called from within a task.
+    /// If a task throws, no further tasks are started; the first exception is rethrown
+    /// after all running tasks have finished.
+    void forEach(std::size_t numTasks, const Task &task);
+
+    int getNumThreads() const { return static_cast<int>(m_workers.size()) + 1; }
+
+private:
+    /// Main loop of the worker threads
+    void run();
+
+    /// Run tasks of the current batch until there are none left.
+    void runTasks(const Task &task, std::size_t numTasks);
+
+private:
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeWorkers;
+    std::condition_variable m_batchDone;
+
+    // Current batch; protected by m_mutex
+    const Task *m_task     = nullptr;
+    std::size_t m_numTasks = 0;
+    uint64 m_batch         = 0; ///< Number of batches started so far
+    int m_numActive        = 0; ///< Number of workers still working on the current batch
+    bool m_stop            = false;
+    std::exception_ptr m_error; ///< First exception thrown by a task of the current batch
+
+    std::atomic<std::size_t> m_nextTask{ 0 }; ///< Index of the next task to run
+};
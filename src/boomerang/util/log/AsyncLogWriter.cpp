@@ -0,0 +1,146 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "AsyncLogWriter.h"
+
+#include <cassert>
+
+
+static std::atomic<int> g_nextWriterID(0);
+
+
+AsyncLogWriter::AsyncLogWriter(RecordHandler onRecord, IdleHandler onIdle, std::size_t bufferSize)
+    : m_id(g_nextWriterID++)
+    , m_onRecord(std::move(onRecord))
+    , m_onIdle(std::move(onIdle))
+    , m_bufferSize(bufferSize)
+    , m_numPushed(0)
+    , m_numWritten(0)
+    , m_numFlushed(0)
+    , m_numDropped(0)
+    , m_stop(false)
+    , m_thread(&AsyncLogWriter::run, this)
+{
+    assert(m_onRecord);
+}
+
+
+AsyncLogWriter::~AsyncLogWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stop = true;
+    }
+
+    m_wakeWriter.notify_one();
+    m_thread.join();
+}
+
+
+void AsyncLogWriter::push(LogRecord &&record, bool mayDrop)
+{
+    LogRingBuffer *buffer = getThreadBuffer();
+
+    while (!buffer->tryPush(record)) {
+        if (mayDrop) {
+            m_numDropped++;
+            return;
+        }
+
+        // Back-pressure: wait for the writer thread to make room
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wakeWriter.notify_one();
+        m_wakeProducers.wait_for(lock, std::chrono::milliseconds(1));
+    }
+
+    m_numPushed++;
+
+    // Not synchronized with the writer on purpose; if the notification is missed,
+    // the writer wakes up by itself shortly.
+    m_wakeWriter.notify_one();
+}
+
+
+void AsyncLogWriter::flush()
+{
+    const uint64 target = m_numPushed.load();
+
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    while (m_numFlushed.load() < target) {
+        m_wakeWriter.notify_one();
+        m_wakeProducers.wait_for(lock, std::chrono::milliseconds(1));
+    }
+}
+
+
+LogRingBuffer *AsyncLogWriter::getThreadBuffer()
+{
+    // Cache of the buffer of this thread. Writers are identified by ID instead of
+    // by address, since a new writer might be allocated at the address of an old one.
+    thread_local int cachedID             = -1;
+    thread_local LogRingBuffer *cachedBuf = nullptr;
+
+    if (cachedID != m_id) {
+        std::lock_guard<std::mutex> lock(m_buffersMutex);
+        m_buffers.emplace_back(new LogRingBuffer(m_bufferSize));
+
+        cachedID  = m_id;
+        cachedBuf = m_buffers.back().get();
+    }
+
+    return cachedBuf;
+}
+
+
+void AsyncLogWriter::run()
+{
+    while (true) {
+        if (drain()) {
+            continue;
+        }
+
+        if (m_onIdle) {
+            m_onIdle();
+        }
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_numFlushed = m_numWritten.load();
+        m_wakeProducers.notify_all();
+
+        if (m_stop && m_numWritten >= m_numPushed) {
+            break;
+        }
+
+        m_wakeWriter.wait_for(lock, std::chrono::milliseconds(10),
+                              [this]() { return m_stop || m_numWritten < m_numPushed; });
+    }
+}
+
+
+bool AsyncLogWriter::drain()
+{
+    std::lock_guard<std::mutex> lock(m_buffersMutex);
+
+    LogRecord record;
+    bool written = false;
+
+    for (const std::unique_ptr<LogRingBuffer> &buffer : m_buffers) {
+        while (buffer->tryPop(record)) {
+            m_onRecord(record);
+            m_numWritten++;
+            written = true;
+        }
+    }
+
+    if (written) {
+        m_wakeProducers.notify_all(); // there is room in the buffers again
+    }
+
+    return written;
+}
@@ -0,0 +1,94 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/util/log/LogRingBuffer.h"
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+
+/**
+ * Writes log records on a background thread.
+ *
+ * Every thread that logs gets its own LogRingBuffer, so logging threads never contend
+ * with each other. The writer thread drains all buffers and hands each record to
+ * the record handler; when there is nothing left to write, the idle handler is called
+ * (e.g. to flush the log sinks).
+ *
+ * When the buffer of a thread is full, records that may be dropped (verbose messages)
+ * are discarded and counted; for all other records, the logging thread waits until
+ * the writer thread has made room.
+ */
+class BOOMERANG_API AsyncLogWriter
+{
+public:
+    typedef std::function<void(const LogRecord &)> RecordHandler;
+    typedef std::function<void()> IdleHandler;
+
+public:
+    /// \param bufferSize Maximum number of pending records per logging thread.
+    AsyncLogWriter(RecordHandler onRecord, IdleHandler onIdle, std::size_t bufferSize = 4096);
+    AsyncLogWriter(const AsyncLogWriter &) = delete;
+    AsyncLogWriter(AsyncLogWriter &&)      = delete;
+
+    /// Writes all pending records and stops the writer thread.
+    ~AsyncLogWriter();
+
+    AsyncLogWriter &operator=(const AsyncLogWriter &) = delete;
+    AsyncLogWriter &operator=(AsyncLogWriter &&) = delete;
+
+public:
+    /// Queue \p record for writing.
+    /// \param mayDrop If true, \p record is discarded when the buffer of this thread is full.
+    void push(LogRecord &&record, bool mayDrop);
+
+    /// Wait until all records pushed so far have been written and the idle handler was called.
+    void flush();
+
+    /// \returns the number of records discarded because the buffer was full.
+    int getNumDropped() const { return m_numDropped.load(std::memory_order_relaxed); }
+
+private:
+    /// \returns the buffer of the calling thread, creating it if necessary.
+    LogRingBuffer *getThreadBuffer();
+
+    /// Main loop of the writer thread
+    void run();
+
+    /// Hand all currently queued records to the record handler.
+    /// \returns true if at least one record was written.
+    bool drain();
+
+private:
+    const int m_id; ///< Identifies this writer in thread local buffer caches
+    RecordHandler m_onRecord;
+    IdleHandler m_onIdle;
+    std::size_t m_bufferSize;
+
+    std::mutex m_buffersMutex;
+    std::vector<std::unique_ptr<LogRingBuffer>> m_buffers;
+
+    std::atomic<uint64> m_numPushed;
+    std::atomic<uint64> m_numWritten;
+    std::atomic<uint64> m_numFlushed; ///< Value of m_numWritten at the last idle handler call
+    std::atomic<int> m_numDropped;
+    std::atomic<bool> m_stop;
+
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeWriter;
+    std::condition_variable m_wakeProducers;
+
+    std::thread m_thread; ///< Must be initialized last
+};
@@ -15,16 +15,28 @@
 #include "boomerang/ssl/statements/Statement.h"
 #include "boomerang/ssl/type/Type.h"
 #include "boomerang/util/Util.h"
+#include "boomerang/util/log/AsyncLogWriter.h"
 #include "boomerang/util/log/ConsoleLogSink.h"
 #include "boomerang/util/log/FileLogSink.h"
 
 #include <QDir>
 #include <QFileInfo>
 
+#include <cstdlib>
+
 
 static Log *g_log = nullptr;
 
 
+/// Make sure pending asynchronous messages are written when the program exits.
+static void stopAsyncLogging()
+{
+    if (g_log) {
+        g_log->setAsync(false);
+    }
+}
+
+
 Log::Log(LogLevel level)
     : m_fileNameOffset(0)
     , m_level(level)
@@ -41,6 +53,7 @@ Log::Log(LogLevel level)
 
 Log::~Log()
 {
+    setAsync(false);
     flush();
 }
 
@@ -57,23 +70,91 @@ Log &Log::getOrCreateLog()
 
 void Log::flush()
 {
-    for (std::unique_ptr<ILogSink> &s : m_sinks) {
-        s->flush();
+    if (m_asyncWriter) {
+        m_asyncWriter->flush(); // also flushes the sinks
+    }
+    else {
+        flushSinks();
+    }
+}
+
+
+void Log::setAsync(bool async)
+{
+    if (async == isAsync()) {
+        return;
+    }
+    else if (async) {
+        static bool atExitRegistered = false;
+        if (!atExitRegistered) {
+            std::atexit(stopAsyncLogging);
+            atExitRegistered = true;
+        }
+
+        m_asyncWriter.reset(new AsyncLogWriter(
+            [this](const LogRecord &record) {
+                writeMessage(record.level, record.file, record.line, record.msg);
+            },
+            [this]() { flushSinks(); }));
+    }
+    else {
+        const int numDropped = m_asyncWriter->getNumDropped();
+        m_asyncWriter.reset(); // writes all pending messages
+
+        if (numDropped > 0) {
+            logDirect(LogLevel::Warning, __FILE__, __LINE__,
+                      QString("%1 verbose log messages were dropped").arg(numDropped));
+        }
+
+        flushSinks();
     }
 }
 
 
 void Log::log(LogLevel level, const char *file, int line, const QString &msg)
+{
+    if (!canLog(level)) {
+        return;
+    }
+    else if (m_asyncWriter && level != LogLevel::Fatal) {
+        LogRecord record;
+        record.level = level;
+        record.file  = file;
+        record.line  = line;
+        record.msg   = msg;
+
+        // Verbose messages are not worth blocking the decompilation for
+        m_asyncWriter->push(std::move(record), level >= LogLevel::Verbose1);
+        return;
+    }
+
+    if (m_asyncWriter) {
+        // Write pending messages first, so the order of messages is preserved
+        m_asyncWriter->flush();
+    }
+
+    writeMessage(level, file, line, msg);
+    flushSinks();
+}
+
+
+void Log::writeMessage(LogLevel level, const char *file, int line, const QString &msg)
 {
     const QStringList msgLines = msg.split('\n');
 
     for (const QString &msgLine : msgLines) {
-        if (canLog(level)) {
-            logDirect(level, file, line, msgLine);
-        }
+        logDirect(level, file, line, msgLine);
     }
+}
 
-    flush();
+
+void Log::flushSinks()
+{
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+
+    for (std::unique_ptr<ILogSink> &s : m_sinks) {
+        s->flush();
+    }
 }
 
 
@@ -99,6 +180,7 @@ void Log::logDirect(LogLevel level, const char *file, int line, const QString &m
 void Log::addLogSink(std::unique_ptr<ILogSink> s)
 {
     assert(s != nullptr);
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
 
     if (std::find(m_sinks.begin(), m_sinks.end(), s) == m_sinks.end()) {
         m_sinks.push_back(std::move(s));
@@ -121,6 +203,7 @@ void Log::removeAllSinks()
 {
     flush();
 
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
     m_sinks.clear();
 }
 
@@ -222,6 +305,8 @@ QString Log::collectArg(const QString &msg, const LocationSet *l)
 
 void Log::write(const QString &msg)
 {
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+
     for (std::unique_ptr<ILogSink> &s : m_sinks) {
         s->write(msg);
     }
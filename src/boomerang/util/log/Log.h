@@ -14,9 +14,11 @@
 #include "boomerang/util/Types.h"
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 
+class AsyncLogWriter;
 class ILogSink;
 class Statement;
 class Exp;
@@ -104,8 +106,18 @@ public:
         log(level, file, line, collectArgs(msg, args...));
     }
 
+    /// Write all pending messages and flush all log sinks.
     void flush();
 
+    /**
+     * Enable or disable asynchronous logging. When enabled, messages are queued
+     * and written to the log sinks by a background thread, so logging does not block
+     * on I/O. Verbose messages are dropped when the queue of the logging thread is full.
+     * Fatal messages are always written synchronously.
+     */
+    void setAsync(bool async);
+    bool isAsync() const { return m_asyncWriter != nullptr; }
+
     /// Add a log sink / target. Takes ownership of the pointer.
     void addLogSink(std::unique_ptr<ILogSink> s);
     void addDefaultLogSinks(const QString &outputDir);
@@ -119,6 +131,12 @@ private:
     /// Check if logging is allowed with level \p level
     bool canLog(LogLevel level) const;
 
+    /// Split \p msg into lines and write them to all log sinks.
+    void writeMessage(LogLevel level, const char *file, int line, const QString &msg);
+
+    /// Flush all log sinks without waiting for pending asynchronous messages.
+    void flushSinks();
+
     /// Write a header with column captions
     void writeLogHeader();
 
@@ -188,7 +206,11 @@ private:
      */
     size_t m_fileNameOffset;
     LogLevel m_level = LogLevel::Default;
+
+    std::mutex m_sinkMutex; ///< Sinks are also accessed by the asynchronous writer thread
     std::vector<std::unique_ptr<ILogSink>> m_sinks;
+
+    std::unique_ptr<AsyncLogWriter> m_asyncWriter; ///< nullptr if logging synchronously
 };
 
 template<>
@@ -0,0 +1,66 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "LogRingBuffer.h"
+
+#include <algorithm>
+
+
+static std::size_t nextPowerOf2(std::size_t n)
+{
+    std::size_t result = 1;
+    while (result < n) {
+        result <<= 1;
+    }
+
+    return result;
+}
+
+
+LogRingBuffer::LogRingBuffer(std::size_t capacity)
+    : m_records(nextPowerOf2(std::max<std::size_t>(capacity, 2)))
+    , m_mask(m_records.size() - 1)
+    , m_head(0)
+    , m_tail(0)
+{
+}
+
+
+bool LogRingBuffer::tryPush(LogRecord &record)
+{
+    const std::size_t tail = m_tail.load(std::memory_order_relaxed);
+
+    if (tail - m_head.load(std::memory_order_acquire) >= m_records.size()) {
+        return false; // full
+    }
+
+    m_records[tail & m_mask] = std::move(record);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+
+bool LogRingBuffer::tryPop(LogRecord &record)
+{
+    const std::size_t head = m_head.load(std::memory_order_relaxed);
+
+    if (head == m_tail.load(std::memory_order_acquire)) {
+        return false; // empty
+    }
+
+    record = std::move(m_records[head & m_mask]);
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+
+bool LogRingBuffer::isEmpty() const
+{
+    return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+}
@@ -0,0 +1,66 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/util/log/Log.h"
+
+#include <QString>
+
+#include <atomic>
+#include <vector>
+
+
+/// A log message that has not been written to the log sinks yet.
+struct BOOMERANG_API LogRecord
+{
+    LogLevel level   = LogLevel::Default;
+    const char *file = nullptr; ///< Usually __FILE__, so it does not need to be copied
+    int line         = 0;
+    QString msg;
+};
+
+
+/**
+ * Bounded lock-free queue of log records with a single producer and a single consumer.
+ * The producer is the thread that owns the buffer, the consumer is the log writer thread.
+ */
+class BOOMERANG_API LogRingBuffer
+{
+public:
+    /// \param capacity Maximum number of records in the buffer. Rounded up to a power of 2.
+    explicit LogRingBuffer(std::size_t capacity);
+    LogRingBuffer(const LogRingBuffer &) = delete;
+    LogRingBuffer(LogRingBuffer &&)      = delete;
+
+    ~LogRingBuffer() = default;
+
+    LogRingBuffer &operator=(const LogRingBuffer &) = delete;
+    LogRingBuffer &operator=(LogRingBuffer &&) = delete;
+
+public:
+    /// Append \p record to the buffer. Must only be called by the producer.
+    /// \returns false if the buffer is full, in which case \p record is not modified.
+    bool tryPush(LogRecord &record);
+
+    /// Remove the oldest record from the buffer. Must only be called by the consumer.
+    /// \returns false if the buffer is empty.
+    bool tryPop(LogRecord &record);
+
+    bool isEmpty() const;
+    std::size_t getCapacity() const { return m_records.size(); }
+
+private:
+    std::vector<LogRecord> m_records;
+    std::size_t m_mask;
+
+    alignas(64) std::atomic<std::size_t> m_head; ///< Index of the next record to pop
+    alignas(64) std::atomic<std::size_t> m_tail; ///< Index of the next record to push
+};
@@ -16,6 +16,8 @@
 #include <QMap>
 #include <QSharedPointer>
 
+#include <mutex>
+
 
 SeparateLogger::SeparateLogger(const QString &fullFilePath)
 {
@@ -27,6 +29,9 @@ SeparateLogger::SeparateLogger(const QString &fullFilePath)
 SeparateLogger &SeparateLogger::getOrCreateLog(const QString &name)
 {
     static QMap<QString, QSharedPointer<SeparateLogger>> loggers;
+    static std::mutex loggersMutex;
+
+    std::lock_guard<std::mutex> lock(loggersMutex);
 
     if (!loggers.contains(name)) {
         loggers[name].reset(new SeparateLogger(name + ".log"));
@@ -0,0 +1,241 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ExpNormalizer.h"
+
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/exp/Ternary.h"
+#include "boomerang/ssl/exp/TypedExp.h"
+
+#include <array>
+#include <atomic>
+#include <cassert>
+
+
+namespace
+{
+constexpr int NUM_OPERS = opFLF + 1;
+
+
+/// Operators of all expressions ExpSimplifier has at least one rule for.
+/// This must be kept in sync with ExpSimplifier.
+const OPER RULE_OPERS[] = {
+    // Unary
+    opNeg, opBitNot, opLNot, opMemOf, opAddrOf, opTypedExp, opSubscript,
+
+    // Binary
+    opPlus, opMinus, opMult, opMults, opDiv, opDivs, opMod, opMods, opFMinus, opShL, opShR, opShRA,
+    opBitAnd, opBitOr, opBitXor, opAnd, opOr, opEquals, opNotEqual, opLess, opGtr, opLessEq,
+    opGtrEq, opLessUns, opGtrUns, opLessEqUns, opGtrEqUns,
+
+    // Ternary
+    opTern, opAt, opSgnEx, opZfill, opFsize, opItof, opTruncu, opTruncs
+};
+
+
+class RuleDispatchTable
+{
+public:
+    RuleDispatchTable()
+    {
+        m_hasRules.fill(false);
+
+        for (OPER oper : RULE_OPERS) {
+            m_hasRules[oper] = true;
+        }
+    }
+
+    bool hasRules(OPER oper) const
+    {
+        // wildcards only appear in search patterns and are never simplified
+        return oper >= 0 && oper < NUM_OPERS && m_hasRules[oper];
+    }
+
+private:
+    std::array<bool, NUM_OPERS> m_hasRules;
+};
+
+
+const RuleDispatchTable g_ruleTable;
+
+std::array<std::atomic<uint64>, NUM_OPERS> g_ruleHits;
+std::atomic<uint64> g_numRuleChecks{ 0 };
+std::atomic<uint64> g_numSkipped{ 0 };
+
+
+SharedExp getSubExp(const SharedExp &exp, int i)
+{
+    switch (i) {
+    case 1: return exp->getSubExp1();
+    case 2: return exp->getSubExp2();
+    case 3: return exp->getSubExp3();
+    default: assert(false); return nullptr;
+    }
+}
+
+
+void setSubExp(const SharedExp &exp, int i, const SharedExp &subExp)
+{
+    switch (i) {
+    case 1: exp->setSubExp1(subExp); break;
+    case 2: exp->setSubExp2(subExp); break;
+    case 3: exp->setSubExp3(subExp); break;
+    default: assert(false);
+    }
+}
+}
+
+
+ExpNormalizer::~ExpNormalizer()
+{
+    g_numRuleChecks += m_numRuleChecks;
+    g_numSkipped += m_numSkipped;
+}
+
+
+SharedExp ExpNormalizer::normalize(const SharedExp &exp)
+{
+    bool wasNormal = false;
+    return normalize(exp, wasNormal);
+}
+
+
+SharedExp ExpNormalizer::normalize(const SharedExp &exp, bool &wasNormal)
+{
+    SharedExp res = exp;
+    wasNormal     = true;
+
+    while (true) {
+        bool subExpsNormal = res->isNormalForm();
+
+        // Children first. If a child was replaced or had to be looked at by the rules,
+        // this expression has to be looked at again as well.
+        for (int i = 1; i <= res->getArity(); i++) {
+            const SharedExp subExp    = getSubExp(res, i);
+            bool subExpNormal         = false;
+            const SharedExp newSubExp = normalize(subExp, subExpNormal);
+
+            if (newSubExp != subExp) {
+                setSubExp(res, i, newSubExp);
+                subExpsNormal = false;
+            }
+            else if (!subExpNormal) {
+                subExpsNormal = false;
+            }
+        }
+
+        if (subExpsNormal) {
+            m_numSkipped++;
+            return res;
+        }
+
+        wasNormal = false;
+
+        if (!g_ruleTable.hasRules(res->getOper())) {
+            res->setNormalForm(true);
+            return res;
+        }
+
+        // The preModify functions of this class make sure that only the rules
+        // for res itself are applied.
+        m_numRuleChecks++;
+        clearModified();
+        const SharedExp newRes = res->acceptModifier(this);
+
+        if (!isModified() && newRes == res) {
+            // Some rules rearrange the expression without counting as a modification
+            // (e.g. moving integer constants to the RHS). Changed leaves are still normal.
+            for (int i = 1; i <= res->getArity(); i++) {
+                const SharedExp subExp = getSubExp(res, i);
+                if (subExp->getArity() == 0) {
+                    subExp->setNormalForm(true);
+                }
+            }
+
+            res->setNormalForm(true);
+            return res;
+        }
+
+        g_ruleHits[res->getOper()]++;
+        res = newRes;
+    }
+}
+
+
+SharedExp ExpNormalizer::preModify(const std::shared_ptr<Unary> &exp, bool &visitChildren)
+{
+    visitChildren = false;
+    return exp;
+}
+
+
+SharedExp ExpNormalizer::preModify(const std::shared_ptr<Binary> &exp, bool &visitChildren)
+{
+    visitChildren = false;
+    return exp;
+}
+
+
+SharedExp ExpNormalizer::preModify(const std::shared_ptr<Ternary> &exp, bool &visitChildren)
+{
+    visitChildren = false;
+    return exp;
+}
+
+
+SharedExp ExpNormalizer::preModify(const std::shared_ptr<TypedExp> &exp, bool &visitChildren)
+{
+    SharedExp res = ExpSimplifier::preModify(exp, visitChildren);
+    visitChildren = false;
+    return res;
+}
+
+
+SharedExp ExpNormalizer::preModify(const std::shared_ptr<RefExp> &exp, bool &visitChildren)
+{
+    visitChildren = false;
+    return exp;
+}
+
+
+SharedExp ExpNormalizer::preModify(const std::shared_ptr<Location> &exp, bool &visitChildren)
+{
+    visitChildren = false;
+    return exp;
+}
+
+
+uint64 ExpNormalizer::getNumRuleHits(OPER oper)
+{
+    return (oper >= 0 && oper < NUM_OPERS) ? g_ruleHits[oper].load() : 0;
+}
+
+
+uint64 ExpNormalizer::getNumRuleChecks()
+{
+    return g_numRuleChecks;
+}
+
+
+uint64 ExpNormalizer::getNumSkipped()
+{
+    return g_numSkipped;
+}
+
+
+void ExpNormalizer::resetStatistics()
+{
+    for (std::atomic<uint64> &hits : g_ruleHits) {
+        hits = 0;
+    }
+
+    g_numRuleChecks = 0;
+    g_numSkipped    = 0;
+}
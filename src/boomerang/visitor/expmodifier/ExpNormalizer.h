@@ -0,0 +1,84 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/ssl/exp/Operator.h"
+#include "boomerang/util/Types.h"
+#include "boomerang/visitor/expmodifier/ExpSimplifier.h"
+
+
+/**
+ * Brings expressions into the normal form of ExpSimplifier in a single bottom-up pass.
+ *
+ * Children are normalized before their parent, and the rules of ExpSimplifier are then
+ * only applied to the parent itself. If a rule rewrites the parent, only the result
+ * of the rewrite is normalized again; unchanged subexpressions are not revisited.
+ * Expressions that are found to be in normal form are marked as such
+ * (\ref Exp::isNormalForm), and the mark is cleared by all mutators of Exp,
+ * so later simplifications of the same (unmodified) subexpressions are free.
+ *
+ * Expressions with operators that no rule can apply to are marked without
+ * consulting ExpSimplifier at all (see the operator dispatch table in ExpNormalizer.cpp).
+ *
+ * \sa Exp::simplify
+ */
+class BOOMERANG_API ExpNormalizer : public ExpSimplifier
+{
+public:
+    ExpNormalizer() = default;
+    virtual ~ExpNormalizer();
+
+public:
+    /// Normalize \p exp and all subexpressions.
+    /// \returns the normalized expression.
+    SharedExp normalize(const SharedExp &exp);
+
+public:
+    /// \copydoc ExpModifier::preModify
+    SharedExp preModify(const std::shared_ptr<Unary> &exp, bool &visitChildren) override;
+
+    /// \copydoc ExpModifier::preModify
+    SharedExp preModify(const std::shared_ptr<Binary> &exp, bool &visitChildren) override;
+
+    /// \copydoc ExpModifier::preModify
+    SharedExp preModify(const std::shared_ptr<Ternary> &exp, bool &visitChildren) override;
+
+    /// \copydoc ExpModifier::preModify
+    SharedExp preModify(const std::shared_ptr<TypedExp> &exp, bool &visitChildren) override;
+
+    /// \copydoc ExpModifier::preModify
+    SharedExp preModify(const std::shared_ptr<RefExp> &exp, bool &visitChildren) override;
+
+    /// \copydoc ExpModifier::preModify
+    SharedExp preModify(const std::shared_ptr<Location> &exp, bool &visitChildren) override;
+
+public:
+    /// \returns the number of times a rule rewrote an expression with operator \p oper,
+    /// summed over all normalizers.
+    static uint64 getNumRuleHits(OPER oper);
+
+    /// \returns the number of times the rules were applied to an expression
+    static uint64 getNumRuleChecks();
+
+    /// \returns the number of subexpressions skipped because they were already normalized
+    static uint64 getNumSkipped();
+
+    static void resetStatistics();
+
+private:
+    /// \param wasNormal set to true if neither \p exp nor any subexpression had to be
+    /// looked at by the rules
+    SharedExp normalize(const SharedExp &exp, bool &wasNormal);
+
+private:
+    uint64 m_numRuleChecks = 0;
+    uint64 m_numSkipped    = 0;
+};
@@ -0,0 +1,136 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "MicroBenchmark.h"
+
+
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/DataFlow.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ifc/ITypeRecovery.h"
+#include "boomerang/passes/PassManager.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/RTLInstDict.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/Ternary.h"
+
+
+void MicroBenchmark::benchmarkInstantiateRTL()
+{
+    RTLInstDict dict;
+    QVERIFY(dict.readSSLFile(BOOMERANG_TEST_BASE "share/boomerang/ssl/x86.ssl"));
+
+    const std::vector<SharedExp> regReg = { Location::regOf(REG_X86_EAX),
+                                            Location::regOf(REG_X86_ECX) };
+    const std::vector<SharedExp> memImm = {
+        Location::memOf(Binary::get(opPlus, Location::regOf(REG_X86_EBP), Const::get(-8))),
+        Const::get(42)
+    };
+
+    QBENCHMARK {
+        for (int i = 0; i < 100; i++) {
+            std::unique_ptr<RTL> add = dict.instantiateRTL("ADD.reg32.reg32", Address(0x1000),
+                                                           regReg);
+            std::unique_ptr<RTL> mov = dict.instantiateRTL("MOV.rm32.imm32", Address(0x1002),
+                                                           memImm);
+            QVERIFY(add != nullptr && mov != nullptr);
+        }
+    }
+}
+
+
+void MicroBenchmark::benchmarkSimplify()
+{
+    QFETCH(SharedExpWrapper, exp);
+
+    QBENCHMARK {
+        for (int i = 0; i < 100; i++) {
+            exp->clone()->simplify();
+        }
+    }
+}
+
+
+void MicroBenchmark::benchmarkSimplify_data()
+{
+    QTest::addColumn<SharedExpWrapper>("exp");
+
+    // m[((r28 - 4) + 4) - 8]
+    QTest::newRow("stack offsets") << SharedExpWrapper(Location::memOf(Binary::get(
+        opMinus,
+        Binary::get(opPlus, Binary::get(opMinus, Location::regOf(REG_X86_ESP), Const::get(4)),
+                    Const::get(4)),
+        Const::get(8))));
+
+    // ((r24 & 0xFF) | 0) + (r24 * 1) - 0
+    QTest::newRow("identities") << SharedExpWrapper(Binary::get(
+        opMinus,
+        Binary::get(opPlus,
+                    Binary::get(opBitOr,
+                                Binary::get(opBitAnd, Location::regOf(REG_X86_EAX),
+                                            Const::get(0xFF)),
+                                Const::get(0)),
+                    Binary::get(opMult, Location::regOf(REG_X86_EAX), Const::get(1))),
+        Const::get(0)));
+
+    // (r24 = 5) ? 3 + 4 : 7
+    QTest::newRow("ternary") << SharedExpWrapper(Ternary::get(
+        opTern, Binary::get(opEquals, Location::regOf(REG_X86_EAX), Const::get(5)),
+        Binary::get(opPlus, Const::get(3), Const::get(4)), Const::get(7)));
+}
+
+
+void MicroBenchmark::benchmarkPlacePhiFunctions()
+{
+    QVERIFY(m_project.loadBinaryFile(SAMPLE("x86/nestedswitch")));
+    QVERIFY(m_project.decodeBinaryFile());
+
+    UserProc *proc = static_cast<UserProc *>(m_project.getProg()->getFunctionByName("main"));
+    QVERIFY(proc != nullptr);
+
+    PassManager::get()->executePass(PassID::StatementInit, proc);
+    DataFlow *df = proc->getDataFlow();
+
+    QBENCHMARK {
+        QVERIFY(df->calculateDominators());
+        QVERIFY(df->placePhiFunctions());
+    }
+}
+
+
+void MicroBenchmark::benchmarkTypeRecovery()
+{
+    m_project.getSettings()->useTypeAnalysis = false;
+
+    QVERIFY(m_project.loadBinaryFile(SAMPLE("x86/sumarray-O4")));
+    QVERIFY(m_project.decodeBinaryFile());
+
+    UserProc *proc = static_cast<UserProc *>(m_project.getProg()->getFunctionByName("main"));
+    QVERIFY(proc != nullptr);
+
+    // Decompile without type analysis, but stay in SSA form
+    proc->decompileRecursive();
+
+    ITypeRecovery *rec = m_project.getTypeRecoveryEngine();
+    QVERIFY(rec != nullptr);
+
+    // Recovering the types of a proc that is already typed is much cheaper,
+    // so only the first run is measured.
+    QBENCHMARK_ONCE {
+        rec->recoverFunctionTypes(proc);
+    }
+
+    m_project.getSettings()->useTypeAnalysis = true;
+}
+
+
+QTEST_GUILESS_MAIN(MicroBenchmark)
@@ -0,0 +1,36 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+/**
+ * Benchmarks for single hot spots of the decompiler.
+ */
+class MicroBenchmark : public BoomerangTestWithPlugins
+{
+    Q_OBJECT
+
+private slots:
+    /// RTLInstDict::instantiateRTL for common x86 instructions
+    void benchmarkInstantiateRTL();
+
+    /// ExpSimplifier on expressions typically produced by propagation
+    void benchmarkSimplify();
+    void benchmarkSimplify_data();
+
+    /// Dominators and DataFlow::placePhiFunctions on a lifted procedure
+    void benchmarkPlacePhiFunctions();
+
+    /// DFATypeRecovery on a decompiled procedure
+    void benchmarkTypeRecovery();
+};
@@ -0,0 +1,85 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "PipelineBenchmark.h"
+
+
+#include "boomerang/core/Settings.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+
+/**
+ * The default corpus. It can be replaced by setting the environment variable
+ * BOOMERANG_BENCHMARK_CORPUS to a file that contains one sample path
+ * (relative to data/samples/) per line.
+ * Results are only comparable against a baseline made with the same corpus.
+ */
+static const char *const DEFAULT_CORPUS[] = {
+    "x86/fib",
+    "x86/frontier",
+    "x86/nestedswitch",
+    "x86/recursion",
+    "x86/sumarray-O4",
+    "x86/switch_gcc",
+    "x86/fedora2_true",
+    "elf32-ppc/fibo",
+    "elf32-ppc/switch",
+    "OSX/banner",
+};
+
+
+void PipelineBenchmark::benchmarkPipeline()
+{
+    QFETCH(QString, sample);
+
+    QTemporaryDir outDir;
+    QVERIFY(outDir.isValid());
+    m_project.getSettings()->setOutputDirectory(outDir.path());
+
+    QBENCHMARK {
+        QVERIFY(m_project.loadBinaryFile(getFullSamplePath(sample)));
+        QVERIFY(m_project.decodeBinaryFile());
+        QVERIFY(m_project.decompileBinaryFile());
+        QVERIFY(m_project.generateCode());
+    }
+}
+
+
+void PipelineBenchmark::benchmarkPipeline_data()
+{
+    QTest::addColumn<QString>("sample");
+
+    const QString corpusFile = qgetenv("BOOMERANG_BENCHMARK_CORPUS");
+
+    if (corpusFile.isEmpty()) {
+        for (const char *sample : DEFAULT_CORPUS) {
+            QTest::newRow(sample) << QString(sample);
+        }
+
+        return;
+    }
+
+    QFile file(corpusFile);
+    QVERIFY(file.open(QFile::ReadOnly | QFile::Text));
+    QTextStream stream(&file);
+
+    while (!stream.atEnd()) {
+        const QString sample = stream.readLine().trimmed();
+
+        if (!sample.isEmpty() && !sample.startsWith('#')) {
+            QTest::newRow(qPrintable(sample)) << sample;
+        }
+    }
+}
+
+
+QTEST_GUILESS_MAIN(PipelineBenchmark)
@@ -0,0 +1,27 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+/**
+ * Benchmarks the whole pipeline (load, decode, decompile, generate code)
+ * for a fixed corpus of sample binaries.
+ */
+class PipelineBenchmark : public BoomerangTestWithPlugins
+{
+    Q_OBJECT
+
+private slots:
+    void benchmarkPipeline();
+    void benchmarkPipeline_data();
+};
@@ -0,0 +1,116 @@
+#!/usr/bin/env python3
+#
+# This file is part of the Boomerang Decompiler.
+#
+# See the file "LICENSE.TERMS" for information on usage and
+# redistribution of this file, and for a DISCLAIMER OF ALL
+# WARRANTIES.
+#
+
+# Compares benchmark results (QtTest XML output, see 'make benchmark')
+# against a stored baseline and fails if any benchmark got significantly slower.
+#
+# Usage:
+#   compare-benchmarks.py [--threshold <percent>] <baseline_dir> <results_dir>
+#   compare-benchmarks.py --update <baseline_dir> <results_dir>
+
+import argparse
+import json
+import os
+import shutil
+import sys
+import xml.etree.ElementTree as ET
+
+
+def load_results(results_dir):
+    """ Returns a map (benchmark, function, tag, metric) -> value per iteration """
+    results = {}
+
+    if not os.path.isdir(results_dir):
+        return results
+
+    for file_name in sorted(os.listdir(results_dir)):
+        if not file_name.endswith(".xml"):
+            continue
+
+        benchmark = os.path.splitext(file_name)[0]
+        root = ET.parse(os.path.join(results_dir, file_name)).getroot()
+
+        for function in root.iter("TestFunction"):
+            for result in function.iter("BenchmarkResult"):
+                iterations = max(int(result.get("iterations", "1")), 1)
+                key = (benchmark, function.get("name"), result.get("tag", ""), result.get("metric"))
+                results[key] = float(result.get("value")) / iterations
+
+    return results
+
+
+def update_baseline(baseline_dir, results_dir):
+    if os.path.isdir(baseline_dir):
+        shutil.rmtree(baseline_dir)
+
+    shutil.copytree(results_dir, baseline_dir)
+    print("Stored results from '%s' as new baseline in '%s'" % (results_dir, baseline_dir))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare benchmark results against a baseline.")
+    parser.add_argument("baseline_dir")
+    parser.add_argument("results_dir")
+    parser.add_argument("--threshold", type=float, default=15.0,
+                        help="Maximum allowed slowdown in percent (default: 15)")
+    parser.add_argument("--update", action="store_true",
+                        help="Store the results as new baseline instead of comparing")
+    args = parser.parse_args()
+
+    current = load_results(args.results_dir)
+    if not current:
+        print("No benchmark results found in '%s'" % args.results_dir)
+        return 1
+
+    if args.update or not os.path.isdir(args.baseline_dir):
+        update_baseline(args.baseline_dir, args.results_dir)
+        return 0
+
+    baseline = load_results(args.baseline_dir)
+    summary = []
+    num_regressions = 0
+
+    print("%-60s %14s %14s %8s" % ("Benchmark", "Baseline", "Current", "Change"))
+    print("=" * 99)
+
+    for key in sorted(current.keys()):
+        name = "%s::%s(%s)" % (key[0], key[1], key[2])
+        value = current[key]
+        entry = { "benchmark": key[0], "function": key[1], "tag": key[2], "metric": key[3],
+                  "value": value }
+
+        if key not in baseline or baseline[key] == 0:
+            print("%-60s %14s %14.3f %8s" % (name, "-", value, "new"))
+        else:
+            change = (value - baseline[key]) / baseline[key] * 100.0
+            regressed = change > args.threshold
+            num_regressions += regressed
+
+            entry["baseline"] = baseline[key]
+            entry["change_percent"] = change
+            entry["regression"] = regressed
+
+            print("%-60s %14.3f %14.3f %+7.1f%%%s" % (name, baseline[key], value, change,
+                                                     " REGRESSION" if regressed else ""))
+
+        summary.append(entry)
+
+    with open(os.path.join(args.results_dir, "summary.json"), "w") as f:
+        json.dump(summary, f, indent=2)
+
+    if num_regressions > 0:
+        print("\n%d benchmark(s) are more than %.1f%% slower than the baseline."
+              % (num_regressions, args.threshold))
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -386,6 +386,88 @@ void CommandLineDriverTest::testApplyCommandline()
         QCOMPARE(drv.getProject()->getSettings()->m_entryPoints.size(), 1);
         QCOMPARE(drv.getProject()->getSettings()->m_entryPoints[0], Address(0x1000));
     }
+
+    {
+        CommandlineDriver drv;
+        QCOMPARE(drv.getProject()->getSettings()->decompileTimeLimit, 0);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "-S", "2", "test.exe" }), 0);
+        QCOMPARE(drv.getProject()->getSettings()->decompileTimeLimit, 120);
+    }
+
+    {
+        CommandlineDriver drv;
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--proc-time", "10", "--proc-passes",
+                                        "500", "--proc-stmts", "20000", "test.exe" }),
+                 0);
+        QCOMPARE(drv.getProject()->getSettings()->procTimeLimit, 10);
+        QCOMPARE(drv.getProject()->getSettings()->procPassLimit, 500);
+        QCOMPARE(drv.getProject()->getSettings()->procStmtLimit, 20000);
+    }
+
+    {
+        CommandlineDriver drv;
+        QCOMPARE(drv.getProject()->getSettings()->decompileTier, DecompileTier::Full);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--tier", "0", "test.exe" }), 0);
+        QCOMPARE(drv.getProject()->getSettings()->decompileTier, DecompileTier::Quick);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--tier", "2", "test.exe" }), 1);
+    }
+
+    {
+        CommandlineDriver drv;
+        QCOMPARE(drv.getProject()->getSettings()->numThreads, 0);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--threads", "4", "test.exe" }), 0);
+        QCOMPARE(drv.getProject()->getSettings()->numThreads, 4);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--threads", "0", "test.exe" }), 1);
+    }
+
+    {
+        CommandlineDriver drv;
+        QCOMPARE(drv.getProject()->getSettings()->insnRetention, InsnRetention::Keep);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--insn-retention", "lifted", "test.exe" }),
+                 0);
+        QCOMPARE(drv.getProject()->getSettings()->insnRetention, InsnRetention::AfterLift);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--insn-retention", "decompiled",
+                                        "test.exe" }),
+                 0);
+        QCOMPARE(drv.getProject()->getSettings()->insnRetention, InsnRetention::AfterDecompile);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--insn-retention", "never", "test.exe" }),
+                 1);
+    }
+
+    {
+        CommandlineDriver drv;
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--proc-time", "-1", "test.exe" }), 1);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--proc-passes" }), 1);
+    }
+
+    {
+        CommandlineDriver drv;
+        QCOMPARE(drv.isBatchMode(), false);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--batch", "binaries/" }), 0);
+        QCOMPARE(drv.isBatchMode(), true);
+    }
+
+    {
+        CommandlineDriver drv;
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--batch", "-" }), 0);
+        QCOMPARE(drv.isBatchMode(), true);
+    }
+
+    {
+        CommandlineDriver drv;
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--batch" }), 1);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--batch", "binaries/", "test.exe" }), 1);
+    }
+
+    {
+        CommandlineDriver drv;
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--jobs", "4", "--job-mem", "512",
+                                        "--batch", "-" }),
+                 0);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--jobs", "0", "--batch", "-" }), 1);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--job-mem", "-1", "--batch", "-" }), 1);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--jobs" }), 1);
+    }
 }
 
 
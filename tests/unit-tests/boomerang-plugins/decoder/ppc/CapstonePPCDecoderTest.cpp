@@ -12,6 +12,9 @@
 #include "boomerang/ssl/RTL.h"
 #include "boomerang/util/Types.h"
 
+#include <atomic>
+#include <thread>
+
 
 struct InstructionData
 {
@@ -1245,4 +1248,50 @@ void CapstonePPCDecoderTest::testInstructions_data()
 }
 
 
+void CapstonePPCDecoderTest::testDecodeThreads()
+{
+    const InstructionData insns[] = {
+        { "\x7c\x01\x12\x14" }, // add r0, r1, r2
+        { "\x7c\x01\x12\x15" }, // add. r0, r1, r2
+        { "\x7c\x01\x10\x14" }, // addc r0, r1, r2
+        { "\x7c\x23\x12\x78" }, // xor 3, 1, 2
+    };
+
+    const Address sourceAddr = Address(0x1000);
+    MachineInstruction expected[4];
+
+    for (int i = 0; i < 4; i++) {
+        const ptrdiff_t diff = (HostAddress(&insns[i]) - sourceAddr).value();
+        QVERIFY(m_decoder->disassembleInstruction(sourceAddr, diff, expected[i]));
+        QVERIFY(expected[i].m_templateEntry != nullptr);
+    }
+
+    std::atomic<int> numMismatches(0);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&]() {
+            for (int n = 0; n < 100; n++) {
+                for (int i = 0; i < 4; i++) {
+                    MachineInstruction insn;
+                    const ptrdiff_t diff = (HostAddress(&insns[i]) - sourceAddr).value();
+
+                    if (!m_decoder->disassembleInstruction(sourceAddr, diff, insn) ||
+                        insn.m_templateName != expected[i].m_templateName ||
+                        insn.m_templateEntry != expected[i].m_templateEntry) {
+                        numMismatches++;
+                    }
+                }
+            }
+        });
+    }
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    QCOMPARE(numMismatches.load(), 0);
+}
+
+
 QTEST_GUILESS_MAIN(CapstonePPCDecoderTest)
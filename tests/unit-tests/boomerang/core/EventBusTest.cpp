@@ -0,0 +1,195 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "EventBusTest.h"
+
+
+#include "boomerang/core/EventBus.h"
+#include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
+
+#include <memory>
+#include <thread>
+
+
+static DecompEvent makeEvent(DecompEvent::Kind kind, uint64 count)
+{
+    DecompEvent event;
+    event.kind  = kind;
+    event.count = count;
+    return event;
+}
+
+
+void EventBusTest::testPublish()
+{
+    std::unique_ptr<EventBus> bus(new EventBus());
+    DecompEvent event;
+
+    // nobody is listening
+    QVERIFY(!bus->publish(makeEvent(DecompEvent::Kind::StartDecompile, 0)));
+    QVERIFY(!bus->poll(event));
+
+    bus->setListening(true);
+    QVERIFY(bus->publish(makeEvent(DecompEvent::Kind::StartDecompile, 1)));
+    QVERIFY(bus->publish(makeEvent(DecompEvent::Kind::EndDecompile, 2)));
+
+    QVERIFY(bus->poll(event));
+    QCOMPARE(event.kind, DecompEvent::Kind::StartDecompile);
+    QCOMPARE(event.count, uint64(1));
+
+    QVERIFY(bus->poll(event));
+    QCOMPARE(event.kind, DecompEvent::Kind::EndDecompile);
+    QCOMPARE(event.count, uint64(2));
+
+    QVERIFY(!bus->poll(event));
+    QCOMPARE(bus->getNumDropped(), uint64(0));
+}
+
+
+void EventBusTest::testDecodeProgress()
+{
+    std::unique_ptr<EventBus> bus(new EventBus());
+
+    bus->instructionDecoded(Address(0x1000), 4);
+    QCOMPARE(bus->getNumDecodedInsns(), uint64(0));
+
+    bus->setListening(true);
+
+    for (uint32 i = 0; i < EventBus::DECODE_BATCH_SIZE * 2 + 10; i++) {
+        bus->instructionDecoded(Address(0x1000 + 2 * i), 2);
+    }
+
+    std::vector<DecompEvent> events;
+    bus->drain([&events](const DecompEvent &event) { events.push_back(event); });
+
+    QCOMPARE(events.size(), std::size_t(2));
+    QCOMPARE(events[0].kind, DecompEvent::Kind::DecodeProgress);
+    QCOMPARE(events[0].count, uint64(EventBus::DECODE_BATCH_SIZE));
+    QCOMPARE(events[1].count, uint64(EventBus::DECODE_BATCH_SIZE * 2));
+    QCOMPARE(events[1].numBytes, uint64(EventBus::DECODE_BATCH_SIZE * 4));
+
+    // the remaining instructions are only published when flushing
+    bus->flushDecodeProgress();
+    events.clear();
+    bus->drain([&events](const DecompEvent &event) { events.push_back(event); });
+
+    QCOMPARE(events.size(), std::size_t(1));
+    QCOMPARE(events[0].count, uint64(EventBus::DECODE_BATCH_SIZE * 2 + 10));
+    QCOMPARE(events[0].addr, Address(0x1000 + 2 * (EventBus::DECODE_BATCH_SIZE * 2 + 9)));
+
+    // nothing new to flush
+    bus->flushDecodeProgress();
+    QCOMPARE(bus->drain([](const DecompEvent &) {}), 0);
+
+    bus->resetDecodeProgress();
+    QCOMPARE(bus->getNumDecodedInsns(), uint64(0));
+    QCOMPARE(bus->getNumDecodedBytes(), uint64(0));
+}
+
+
+void EventBusTest::testOverflow()
+{
+    std::unique_ptr<EventBus> bus(new EventBus());
+    bus->setListening(true);
+
+    for (uint64 i = 0; i < EventBus::CAPACITY; i++) {
+        QVERIFY(bus->publish(makeEvent(DecompEvent::Kind::ProcStatusChanged, i)));
+    }
+
+    QVERIFY(!bus->publish(makeEvent(DecompEvent::Kind::ProcStatusChanged, EventBus::CAPACITY)));
+    QCOMPARE(bus->getNumDropped(), uint64(1));
+
+    DecompEvent event;
+    QVERIFY(bus->poll(event));
+    QCOMPARE(event.count, uint64(0));
+
+    // there is room for one more event now
+    QVERIFY(bus->publish(makeEvent(DecompEvent::Kind::ProcStatusChanged, EventBus::CAPACITY)));
+
+    uint64 expected = 1;
+    bus->drain([&expected](const DecompEvent &ev) {
+        QCOMPARE(ev.count, expected);
+        expected++;
+    });
+
+    QCOMPARE(expected, uint64(EventBus::CAPACITY + 1));
+}
+
+
+void EventBusTest::testConcurrent()
+{
+    const uint64 numEvents = 200000;
+    std::unique_ptr<EventBus> bus(new EventBus());
+    bus->setListening(true);
+
+    std::thread producer([&bus, numEvents]() {
+        for (uint64 i = 0; i < numEvents; i++) {
+            const DecompEvent event = makeEvent(DecompEvent::Kind::EndDecompile, i);
+            while (!bus->publish(event)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64 expected = 0;
+    bool inOrder    = true;
+
+    while (expected < numEvents) {
+        bus->drain([&expected, &inOrder](const DecompEvent &event) {
+            inOrder = inOrder && event.count == expected;
+            expected++;
+        });
+    }
+
+    producer.join();
+
+    QVERIFY(inOrder);
+    QCOMPARE(expected, numEvents);
+}
+
+
+void EventBusTest::testProjectEvents()
+{
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.loadPlugins();
+
+    EventBus *bus = project.getEventBus();
+    bus->setListening(true);
+
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+    QVERIFY(project.decodeBinaryFile());
+
+    int numStart = 0, numFunctions = 0, numEnd = 0;
+    uint64 numInsns = 0;
+
+    bus->drain([&](const DecompEvent &event) {
+        switch (event.kind) {
+        case DecompEvent::Kind::StartDecode: numStart++; break;
+        case DecompEvent::Kind::FunctionDecoded: numFunctions++; break;
+        case DecompEvent::Kind::EndDecode:
+            numEnd++;
+            numInsns = event.count;
+            break;
+        default: break;
+        }
+    });
+
+    QCOMPARE(numStart, 1);
+    QCOMPARE(numEnd, 1);
+    QVERIFY(numFunctions > 0);
+    QVERIFY(numInsns > 0);
+    QCOMPARE(numInsns, bus->getNumDecodedInsns());
+    QCOMPARE(bus->getNumDropped(), uint64(0));
+}
+
+
+QTEST_GUILESS_MAIN(EventBusTest)
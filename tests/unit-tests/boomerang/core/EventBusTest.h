@@ -0,0 +1,31 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+/**
+ * Test the EventBus class.
+ */
+class EventBusTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    void testPublish();
+    void testDecodeProgress();
+    void testOverflow();
+    void testConcurrent();
+
+    /// Test the events of decoding a binary file.
+    void testProjectEvents();
+};
@@ -12,7 +12,15 @@
 
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
+#include "boomerang/db/Global.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
+
+#include <QFile>
+#include <QRegularExpression>
+#include <QTemporaryDir>
 
 
 void ProjectTest::testLoadBinaryFile()
@@ -104,6 +112,33 @@ void ProjectTest::testDecompileBinaryFile()
 }
 
 
+void ProjectTest::testRefineProc()
+{
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.getSettings()->decompileTier = DecompileTier::Quick;
+    project.loadPlugins();
+
+    QVERIFY(!project.refineProc(nullptr));
+
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+    QVERIFY(project.decodeBinaryFile());
+    QVERIFY(project.decompileBinaryFile());
+
+    UserProc *main = dynamic_cast<UserProc *>(project.getProg()->getFunctionByName("main"));
+    QVERIFY(main != nullptr);
+    QVERIFY(main->isDecompiled());
+    QVERIFY(main->isAnalysisIncomplete());
+
+    QVERIFY(project.refineProc(main));
+    QVERIFY(main->isDecompiled());
+    QVERIFY(!main->isAnalysisIncomplete());
+
+    QVERIFY(project.generateCode());
+}
+
+
 void ProjectTest::testGenerateCode()
 {
     Project project;
@@ -122,4 +157,62 @@ void ProjectTest::testGenerateCode()
 }
 
 
+void ProjectTest::testStreamDecompilation()
+{
+    QTemporaryDir outputDir;
+    QVERIFY(outputDir.isValid());
+
+    QString outPath;
+    QStringList globalNames;
+
+    {
+        Project project;
+        project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+        project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+        project.getSettings()->setOutputDirectory(outputDir.path());
+        project.getSettings()->streamDecompilation = true;
+        project.loadPlugins();
+
+        QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+        QVERIFY(project.decodeBinaryFile());
+        QVERIFY(project.decompileBinaryFile());
+
+        // all procedures have been finalized and their IR released
+        for (const auto &module : project.getProg()->getModuleList()) {
+            for (Function *func : *module) {
+                if (!func->isLib()) {
+                    QCOMPARE(static_cast<UserProc *>(func)->getCFG()->getNumFragments(), 0);
+                }
+            }
+        }
+
+        outPath = project.getProg()->getRootModule()->getOutPath("c");
+        for (const auto &global : project.getProg()->getGlobals()) {
+            globalNames.append(global->getName());
+        }
+    } // the output file is flushed when the code generator is destroyed
+
+    QFile outFile(outPath);
+    QVERIFY(outFile.open(QFile::ReadOnly | QFile::Text));
+    const QString code = QString::fromUtf8(outFile.readAll());
+
+    QVERIFY(code.contains("main("));
+
+    // The globals are defined after all procedures. Any global used by a procedure
+    // must have been declared before.
+    for (const QString &name : globalNames) {
+        const QRegularExpression re("\\b" + QRegularExpression::escape(name) + "\\b");
+        const int first = code.indexOf(re);
+        const int last  = code.lastIndexOf(re);
+
+        if (first == last) {
+            continue; // only defined
+        }
+
+        const int lineStart = code.lastIndexOf('\n', first) + 1;
+        QVERIFY(code.mid(lineStart).startsWith("extern "));
+    }
+}
+
+
 QTEST_GUILESS_MAIN(ProjectTest)
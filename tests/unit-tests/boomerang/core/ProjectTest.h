@@ -33,5 +33,10 @@ private slots:
 
     void testDecodeBinaryFile();
     void testDecompileBinaryFile();
+    void testRefineProc();
     void testGenerateCode();
+
+    /// Test that streaming decompilation finalizes all procedures
+    /// and declares globals before they are used.
+    void testStreamDecompilation();
 };
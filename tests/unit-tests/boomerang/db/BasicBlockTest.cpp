@@ -10,6 +10,9 @@
 #include "BasicBlockTest.h"
 
 #include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/LowLevelCFG.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/util/ThreadPool.h"
 
 
 void BasicBlockTest::testType()
@@ -76,4 +79,59 @@ void BasicBlockTest::testCompleteBB()
 }
 
 
+
+void BasicBlockTest::testReleaseInsns()
+{
+    {
+        // BBs without a procedure keep their instructions
+        BasicBlock bb(BBType::Twoway, createInsns(Address(0x1000), 2));
+        bb.releaseInsns();
+        QVERIFY(!bb.hasReleasedInsns());
+        QCOMPARE(bb.getInsns().size(), static_cast<size_t>(2));
+    }
+
+    QVERIFY(m_project.loadBinaryFile(SAMPLE("x86/hello")));
+    QVERIFY(m_project.decodeBinaryFile());
+
+    BasicBlock *bb = m_project.getProg()->getCFG()->getBBStartingAt(Address(0x08048328));
+    QVERIFY(bb != nullptr);
+    QVERIFY(bb->getProc() != nullptr);
+
+    const std::vector<MachineInstruction> insns = bb->getInsns();
+    QVERIFY(!insns.empty());
+
+    const int numReloads = BasicBlock::getNumReloads();
+    bb->releaseInsns();
+    QVERIFY(bb->hasReleasedInsns());
+    QVERIFY(bb->isComplete());
+    QCOMPARE(bb->getLowAddr(), insns.front().m_addr);
+
+    const std::vector<MachineInstruction> &reloaded = bb->getInsns();
+    QVERIFY(!bb->hasReleasedInsns());
+    QCOMPARE(BasicBlock::getNumReloads(), numReloads + 1);
+    QCOMPARE(reloaded.size(), insns.size());
+
+    for (std::size_t i = 0; i < insns.size(); i++) {
+        QCOMPARE(reloaded[i].m_addr, insns[i].m_addr);
+        QCOMPARE(reloaded[i].m_size, insns[i].m_size);
+        QCOMPARE(QString(reloaded[i].m_mnem.data()), QString(insns[i].m_mnem.data()));
+        QCOMPARE(QString(reloaded[i].m_opstr.data()), QString(insns[i].m_opstr.data()));
+    }
+
+    // Concurrent accesses reload the instructions only once
+    bb->releaseInsns();
+    QVERIFY(bb->hasReleasedInsns());
+
+    std::vector<std::size_t> sizes(16, 0);
+    ThreadPool pool(4);
+    pool.forEach(sizes.size(), [&](std::size_t i) { sizes[i] = bb->getInsns().size(); });
+
+    QVERIFY(!bb->hasReleasedInsns());
+    QCOMPARE(BasicBlock::getNumReloads(), numReloads + 2);
+    for (std::size_t size : sizes) {
+        QCOMPARE(size, insns.size());
+    }
+}
+
+
 QTEST_GUILESS_MAIN(BasicBlockTest)
@@ -16,7 +16,7 @@
 /**
  * Tests for low-level BasicBlocks
  */
-class BasicBlockTest : public BoomerangTest
+class BasicBlockTest : public BoomerangTestWithPlugins
 {
     Q_OBJECT
 
@@ -26,4 +26,5 @@ private slots:
     void testIsComplete();
 
     void testCompleteBB();
+    void testReleaseInsns();
 };
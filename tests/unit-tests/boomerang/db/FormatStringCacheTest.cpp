@@ -0,0 +1,80 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "FormatStringCacheTest.h"
+
+
+#include "boomerang/db/FormatStringCache.h"
+#include "boomerang/ssl/type/ArrayType.h"
+#include "boomerang/ssl/type/CharType.h"
+#include "boomerang/ssl/type/FloatType.h"
+#include "boomerang/ssl/type/IntegerType.h"
+
+
+void FormatStringCacheTest::testParsePrintf()
+{
+    QVERIFY(FormatStringCache::parse("", false).empty());
+    QVERIFY(FormatStringCache::parse("Hello world 100%%\n", false).empty());
+
+    const FormatParams params = FormatStringCache::parse("%d: %*s %.*f %hhu\n", false);
+    QCOMPARE(params.size(), static_cast<size_t>(6));
+
+    QVERIFY(*params[0].type == *IntegerType::get(32, Sign::Signed));
+    QVERIFY(*params[1].type == *IntegerType::get(32, Sign::Signed)); // width
+    QVERIFY(*params[2].type == *ArrayType::get(CharType::get()));
+    QVERIFY(*params[3].type == *IntegerType::get(32, Sign::Signed)); // precision
+    QVERIFY(*params[4].type == *FloatType::get(64));
+    QVERIFY(*params[5].type == *IntegerType::get(8, Sign::Unsigned));
+
+    QVERIFY(!params[0].addPointer);
+    QVERIFY(params[2].addPointer);
+    QVERIFY(!params[4].addPointer);
+}
+
+
+void FormatStringCacheTest::testParseScanf()
+{
+    const FormatParams params = FormatStringCache::parse("%d %*d %f %[abc]", true);
+    QCOMPARE(params.size(), static_cast<size_t>(3));
+
+    QVERIFY(*params[0].type == *IntegerType::get(32, Sign::Signed));
+    QVERIFY(*params[1].type == *FloatType::get(32));
+    QVERIFY(*params[2].type == *ArrayType::get(CharType::get()));
+
+    for (const FormatParam &param : params) {
+        QVERIFY(param.addPointer);
+    }
+}
+
+
+void FormatStringCacheTest::testGetParams()
+{
+    FormatStringCache cache;
+    QCOMPARE(cache.getNumParsed(), 0);
+
+    QCOMPARE(cache.getParams("%d %d", false).size(), static_cast<size_t>(2));
+    QCOMPARE(cache.getNumParsed(), 1);
+    QCOMPARE(cache.getNumHits(), 0);
+
+    QCOMPARE(cache.getParams("%d %d", false).size(), static_cast<size_t>(2));
+    QCOMPARE(cache.getNumParsed(), 1);
+    QCOMPARE(cache.getNumHits(), 1);
+
+    // printf and scanf format strings are parsed differently
+    QCOMPARE(cache.getParams("%d %d", true).size(), static_cast<size_t>(2));
+    QVERIFY(cache.getParams("%d %d", true)[0].addPointer);
+    QCOMPARE(cache.getNumParsed(), 2);
+
+    cache.clear();
+    QCOMPARE(cache.getNumParsed(), 0);
+    QCOMPARE(cache.getNumHits(), 0);
+}
+
+
+QTEST_GUILESS_MAIN(FormatStringCacheTest)
@@ -301,6 +301,19 @@ void ProgTest::testGetDefaultSignature()
 }
 
 
+void ProgTest::testGetDefaultLibraryCatalogues()
+{
+    QCOMPARE(Prog::getDefaultLibraryCatalogues(Machine::X86, LoadFmt::ELF),
+             QStringList({ "signatures/common.hs", "signatures/x86.hs" }));
+    QCOMPARE(Prog::getDefaultLibraryCatalogues(Machine::X86, LoadFmt::PE),
+             QStringList({ "signatures/common.hs", "signatures/x86.hs", "signatures/win32.hs" }));
+    QCOMPARE(Prog::getDefaultLibraryCatalogues(Machine::PPC, LoadFmt::MACHO),
+             QStringList({ "signatures/common.hs", "signatures/ppc.hs", "signatures/objc.hs" }));
+    QCOMPARE(Prog::getDefaultLibraryCatalogues(Machine::UNKNOWN, LoadFmt::ELF),
+             QStringList({ "signatures/common.hs" }));
+}
+
+
 void ProgTest::testGetStringConstant()
 {
     Prog testProg("test", nullptr);
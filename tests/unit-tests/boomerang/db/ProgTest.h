@@ -45,6 +45,7 @@ private slots:
 
     void testGetMachine();
     void testGetDefaultSignature();
+    void testGetDefaultLibraryCatalogues();
 
     void testGetStringConstant();
     void testGetFloatConstant();
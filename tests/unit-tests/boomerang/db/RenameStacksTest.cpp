@@ -0,0 +1,101 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "RenameStacksTest.h"
+
+
+#include "boomerang/db/RenameStacks.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/statements/Assign.h"
+
+
+static SharedStmt makeDef(RegNum reg, int value)
+{
+    return std::make_shared<Assign>(Location::regOf(reg), Const::get(value));
+}
+
+
+void RenameStacksTest::testPushPop()
+{
+    RenameStacks stacks;
+    SharedStmt def1 = makeDef(REG_X86_EAX, 1);
+    SharedStmt def2 = makeDef(REG_X86_ECX, 2);
+    SharedStmt def3 = makeDef(REG_X86_EAX, 3);
+
+    QVERIFY(stacks.empty());
+    QVERIFY(stacks.getTop(Location::regOf(REG_X86_EAX)) == nullptr);
+    QCOMPARE(stacks.findLoc(Location::regOf(REG_X86_EAX)), RenameStacks::NO_LOC);
+
+    const RenameStacks::LocID eax = stacks.push(Location::regOf(REG_X86_EAX), def1);
+    const RenameStacks::LocID ecx = stacks.push(Location::regOf(REG_X86_ECX), def2);
+    QVERIFY(eax != ecx);
+    QCOMPARE(stacks.push(Location::regOf(REG_X86_EAX), def3), eax);
+
+    // locations are compared by value
+    QCOMPARE(stacks.findLoc(Location::regOf(REG_X86_EAX)), eax);
+    QCOMPARE(stacks.getNumLocs(), 2);
+    QCOMPARE(stacks.getHeight(), static_cast<std::size_t>(3));
+    QVERIFY(stacks.getTop(eax) == def3);
+    QVERIFY(stacks.getTop(Location::regOf(REG_X86_ECX)) == def2);
+    QCOMPARE(stacks.getLoc(eax)->toString(), Location::regOf(REG_X86_EAX)->toString());
+
+    stacks.popTo(2);
+    QVERIFY(stacks.getTop(eax) == def1);
+    QVERIFY(stacks.getTop(ecx) == def2);
+
+    stacks.popTo(0);
+    QVERIFY(stacks.empty());
+    QVERIFY(stacks.getTop(eax) == nullptr);
+    QVERIFY(stacks.getTop(ecx) == nullptr);
+
+    // ids are kept after popping
+    QCOMPARE(stacks.findLoc(Location::regOf(REG_X86_ECX)), ecx);
+}
+
+
+void RenameStacksTest::testPushAll()
+{
+    RenameStacks stacks;
+    SharedStmt def1 = makeDef(REG_X86_EAX, 1);
+    SharedStmt def2 = makeDef(REG_X86_ECX, 2);
+    SharedStmt call = makeDef(REG_X86_EDX, 3);
+
+    stacks.push(Location::regOf(REG_X86_EAX), def1);
+    stacks.push(Location::regOf(REG_X86_ECX), def2);
+    stacks.popTo(1);
+
+    // ecx has an empty stack, but still gets the definition
+    stacks.pushAll(call);
+    QCOMPARE(stacks.getHeight(), static_cast<std::size_t>(3));
+    QVERIFY(stacks.getTop(Location::regOf(REG_X86_EAX)) == call);
+    QVERIFY(stacks.getTop(Location::regOf(REG_X86_ECX)) == call);
+    QVERIFY(stacks.getTop(Location::regOf(REG_X86_EDX)) == nullptr);
+
+    stacks.popTo(1);
+    QVERIFY(stacks.getTop(Location::regOf(REG_X86_EAX)) == def1);
+    QVERIFY(stacks.getTop(Location::regOf(REG_X86_ECX)) == nullptr);
+}
+
+
+void RenameStacksTest::testClear()
+{
+    RenameStacks stacks;
+    stacks.clear(); // Verify it does not crash
+
+    stacks.push(Location::regOf(REG_X86_EAX), makeDef(REG_X86_EAX, 1));
+    stacks.clear();
+
+    QVERIFY(stacks.empty());
+    QCOMPARE(stacks.getNumLocs(), 0);
+    QCOMPARE(stacks.findLoc(Location::regOf(REG_X86_EAX)), RenameStacks::NO_LOC);
+}
+
+
+QTEST_GUILESS_MAIN(RenameStacksTest)
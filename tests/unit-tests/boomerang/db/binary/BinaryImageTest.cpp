@@ -192,6 +192,39 @@ void BinaryImageTest::testRead()
 }
 
 
+void BinaryImageTest::testReadNativeAddrs4()
+{
+    char sectionData[12] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+                             0x00, 0x00, 0x00, 0x00 };
+
+    BinaryImage img(QByteArray{});
+    QVERIFY(img.readNativeAddrs4(Address(0x1000), 4).empty());
+
+    // section not mapped to data
+    BinarySection *sect1 = img.createSection("sect1", Address(0x1000), Address(0x100C));
+    QVERIFY(img.readNativeAddrs4(Address(0x1000), 4).empty());
+
+    // only the first 8 bytes are initialized
+    sect1->setHostAddr(HostAddress(sectionData));
+    sect1->addDefinedArea(Address(0x1000), Address(0x1008));
+
+    std::vector<Address> addrs = img.readNativeAddrs4(Address(0x1000), 4);
+    QCOMPARE(addrs.size(), static_cast<size_t>(2));
+    QCOMPARE(addrs[0], Address(0x33221100));
+    QCOMPARE(addrs[1], Address(0x77665544));
+
+    addrs = img.readNativeAddrs4(Address(0x1000), 1);
+    QCOMPARE(addrs.size(), static_cast<size_t>(1));
+    QCOMPARE(addrs[0], Address(0x33221100));
+
+    // read crosses section boundary
+    sect1->addDefinedArea(Address(0x1008), Address(0x100C));
+    addrs = img.readNativeAddrs4(Address(0x1006), 4);
+    QCOMPARE(addrs.size(), static_cast<size_t>(1));
+    QCOMPARE(addrs[0], Address(0x00007766));
+}
+
+
 void BinaryImageTest::testWrite()
 {
     char sectionData[8] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77 };
@@ -28,6 +28,7 @@ private slots:
     void testUpdateTextLimits();
 
     void testRead();
+    void testReadNativeAddrs4();
     void testWrite();
 
     void testIsReadOnly();
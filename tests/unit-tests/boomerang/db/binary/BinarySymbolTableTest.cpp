@@ -77,6 +77,21 @@ void BinarySymbolTableTest::testFindSymbolByAddress()
 }
 
 
+void BinarySymbolTableTest::testFindNextSymbol()
+{
+    BinarySymbolTable tbl;
+    QVERIFY(tbl.findNextSymbol(Address(0x1000)) == nullptr);
+
+    BinarySymbol *sym1 = tbl.createSymbol(Address(0x1000), "testSym1");
+    BinarySymbol *sym2 = tbl.createSymbol(Address(0x2000), "testSym2");
+
+    QVERIFY(tbl.findNextSymbol(Address(0x0800)) == sym1);
+    QVERIFY(tbl.findNextSymbol(Address(0x1000)) == sym2);
+    QVERIFY(tbl.findNextSymbol(Address(0x1800)) == sym2);
+    QVERIFY(tbl.findNextSymbol(Address(0x2000)) == nullptr);
+}
+
+
 void BinarySymbolTableTest::testFindSymbolByName()
 {
     BinarySymbolTable tbl;
@@ -24,6 +24,7 @@ private slots:
 
     void testCreateSymbol();
     void testFindSymbolByAddress();
+    void testFindNextSymbol();
     void testFindSymbolByName();
     void testRenameSymbol();
 };
@@ -0,0 +1,135 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "DataScannerTest.h"
+
+
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/db/binary/DataScanner.h"
+
+#include <QByteArray>
+
+#include <cstring>
+
+
+namespace
+{
+/// Code section at 0x1000, data section at 0x2000
+struct TestImage
+{
+    TestImage()
+        : code(0x100, '\x90')
+        , data(0x80, '\0')
+        , image(QByteArray{})
+    {
+        char *p = data.data();
+
+        std::strcpy(p + 0x00, "Hello, world");
+        std::strcpy(p + 0x10, "ab"); // too short
+
+        const char wide[] = { 'W', 0, 'i', 0, 'd', 0, 'e', 0, 0, 0 };
+        std::memcpy(p + 0x14, wide, sizeof(wide));
+
+        Util::writeDWord(p + 0x20, 0x2000, Endian::Little); // -> data section
+        Util::writeDWord(p + 0x24, 0x1004, Endian::Little); // -> code section
+        Util::writeDWord(p + 0x28, 0x9999, Endian::Little); // -> nowhere
+
+        // crosses several blocks
+        std::strcpy(p + 0x30, "This string is longer than a single block");
+
+        BinarySection *codeSect = image.createSection(".text", Address(0x1000), Address(0x1100));
+        codeSect->setCode(true);
+        codeSect->setReadOnly(true);
+        codeSect->setHostAddr(HostAddress(code.data()));
+
+        BinarySection *dataSect = image.createSection(".rodata", Address(0x2000),
+                                                      Address(0x2080));
+        dataSect->setData(true);
+        dataSect->setReadOnly(true);
+        dataSect->setHostAddr(HostAddress(data.data()));
+    }
+
+    QByteArray code;
+    QByteArray data;
+    BinaryImage image;
+};
+}
+
+
+void DataScannerTest::testFindString()
+{
+    TestImage img;
+    DataScanner scanner(&img.image, 4);
+    scanner.scanImage();
+
+    QCOMPARE(scanner.getNumStrings(), 3);
+
+    const ScannedString *str = scanner.findString(Address(0x2000));
+    QVERIFY(str != nullptr);
+    QCOMPARE(str->length, 12U);
+    QVERIFY(!str->wide);
+    QCOMPARE(str->getEndAddr(), Address(0x200D));
+
+    QVERIFY(scanner.findString(Address(0x2001)) == nullptr);
+    QVERIFY(scanner.findString(Address(0x2010)) == nullptr);
+
+    str = scanner.findString(Address(0x2014));
+    QVERIFY(str != nullptr);
+    QCOMPARE(str->length, 4U);
+    QVERIFY(str->wide);
+    QCOMPARE(str->getEndAddr(), Address(0x201E));
+
+    str = scanner.findString(Address(0x2030));
+    QVERIFY(str != nullptr);
+    QCOMPARE(str->length, 41U);
+    QVERIFY(!str->wide);
+
+    // code sections are not scanned
+    QVERIFY(scanner.findString(Address(0x1000)) == nullptr);
+}
+
+
+void DataScannerTest::testFindStringContaining()
+{
+    TestImage img;
+    DataScanner scanner(&img.image, 4);
+    scanner.scanImage();
+
+    QVERIFY(scanner.findStringContaining(Address(0x1FFF)) == nullptr);
+    QCOMPARE(scanner.findStringContaining(Address(0x2000)), scanner.findString(Address(0x2000)));
+    QCOMPARE(scanner.findStringContaining(Address(0x2007)), scanner.findString(Address(0x2000)));
+    QVERIFY(scanner.findStringContaining(Address(0x200C)) == nullptr); // terminator
+    QCOMPARE(scanner.findStringContaining(Address(0x2016)), scanner.findString(Address(0x2014)));
+    QCOMPARE(scanner.findStringContaining(Address(0x2050)), scanner.findString(Address(0x2030)));
+}
+
+
+void DataScannerTest::testFindPointer()
+{
+    TestImage img;
+    DataScanner scanner(&img.image, 4);
+    scanner.scanImage();
+
+    QCOMPARE(scanner.getNumPointers(), 2);
+
+    const ScannedPointer *ptr = scanner.findPointer(Address(0x2020));
+    QVERIFY(ptr != nullptr);
+    QCOMPARE(ptr->target, Address(0x2000));
+
+    ptr = scanner.findPointer(Address(0x2024));
+    QVERIFY(ptr != nullptr);
+    QCOMPARE(ptr->target, Address(0x1004));
+
+    QVERIFY(scanner.findPointer(Address(0x2028)) == nullptr);
+    QVERIFY(scanner.findPointer(Address(0x2022)) == nullptr);
+}
+
+
+QTEST_GUILESS_MAIN(DataScannerTest)
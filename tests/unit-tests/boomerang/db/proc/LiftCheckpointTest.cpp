@@ -0,0 +1,82 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "LiftCheckpointTest.h"
+
+
+#include "boomerang/db/proc/LiftCheckpoint.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/statements/Assign.h"
+
+
+void LiftCheckpointTest::testFindRTL()
+{
+    LiftCheckpoint checkpoint;
+    QVERIFY(checkpoint.isEmpty());
+    QVERIFY(checkpoint.findRTL(Address(0x1000)) == nullptr);
+    QCOMPARE(checkpoint.getNumMisses(), 1);
+
+    RTL rtl(Address(0x1000),
+            { std::make_shared<Assign>(Location::regOf(REG_X86_EAX), Const::get(0)) });
+    checkpoint.addRTL(Address(0x1000), rtl);
+    QCOMPARE(checkpoint.getNumRTLs(), 1);
+
+    std::unique_ptr<RTL> found = checkpoint.findRTL(Address(0x1000));
+    QVERIFY(found != nullptr);
+    QCOMPARE(found->toString(), rtl.toString());
+    QCOMPARE(checkpoint.getNumHits(), 1);
+
+    QVERIFY(checkpoint.findRTL(Address(0x1002)) == nullptr);
+    QCOMPARE(checkpoint.getNumMisses(), 2);
+}
+
+
+void LiftCheckpointTest::testDeepCopy()
+{
+    LiftCheckpoint checkpoint;
+
+    RTL rtl(Address(0x1000),
+            { std::make_shared<Assign>(Location::regOf(REG_X86_EAX), Const::get(0)) });
+    checkpoint.addRTL(Address(0x1000), rtl);
+
+    // Neither the original RTL nor the copies handed out may change the checkpoint
+    rtl.front()->as<Assign>()->setRight(Const::get(1));
+
+    std::unique_ptr<RTL> first = checkpoint.findRTL(Address(0x1000));
+    QVERIFY(first != nullptr);
+    QCOMPARE(first->front()->as<Assign>()->getRight()->toString(), QString("0"));
+
+    first->front()->as<Assign>()->setRight(Const::get(2));
+
+    std::unique_ptr<RTL> second = checkpoint.findRTL(Address(0x1000));
+    QVERIFY(second != nullptr);
+    QCOMPARE(second->front()->as<Assign>()->getRight()->toString(), QString("0"));
+    QVERIFY(second->front() != first->front());
+}
+
+
+void LiftCheckpointTest::testClear()
+{
+    LiftCheckpoint checkpoint;
+
+    RTL rtl(Address(0x1000),
+            { std::make_shared<Assign>(Location::regOf(REG_X86_EAX), Const::get(0)) });
+    checkpoint.addRTL(Address(0x1000), rtl);
+    QVERIFY(checkpoint.findRTL(Address(0x1000)) != nullptr);
+
+    checkpoint.clear();
+    QVERIFY(checkpoint.isEmpty());
+    QCOMPARE(checkpoint.getNumHits(), 0);
+    QVERIFY(checkpoint.findRTL(Address(0x1000)) == nullptr);
+}
+
+
+QTEST_GUILESS_MAIN(LiftCheckpointTest)
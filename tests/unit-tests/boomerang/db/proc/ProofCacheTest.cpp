@@ -0,0 +1,106 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProofCacheTest.h"
+
+
+#include "boomerang/db/proc/ProofCache.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/statements/PhiAssign.h"
+
+
+void ProofCacheTest::testFindResult()
+{
+    ProofCache cache;
+    bool result = false;
+
+    SharedExp eaxEq = Binary::get(opEquals, Location::regOf(REG_X86_EAX), Location::regOf(REG_X86_EAX));
+    SharedExp ecxEq = Binary::get(opEquals, Location::regOf(REG_X86_ECX), Location::regOf(REG_X86_ECX));
+
+    QVERIFY(!cache.findResult(eaxEq, result));
+    QCOMPARE(cache.getNumMisses(), 1);
+
+    cache.addResult(eaxEq, true);
+    cache.addResult(ecxEq, false);
+
+    // keys are compared by value, not by pointer
+    QVERIFY(cache.findResult(eaxEq->clone(), result));
+    QVERIFY(result == true);
+    QVERIFY(cache.findResult(ecxEq->clone(), result));
+    QVERIFY(result == false);
+    QCOMPARE(cache.getNumHits(), 2);
+}
+
+
+void ProofCacheTest::testFindPhiProof()
+{
+    ProofCache cache;
+    std::shared_ptr<PhiAssign> phi1(new PhiAssign(Location::regOf(REG_X86_ESP)));
+    std::shared_ptr<PhiAssign> phi2(new PhiAssign(Location::regOf(REG_X86_EBP)));
+
+    QVERIFY(cache.findPhiProof(phi1) == nullptr);
+
+    ProofCache::PhiProofMap proofs;
+    proofs[phi1] = Location::regOf(REG_X86_ESP);
+    cache.addPhiProofs(proofs);
+
+    QVERIFY(cache.findPhiProof(phi1) != nullptr);
+    QCOMPARE(cache.findPhiProof(phi1)->toString(), Location::regOf(REG_X86_ESP)->toString());
+    QVERIFY(cache.findPhiProof(phi2) == nullptr);
+}
+
+
+void ProofCacheTest::testClear()
+{
+    ProofCache cache;
+    bool result = false;
+    std::shared_ptr<PhiAssign> phi(new PhiAssign(Location::regOf(REG_X86_ESP)));
+
+    SharedExp eaxEq = Binary::get(opEquals, Location::regOf(REG_X86_EAX), Location::regOf(REG_X86_EAX));
+    cache.addResult(eaxEq, true);
+    cache.addPhiProofs({ { phi, Location::regOf(REG_X86_ESP) } });
+
+    cache.clear();
+    QVERIFY(!cache.findResult(eaxEq, result));
+    QVERIFY(cache.findPhiProof(phi) == nullptr);
+}
+
+
+void ProofCacheTest::testValidate()
+{
+    ProofCache cache;
+    bool result = false;
+    std::shared_ptr<PhiAssign> phi(new PhiAssign(Location::regOf(REG_X86_ESP)));
+
+    SharedExp eaxEq = Binary::get(opEquals, Location::regOf(REG_X86_EAX), Location::regOf(REG_X86_EAX));
+
+    cache.validate(5);
+    cache.addResult(eaxEq, true);
+    cache.addPhiProofs({ { phi, Location::regOf(REG_X86_ESP) } });
+
+    // same statements
+    cache.validate(5);
+    QVERIFY(cache.findResult(eaxEq, result));
+    QVERIFY(result);
+    QVERIFY(cache.findPhiProof(phi) != nullptr);
+
+    // statements changed
+    cache.validate(6);
+    QVERIFY(!cache.findResult(eaxEq, result));
+    QVERIFY(cache.findPhiProof(phi) == nullptr);
+
+    cache.addResult(eaxEq, false);
+    cache.validate(6);
+    QVERIFY(cache.findResult(eaxEq, result));
+    QVERIFY(!result);
+}
+
+
+QTEST_GUILESS_MAIN(ProofCacheTest)
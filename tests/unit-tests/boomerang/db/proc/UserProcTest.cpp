@@ -21,6 +21,7 @@
 #include "boomerang/ssl/exp/Location.h"
 #include "boomerang/ssl/exp/RefExp.h"
 #include "boomerang/db/proc/UserProc.h"
+#include "boomerang/db/proc/CallEffectSummary.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/ssl/RTL.h"
 #include "boomerang/db/signature/X86Signature.h"
@@ -259,6 +260,115 @@ void UserProcTest::testReplacePhiByAssign()
 }
 
 
+void UserProcTest::testGetStatementView()
+{
+    Prog prog("test", nullptr);
+    BasicBlock *bb1 = prog.getCFG()->createBB(BBType::Oneway, createInsns(Address(0x1000), 1));
+    BasicBlock *bb2 = prog.getCFG()->createBB(BBType::Call, createInsns(Address(0x1001), 1));
+
+    UserProc proc(Address(0x1000), "test", nullptr);
+    QVERIFY(proc.getStatementView().empty());
+
+    std::shared_ptr<PhiAssign> phi(new PhiAssign(Location::regOf(REG_X86_EAX)));
+    std::shared_ptr<Assign> as(new Assign(Location::regOf(REG_X86_ECX), Const::get(0)));
+    std::shared_ptr<CallStatement> call(new CallStatement(Address(0x2000)));
+
+    std::unique_ptr<RTLList> rtls1(new RTLList);
+    rtls1->push_back(std::unique_ptr<RTL>(new RTL(Address::ZERO, { phi })));
+    rtls1->push_back(std::unique_ptr<RTL>(new RTL(Address(0x1000), { })));
+    rtls1->push_back(std::unique_ptr<RTL>(new RTL(Address(0x1000), { as })));
+    proc.getCFG()->createFragment(FragType::Oneway, std::move(rtls1), bb1);
+
+    std::unique_ptr<RTLList> rtls2(new RTLList);
+    rtls2->push_back(std::unique_ptr<RTL>(new RTL(Address(0x1001), { call })));
+    proc.getCFG()->createFragment(FragType::Call, std::move(rtls2), bb2);
+
+    StatementList stmts;
+    proc.getStatements(stmts);
+
+    StatementList viewed;
+    for (const SharedStmt &stmt : proc.getStatementView()) {
+        viewed.append(stmt);
+    }
+
+    QCOMPARE(viewed.size(), static_cast<size_t>(3));
+    QVERIFY(std::equal(viewed.begin(), viewed.end(), stmts.begin()));
+
+    viewed.clear();
+    for (const SharedStmt &stmt : proc.getStatementView(STMT_MASK_ASSIGNMENTS)) {
+        viewed.append(stmt);
+    }
+
+    QCOMPARE(viewed.size(), static_cast<size_t>(2));
+    QVERIFY(*viewed.begin() == phi);
+    QVERIFY(*std::next(viewed.begin()) == as);
+
+    StatementView calls = proc.getStatementView(stmtKindMask(StmtType::Call));
+    QVERIFY(*calls.begin() == call);
+    QVERIFY(std::next(calls.begin()) == calls.end());
+
+    QVERIFY(proc.getStatementView(stmtKindMask(StmtType::Ret)).empty());
+}
+
+
+void UserProcTest::testGetStatementsOfKind()
+{
+    Prog prog("test", nullptr);
+    BasicBlock *bb1 = prog.getCFG()->createBB(BBType::Oneway, createInsns(Address(0x1000), 1));
+
+    UserProc proc(Address(0x1000), "test", nullptr);
+    QVERIFY(proc.getStatementsOfKind(StmtType::PhiAssign).empty());
+
+    std::shared_ptr<PhiAssign> phi1(new PhiAssign(Location::regOf(REG_X86_EAX)));
+    std::shared_ptr<PhiAssign> phi2(new PhiAssign(Location::regOf(REG_X86_EDX)));
+    std::shared_ptr<Assign> as(new Assign(Location::regOf(REG_X86_ECX), Const::get(0)));
+
+    std::unique_ptr<RTLList> bbRTLs(new RTLList);
+    bbRTLs->push_back(std::unique_ptr<RTL>(new RTL(Address::ZERO, { phi1, phi2 })));
+    bbRTLs->push_back(std::unique_ptr<RTL>(new RTL(Address(0x1000), { as })));
+
+    IRFragment *frag = proc.getCFG()->createFragment(FragType::Oneway, std::move(bbRTLs), bb1);
+    proc.setEntryFragment();
+    phi1->setFragment(frag);
+    phi2->setFragment(frag);
+    as->setFragment(frag);
+
+    // the index is updated when fragments are added
+    QCOMPARE(proc.getStatementsOfKind(StmtType::PhiAssign).size(), static_cast<size_t>(2));
+    QCOMPARE(proc.getStatementsOfKind(StmtType::Assign).size(), static_cast<size_t>(1));
+    QVERIFY(proc.getStatementsOfKind(StmtType::Call).empty());
+
+    // ... and when statements are removed or replaced
+    QVERIFY(proc.removeStatement(phi2));
+    QCOMPARE(proc.getStatementsOfKind(StmtType::PhiAssign).size(), static_cast<size_t>(1));
+    QVERIFY(proc.getStatementsOfKind(StmtType::PhiAssign).front() == phi1);
+
+    std::shared_ptr<Assign> newAs = proc.replacePhiByAssign(phi1, Const::get(1));
+    QVERIFY(newAs != nullptr);
+    QVERIFY(proc.getStatementsOfKind(StmtType::PhiAssign).empty());
+    QCOMPARE(proc.getStatementsOfKind(StmtType::Assign).size(), static_cast<size_t>(2));
+
+    // changes to one procedure do not invalidate the index of other procedures
+    UserProc other(Address(0x2000), "other", nullptr);
+    const uint64 otherStamp = other.getCFG()->getModificationStamp();
+
+    std::shared_ptr<Assign> added = proc.insertAssignAfter(newAs, Location::regOf(REG_X86_EBX),
+                                                           Const::get(2));
+    QVERIFY(added != nullptr);
+    QCOMPARE(other.getCFG()->getModificationStamp(), otherStamp);
+    QCOMPARE(proc.getStatementsOfKind(StmtType::Assign).size(), static_cast<size_t>(3));
+
+    // an outdated index does not keep removed statements alive
+    std::weak_ptr<Statement> removed = added;
+    QVERIFY(proc.removeStatement(added));
+    added.reset();
+    QVERIFY(!removed.expired());
+    proc.releaseOutdatedStatementIndex();
+    QVERIFY(removed.expired());
+    QCOMPARE(proc.getStatementsOfKind(StmtType::Assign).size(), static_cast<size_t>(2));
+}
+
+
 void UserProcTest::testAddParameterToSignature()
 {
     UserProc proc(Address(0x1000), "test", nullptr);
@@ -826,6 +936,53 @@ void UserProcTest::testPreservesExpWithOffset()
 }
 
 
+void UserProcTest::testGetCallSummary()
+{
+    UserProc proc(Address(0x1000), "test", nullptr);
+    QVERIFY(proc.getCallSummary() == nullptr); // not decompiled yet
+
+    QVERIFY(m_project.loadBinaryFile(SAMPLE("x86/fib")));
+    QVERIFY(m_project.decodeBinaryFile());
+    QVERIFY(m_project.decompileBinaryFile());
+    UserProc *fib = static_cast<UserProc *>(m_project.getProg()->getFunctionByName("fib"));
+    QVERIFY(fib && !fib->isLib());
+
+    std::shared_ptr<const CallEffectSummary> summary = fib->getCallSummary();
+    QVERIFY(summary != nullptr);
+    QVERIFY(fib->getCallSummary() == summary);
+
+    QVERIFY(summary->getProven(Location::regOf(REG_X86_ESP)) != nullptr);
+    QVERIFY(summary->getProven(Location::regOf(REG_X86_ESP))->toString() ==
+            fib->getProven(Location::regOf(REG_X86_ESP))->toString());
+
+    fib->invalidateCallSummary();
+    QVERIFY(fib->getCallSummary() != nullptr);
+    QVERIFY(fib->getCallSummary() != summary);
+}
+
+
+void UserProcTest::testReleaseIR()
+{
+    QVERIFY(m_project.loadBinaryFile(SAMPLE("x86/fib")));
+    QVERIFY(m_project.decodeBinaryFile());
+    QVERIFY(m_project.decompileBinaryFile());
+    UserProc *fib = static_cast<UserProc *>(m_project.getProg()->getFunctionByName("fib"));
+    QVERIFY(fib && !fib->isLib());
+    QVERIFY(fib->getCFG()->getNumFragments() > 0);
+
+    const int numParams = fib->getParameters().size();
+    fib->releaseIR();
+
+    QCOMPARE(fib->getCFG()->getNumFragments(), 0);
+    QVERIFY(fib->getEntryFragment() == nullptr);
+    QVERIFY(fib->getRetStmt() != nullptr);
+    QVERIFY(fib->getRetStmt()->getFragment() == nullptr);
+    QCOMPARE(static_cast<int>(fib->getParameters().size()), numParams);
+    QVERIFY(fib->getCallSummary() != nullptr);
+    QVERIFY(fib->getCallSummary()->getProven(Location::regOf(REG_X86_ESP)) != nullptr);
+}
+
+
 void UserProcTest::testPromoteSignature()
 {
     QVERIFY(m_project.loadBinaryFile(SAMPLE("x86/fib")));
@@ -23,6 +23,8 @@ private slots:
     void testInsertAssignAfter();
     void testInsertStatementAfter();
     void testReplacePhiByAssign();
+    void testGetStatementView();
+    void testGetStatementsOfKind();
 
     void testAddParameterToSignature();
     void testInsertParameter();
@@ -51,6 +53,8 @@ private slots:
     void testAddCallee();
     void testPreservesExp();
     void testPreservesExpWithOffset();
+    void testGetCallSummary();
+    void testReleaseIR();
     void testPromoteSignature();
     void testFindFirstSymbol();
     void testSearchAndReplace();
@@ -470,4 +470,29 @@ void SignatureTest::testPreferredName()
 }
 
 
+void SignatureTest::testGetNumLive()
+{
+    const int numLive = Signature::getNumLive();
+
+    {
+        std::shared_ptr<Signature> sig = std::make_shared<Signature>("test");
+        QCOMPARE(Signature::getNumLive(), numLive + 1);
+
+        std::shared_ptr<Signature> shared = sig;
+        QCOMPARE(Signature::getNumLive(), numLive + 1);
+
+        std::shared_ptr<Signature> cloned = sig->clone();
+        QCOMPARE(Signature::getNumLive(), numLive + 2);
+
+        Signature copy(*sig);
+        QCOMPARE(Signature::getNumLive(), numLive + 3);
+
+        copy = *cloned;
+        QCOMPARE(Signature::getNumLive(), numLive + 3);
+    }
+
+    QCOMPARE(Signature::getNumLive(), numLive);
+}
+
+
 QTEST_GUILESS_MAIN(SignatureTest)
@@ -58,4 +58,5 @@ private slots:
     void testGetABIDefines();
 
     void testPreferredName();
+    void testGetNumLive();
 };
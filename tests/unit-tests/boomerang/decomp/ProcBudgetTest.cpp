@@ -0,0 +1,120 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProcBudgetTest.h"
+
+
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/LowLevelCFG.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/decomp/ProcBudget.h"
+#include "boomerang/ssl/RTL.h"
+
+
+void ProcBudgetTest::testNoLimits()
+{
+    Settings settings;
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcBudget budget(&settings, ProcBudget::Clock::time_point::max());
+
+    budget.addUsage(std::chrono::hours(1), 1000000);
+    QCOMPARE(budget.getNumPassesUsed(), uint64(1000000));
+    QVERIFY(budget.getTimeUsed() == ProcBudget::Clock::duration(std::chrono::hours(1)));
+    QVERIFY(budget.checkLimits(&proc, ProcBudget::Clock::now()).isEmpty());
+}
+
+
+void ProcBudgetTest::testTimeLimit()
+{
+    Settings settings;
+    settings.procTimeLimit = 2;
+
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcBudget budget(&settings, ProcBudget::Clock::time_point::max());
+
+    budget.addUsage(std::chrono::seconds(1), 0);
+    QVERIFY(budget.checkLimits(&proc, ProcBudget::Clock::now()).isEmpty());
+
+    budget.addUsage(std::chrono::seconds(1), 0);
+    QVERIFY(budget.checkLimits(&proc, ProcBudget::Clock::now()).isEmpty());
+
+    budget.addUsage(std::chrono::milliseconds(1), 0);
+    QCOMPARE(budget.checkLimits(&proc, ProcBudget::Clock::now()),
+             QString("time limit of 2 seconds exceeded"));
+}
+
+
+void ProcBudgetTest::testPassLimit()
+{
+    Settings settings;
+    settings.procPassLimit = 10;
+
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcBudget budget(&settings, ProcBudget::Clock::time_point::max());
+
+    budget.addUsage(ProcBudget::Clock::duration::zero(), 10);
+    QVERIFY(budget.checkLimits(&proc, ProcBudget::Clock::now()).isEmpty());
+
+    budget.addUsage(ProcBudget::Clock::duration::zero(), 1);
+    QCOMPARE(budget.checkLimits(&proc, ProcBudget::Clock::now()),
+             QString("limit of 10 analysis passes exceeded"));
+}
+
+
+void ProcBudgetTest::testStmtLimit()
+{
+    Settings settings;
+    settings.procStmtLimit = 4;
+
+    Prog prog("test", nullptr);
+    BasicBlock *bb1 = prog.getCFG()->createBB(BBType::Oneway, createInsns(Address(0x1000), 2));
+    BasicBlock *bb2 = prog.getCFG()->createBB(BBType::Ret, createInsns(Address(0x1002), 1));
+
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcBudget budget(&settings, ProcBudget::Clock::time_point::max());
+
+    // no statements yet
+    QVERIFY(budget.checkLimits(&proc, ProcBudget::Clock::now()).isEmpty());
+
+    proc.getCFG()->createFragment(FragType::Oneway, createRTLs(Address(0x1000), 2, 2), bb1);
+    QVERIFY(budget.checkLimits(&proc, ProcBudget::Clock::now()).isEmpty());
+
+    proc.getCFG()->createFragment(FragType::Ret, createRTLs(Address(0x1002), 1, 1), bb2);
+    QCOMPARE(budget.checkLimits(&proc, ProcBudget::Clock::now()),
+             QString("limit of 4 statements exceeded"));
+}
+
+
+void ProcBudgetTest::testDeadline()
+{
+    Settings settings;
+    UserProc proc(Address(0x1000), "test", nullptr);
+
+    const ProcBudget::Clock::time_point deadline = ProcBudget::Clock::now();
+    ProcBudget budget(&settings, deadline);
+
+    QVERIFY(budget.checkLimits(&proc, deadline - std::chrono::seconds(1)).isEmpty());
+    QCOMPARE(budget.checkLimits(&proc, deadline),
+             QString("time limit for the whole program exceeded"));
+
+    // the deadline takes precedence over the per-procedure limits
+    settings.procPassLimit = 1;
+    ProcBudget passBudget(&settings, deadline);
+    passBudget.addUsage(ProcBudget::Clock::duration::zero(), 2);
+
+    QCOMPARE(passBudget.checkLimits(&proc, deadline + std::chrono::seconds(1)),
+             QString("time limit for the whole program exceeded"));
+    QCOMPARE(passBudget.checkLimits(&proc, deadline - std::chrono::seconds(1)),
+             QString("limit of 1 analysis passes exceeded"));
+}
+
+
+QTEST_GUILESS_MAIN(ProcBudgetTest)
@@ -0,0 +1,121 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "UnusedReturnRemoverTest.h"
+
+
+#include "boomerang/core/Watcher.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/decomp/UnusedReturnRemover.h"
+#include "boomerang/ssl/statements/CallStatement.h"
+
+#include <algorithm>
+
+
+/// Records the order in which the remover processes the procedures
+class ProcessedProcsWatcher : public IWatcher
+{
+public:
+    void onDecompileInProgress(UserProc *proc) override { m_processed.push_back(proc); }
+
+public:
+    std::vector<UserProc *> m_processed;
+};
+
+
+static UserProc *createDecodedProc(Prog &prog, Address entryAddr)
+{
+    UserProc *proc = static_cast<UserProc *>(prog.getOrCreateFunction(entryAddr));
+    proc->setStatus(ProcStatus::Decoded);
+    return proc;
+}
+
+
+void UnusedReturnRemoverTest::testWorklistOrder()
+{
+    ProcessedProcsWatcher watcher;
+    TestProject project;
+    project.addWatcher(&watcher);
+
+    Prog prog("test", &project);
+    UserProc *proc3 = createDecodedProc(prog, Address(0x3000));
+    UserProc *proc1 = createDecodedProc(prog, Address(0x1000));
+    UserProc *proc2 = createDecodedProc(prog, Address(0x2000));
+
+    // not decoded, so never scheduled
+    prog.getOrCreateFunction(Address(0x4000));
+
+    UnusedReturnRemover remover(&prog);
+    remover.scheduleAll();
+    QVERIFY(!remover.removeUnusedReturns());
+
+    // procedures are processed by entry address, not by creation order
+    QCOMPARE(watcher.m_processed, std::vector<UserProc *>({ proc1, proc2, proc3 }));
+    QCOMPARE(remover.getStats().numProcessed, 3);
+    QCOMPARE(remover.getStats().numChanged, 0);
+    QCOMPARE(remover.getStats().numRequeued, 0);
+    QVERIFY(remover.getChangedProcs().empty());
+
+    // the worklist is empty now
+    watcher.m_processed.clear();
+    QVERIFY(!remover.removeUnusedReturns());
+    QVERIFY(watcher.m_processed.empty());
+}
+
+
+void UnusedReturnRemoverTest::testRequeue()
+{
+    ProcessedProcsWatcher watcher;
+    TestProject project;
+    project.addWatcher(&watcher);
+
+    Prog prog("test", &project);
+    UserProc *caller = createDecodedProc(prog, Address(0x1000));
+    UserProc *proc   = createDecodedProc(prog, Address(0x2000));
+    UserProc *callee = createDecodedProc(prog, Address(0x3000));
+    UserProc *other  = createDecodedProc(prog, Address(0x4000));
+
+    // caller -> proc -> callee
+    std::shared_ptr<CallStatement> call1(new CallStatement(proc->getEntryAddress()));
+    call1->setProc(caller);
+    caller->addCallee(proc);
+    proc->addCaller(call1);
+
+    std::shared_ptr<CallStatement> call2(new CallStatement(callee->getEntryAddress()));
+    call2->setProc(proc);
+    proc->addCallee(callee);
+    callee->addCaller(call2);
+
+    UnusedReturnRemover remover(&prog);
+    remover.scheduleAll();
+    remover.removeUnusedReturns();
+    QCOMPARE(remover.getStats().numProcessed, 4);
+    remover.resetStats();
+    QCOMPARE(remover.getStats().numProcessed, 0);
+
+    // Requeueing schedules the procedure with its caller and callee, but only once
+    watcher.m_processed.clear();
+    remover.scheduleWithNeighbours(proc);
+    remover.scheduleWithNeighbours(proc);
+    QCOMPARE(remover.getStats().numRequeued, 3);
+
+    // The requeues before the round are still counted after the round
+    QVERIFY(!remover.removeUnusedReturns());
+    QCOMPARE(watcher.m_processed, std::vector<UserProc *>({ caller, proc, callee }));
+    QCOMPARE(remover.getStats().numProcessed, 3);
+    QCOMPARE(remover.getStats().numRequeued, 3);
+
+    // Unrelated procedures are not requeued
+    QVERIFY(std::find(watcher.m_processed.begin(), watcher.m_processed.end(), other) ==
+            watcher.m_processed.end());
+}
+
+
+QTEST_GUILESS_MAIN(UnusedReturnRemoverTest)
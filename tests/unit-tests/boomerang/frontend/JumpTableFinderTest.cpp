@@ -0,0 +1,213 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "JumpTableFinderTest.h"
+
+
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/db/binary/BinarySymbolTable.h"
+#include "boomerang/frontend/JumpTableFinder.h"
+#include "boomerang/ifc/IFileLoader.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/util/ByteUtil.h"
+
+#include <QByteArray>
+
+#include <set>
+
+
+namespace
+{
+class TestLoader : public IFileLoader
+{
+public:
+    TestLoader()
+        : IFileLoader(nullptr)
+    {
+    }
+
+public:
+    void initialize(BinaryFile *, BinarySymbolTable *) override {}
+    int canLoad(QIODevice &) const override { return 0; }
+    bool loadFromMemory(QByteArray &) override { return true; }
+    void unload() override {}
+    void close() override {}
+    LoadFmt getFormat() const override { return LoadFmt::INVALID; }
+    Machine getMachine() const override { return Machine::INVALID; }
+    Address getMainEntryPoint() override { return Address::INVALID; }
+    Address getEntryPoint() override { return Address::INVALID; }
+
+    bool isRelocationAt(Address addr) override { return relocations.count(addr) > 0; }
+
+public:
+    std::set<Address> relocations;
+};
+
+
+/**
+ * Code section at 0x1000 containing a table at 0x1040,
+ * read-only data section at 0x2000 containing tables at 0x2000, 0x2040, 0x2080 and 0x20C0,
+ * data section at 0x3000.
+ */
+struct TestFile
+{
+    TestFile()
+        : code(0x100, '\x90')
+        , rodata(0x100, '\0')
+        , data(0x10, '\0')
+        , file(QByteArray{}, &loader)
+    {
+        // embedded in code, followed by code at 0x1050
+        writeTable(code.data() + 0x40, { 0x1010, 0x1050, 0x1020, 0x1030, 0x1000 });
+
+        // relocated; the entry at 0x200C is not
+        writeTable(rodata.data() + 0x00, { 0x1010, 0x1020, 0x1010, 0x1030 });
+        loader.relocations = { Address(0x2000), Address(0x2004), Address(0x2008) };
+
+        // no symbol, no relocations
+        writeTable(rodata.data() + 0x40, { 0x1010, 0x1020 });
+
+        // bounded by the symbol at 0x2088
+        writeTable(rodata.data() + 0x80, { 0x1010, 0x1020, 0x1030 });
+
+        // the next symbol is in another section
+        writeTable(rodata.data() + 0xC0, { 0x1010, 0x1020 });
+
+        BinaryImage *image = file.getImage();
+
+        BinarySection *codeSect = image->createSection(".text", Address(0x1000),
+                                                       Address(0x1100));
+        codeSect->setCode(true);
+        codeSect->setReadOnly(true);
+        codeSect->setHostAddr(HostAddress(code.data()));
+
+        BinarySection *rodataSect = image->createSection(".rodata", Address(0x2000),
+                                                         Address(0x2100));
+        rodataSect->setData(true);
+        rodataSect->setReadOnly(true);
+        rodataSect->setHostAddr(HostAddress(rodata.data()));
+
+        BinarySection *dataSect = image->createSection(".data", Address(0x3000),
+                                                       Address(0x3010));
+        dataSect->setData(true);
+        dataSect->setReadOnly(true);
+        dataSect->setHostAddr(HostAddress(data.data()));
+
+        BinarySymbolTable *symbols = file.getSymbols();
+        symbols->createSymbol(Address(0x2080), "table1");
+        symbols->createSymbol(Address(0x2088), "after_table1");
+        symbols->createSymbol(Address(0x20C0), "table2");
+        symbols->createSymbol(Address(0x3000), "data");
+    }
+
+    static void writeTable(char *p, std::initializer_list<DWord> entries)
+    {
+        for (DWord entry : entries) {
+            Util::writeDWord(p, entry, Endian::Little);
+            p += 4;
+        }
+    }
+
+    TestLoader loader;
+    QByteArray code;
+    QByteArray rodata;
+    QByteArray data;
+    BinaryFile file;
+};
+
+
+/// m[r24 * scale + table]
+SharedExp tableJump(int scale, Address table)
+{
+    return Location::memOf(
+        Binary::get(opPlus, Binary::get(opMult, Location::regOf(REG_X86_EAX), Const::get(scale)),
+                    Const::get(table)));
+}
+}
+
+
+void JumpTableFinderTest::testFindTableAddr()
+{
+    QCOMPARE(JumpTableFinder::findTableAddr(tableJump(4, Address(0x2000))), Address(0x2000));
+
+    // m[0x2000 + r24 * 4]
+    SharedExp swapped = Location::memOf(
+        Binary::get(opPlus, Const::get(Address(0x2000)),
+                    Binary::get(opMult, Location::regOf(REG_X86_EAX), Const::get(4))));
+    QCOMPARE(JumpTableFinder::findTableAddr(swapped), Address(0x2000));
+
+    QCOMPARE(JumpTableFinder::findTableAddr(tableJump(2, Address(0x2000))), Address::INVALID);
+    QCOMPARE(JumpTableFinder::findTableAddr(nullptr), Address::INVALID);
+    QCOMPARE(JumpTableFinder::findTableAddr(Location::regOf(REG_X86_EAX)), Address::INVALID);
+
+    // m[r24 + 0x2000]
+    SharedExp noScale = Location::memOf(
+        Binary::get(opPlus, Location::regOf(REG_X86_EAX), Const::get(Address(0x2000))));
+    QCOMPARE(JumpTableFinder::findTableAddr(noScale), Address::INVALID);
+
+    // m[r24 * 4 + r25]
+    SharedExp noTable = Location::memOf(
+        Binary::get(opPlus, Binary::get(opMult, Location::regOf(REG_X86_EAX), Const::get(4)),
+                    Location::regOf(REG_X86_ECX)));
+    QCOMPARE(JumpTableFinder::findTableAddr(noTable), Address::INVALID);
+}
+
+
+void JumpTableFinderTest::testRelocatedTable()
+{
+    TestFile tf;
+    JumpTableFinder finder(&tf.file);
+
+    const std::vector<Address> expected = { Address(0x1010), Address(0x1020) };
+    QCOMPARE(finder.findTargets(tableJump(4, Address(0x2000))), expected);
+}
+
+
+void JumpTableFinderTest::testCodeTable()
+{
+    TestFile tf;
+    JumpTableFinder finder(&tf.file);
+
+    const std::vector<Address> expected = { Address(0x1010), Address(0x1020), Address(0x1030),
+                                            Address(0x1050) };
+    QCOMPARE(finder.findTargets(tableJump(4, Address(0x1040))), expected);
+}
+
+
+void JumpTableFinderTest::testSymbolTable()
+{
+    TestFile tf;
+    JumpTableFinder finder(&tf.file);
+
+    const std::vector<Address> expected = { Address(0x1010), Address(0x1020) };
+    QCOMPARE(finder.findTargets(tableJump(4, Address(0x2080))), expected);
+}
+
+
+void JumpTableFinderTest::testUnboundedTable()
+{
+    TestFile tf;
+    JumpTableFinder finder(&tf.file);
+
+    // no symbol at the table, although there is one after it
+    QVERIFY(finder.findTargets(tableJump(4, Address(0x2040))).empty());
+
+    // the next symbol is not in the same section as the table
+    QVERIFY(finder.findTargets(tableJump(4, Address(0x20C0))).empty());
+
+    // not a table in the image
+    QVERIFY(finder.findTargets(tableJump(4, Address(0x5000))).empty());
+}
+
+
+QTEST_GUILESS_MAIN(JumpTableFinderTest)
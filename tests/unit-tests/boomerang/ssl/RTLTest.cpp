@@ -43,6 +43,54 @@ void RTLTest::testAppend()
 }
 
 
+void RTLTest::testFind()
+{
+    std::shared_ptr<Assign> a1(new Assign(Location::regOf(REG_X86_EAX), Const::get(1)));
+    std::shared_ptr<Assign> a2(new Assign(Location::regOf(REG_X86_ECX), Const::get(2)));
+    std::shared_ptr<Assign> a3(new Assign(Location::regOf(REG_X86_EDX), Const::get(3)));
+
+    {
+        RTL rtl(Address(0x1000), { a1, a2 });
+        QVERIFY(a1->getRTL() == &rtl);
+        QVERIFY(rtl.find(a1) == rtl.begin());
+        QVERIFY(rtl.find(a2) == std::next(rtl.begin()));
+        QVERIFY(rtl.find(a3) == rtl.end());
+        QVERIFY(rtl.find(nullptr) == rtl.end());
+
+        rtl.insert(std::next(rtl.find(a1)), a3);
+        QVERIFY(a3->getRTL() == &rtl);
+        QVERIFY(rtl.find(a3) == std::next(rtl.begin()));
+
+        rtl.erase(rtl.find(a3));
+        QVERIFY(a3->getRTL() == nullptr);
+        QVERIFY(rtl.find(a3) == rtl.end());
+        QCOMPARE(rtl.size(), static_cast<RTL::size_type>(2));
+
+        rtl.replace(rtl.find(a2), a3);
+        QVERIFY(a2->getRTL() == nullptr);
+        QVERIFY(rtl.find(a2) == rtl.end());
+        QVERIFY(rtl.find(a3) == std::next(rtl.begin()));
+
+        // a1 is part of both RTLs, but only knows its position in the second one
+        RTL other(Address(0x1004), { a1 });
+        QVERIFY(a1->getRTL() == &other);
+        QVERIFY(rtl.find(a1) == rtl.begin());
+        QVERIFY(other.find(a1) == other.begin());
+
+        RTL moved(std::move(rtl));
+        QVERIFY(a3->getRTL() == &moved);
+        QVERIFY(moved.find(a3) == std::next(moved.begin()));
+    }
+
+    QVERIFY(a1->getRTL() == nullptr);
+    QVERIFY(a3->getRTL() == nullptr);
+
+    // copies are not part of any RTL
+    SharedStmt clone = a1->clone();
+    QVERIFY(clone->getRTL() == nullptr);
+}
+
+
 class StmtVisitorStub : public StmtVisitor
 {
 public:
@@ -24,6 +24,9 @@ private slots:
     /// Test appendExp and printing of RTLs
     void testAppend();
 
+    /// Test that statements know their position in the RTL they are part of
+    void testFind();
+
     /// Test the accept function for correct visiting behaviour.
     /// \note Stub class to test.
     void testVisitor();
@@ -180,6 +180,40 @@ void RegDBTest::testCreateRegRelation()
 }
 
 
+void RegDBTest::testGetOverlappingRegs()
+{
+    RegDB db;
+
+    QVERIFY(db.createReg(RegType::Int, REG_X86_EAX, "%eax", 32));
+    QVERIFY(db.createReg(RegType::Int, REG_X86_AX, "%ax",   16));
+    QVERIFY(db.createReg(RegType::Int, REG_X86_AH, "%ah",    8));
+    QVERIFY(db.createReg(RegType::Int, REG_X86_AL, "%al",    8));
+    QVERIFY(db.createReg(RegType::Int, REG_X86_EDX, "%edx", 32));
+    QVERIFY(db.createRegRelation("%eax", "%ax", 0));
+    QVERIFY(db.createRegRelation("%ax",  "%al", 0));
+    QVERIFY(db.createRegRelation("%ax",  "%ah", 8));
+
+    QVERIFY(db.getCoveredRegs(REG_X86_EAX) == std::set<RegNum>({ REG_X86_AX, REG_X86_AH, REG_X86_AL }));
+    QVERIFY(db.getCoveredRegs(REG_X86_AX)  == std::set<RegNum>({ REG_X86_AH, REG_X86_AL }));
+    QVERIFY(db.getCoveredRegs(REG_X86_AL).empty());
+    QVERIFY(db.getCoveredRegs(REG_X86_EDX).empty());
+    QVERIFY(db.getCoveredRegs(REG_X86_ESI).empty());
+
+    QVERIFY(db.getOverlappingRegs(REG_X86_EAX) == std::set<RegNum>({ REG_X86_AX, REG_X86_AH, REG_X86_AL }));
+    QVERIFY(db.getOverlappingRegs(REG_X86_AX)  == std::set<RegNum>({ REG_X86_EAX, REG_X86_AH, REG_X86_AL }));
+    QVERIFY(db.getOverlappingRegs(REG_X86_AH)  == std::set<RegNum>({ REG_X86_EAX, REG_X86_AX }));
+    QVERIFY(db.getOverlappingRegs(REG_X86_EDX).empty());
+    QVERIFY(db.getOverlappingRegs(REG_X86_ESI).empty());
+
+    // relations are removed as well
+    db.clear();
+    QVERIFY(db.createReg(RegType::Int, REG_X86_EAX, "%eax", 32));
+    QVERIFY(db.createReg(RegType::Int, REG_X86_AX, "%ax",   16));
+    QVERIFY(db.getOverlappingRegs(REG_X86_EAX).empty());
+    QVERIFY(db.createRegRelation("%eax", "%ax", 0));
+}
+
+
 void RegDBTest::testProcessOverlappedRegs()
 {
     RegDB db;
@@ -29,5 +29,6 @@ private slots:
     void testGetRegSizeByNum();
     void testCreateReg();
     void testCreateRegRelation();
+    void testGetOverlappingRegs();
     void testProcessOverlappedRegs();
 };
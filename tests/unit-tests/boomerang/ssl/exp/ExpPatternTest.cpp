@@ -0,0 +1,136 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ExpPatternTest.h"
+
+
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/ExpPattern.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/statements/Assign.h"
+
+
+void ExpPatternTest::testMatches()
+{
+    // m[r28 + 4]
+    SharedExp exp = Location::memOf(
+        Binary::get(opPlus, Location::regOf(REG_X86_ESP), Const::get(4)));
+
+    QVERIFY(ExpPattern(*exp).matches(*exp));
+    QVERIFY(ExpPattern(*exp->clone()).matches(*exp));
+    QVERIFY(ExpPattern(*Terminal::get(opWild)).matches(*exp));
+    QVERIFY(ExpPattern(*Terminal::get(opWildMemOf)).matches(*exp));
+    QVERIFY(!ExpPattern(*Terminal::get(opWildRegOf)).matches(*exp));
+
+    // m[? + K]
+    SharedExp pattern = Location::memOf(
+        Binary::get(opPlus, Terminal::get(opWild), Terminal::get(opWildIntConst)));
+    QVERIFY(ExpPattern(*pattern).matches(*exp));
+    QCOMPARE(ExpPattern(*pattern).getProgramSize(), 4);
+
+    // m[r28 - 4]
+    SharedExp minus = Location::memOf(
+        Binary::get(opMinus, Location::regOf(REG_X86_ESP), Const::get(4)));
+    QVERIFY(!ExpPattern(*pattern).matches(*minus));
+
+    // m[r28 + 8]
+    SharedExp exp8 = Location::memOf(
+        Binary::get(opPlus, Location::regOf(REG_X86_ESP), Const::get(8)));
+    QVERIFY(!ExpPattern(*exp).matches(*exp8));
+
+    // r28{-} only matches references with a wildcard definition or the same definition
+    SharedStmt def(new Assign(Location::regOf(REG_X86_ESP), Const::get(0)));
+    SharedExp ref     = RefExp::get(Location::regOf(REG_X86_ESP), def);
+    SharedExp wildRef = RefExp::get(Location::regOf(REG_X86_ESP), STMT_WILD);
+    QVERIFY(ExpPattern(*wildRef).matches(*ref));
+    QVERIFY(ExpPattern(*ref).matches(*ref));
+    QVERIFY(!ExpPattern(*ref).matches(*Location::regOf(REG_X86_ESP)));
+}
+
+
+void ExpPatternTest::testMatchesNoSubscript()
+{
+    SharedStmt def(new Assign(Location::regOf(REG_X86_ESP), Const::get(0)));
+
+    // m[r28{1} + 4]{-}
+    SharedExp exp = RefExp::get(
+        Location::memOf(
+            Binary::get(opPlus, RefExp::get(Location::regOf(REG_X86_ESP), def), Const::get(4))),
+        nullptr);
+
+    SharedExp pattern = Location::memOf(
+        Binary::get(opPlus, Location::regOf(REG_X86_ESP), Terminal::get(opWildIntConst)));
+
+    QVERIFY(!ExpPattern(*pattern).matches(*exp));
+    QVERIFY(ExpPattern(*pattern, ExpPattern::Mode::NoSubscript).matches(*exp));
+    QCOMPARE(ExpPattern(*pattern, ExpPattern::Mode::NoSubscript).matches(*exp),
+             exp->equalNoSubscript(*pattern));
+}
+
+
+void ExpPatternTest::testFindFirstMatch()
+{
+    ExpPatternSet set(ExpPattern::Mode::NoSubscript);
+
+    // m[m[?] + K]
+    QCOMPARE(set.addPattern(Location::memOf(Binary::get(
+                 opPlus, Location::memOf(Terminal::get(opWild)), Terminal::get(opWildIntConst)))),
+             0);
+    // m[m[?]]
+    QCOMPARE(set.addPattern(Location::memOf(Location::memOf(Terminal::get(opWild)))), 1);
+    // m[?]
+    QCOMPARE(set.addPattern(Location::memOf(Terminal::get(opWild))), 2);
+    QCOMPARE(set.getNumPatterns(), 3);
+
+    SharedExp r24 = Location::regOf(REG_X86_EAX);
+
+    QCOMPARE(set.findFirstMatch(*Location::memOf(Binary::get(
+                 opPlus, Location::memOf(r24->clone()), Const::get(8)))),
+             0);
+    QCOMPARE(set.findFirstMatch(*Location::memOf(Location::memOf(r24->clone()))), 1);
+    QCOMPARE(set.findFirstMatch(*RefExp::get(Location::memOf(r24->clone()), nullptr)), 2);
+    QCOMPARE(set.findFirstMatch(*r24), -1);
+
+    // m[m[r24] - 8] only matches the last pattern
+    QCOMPARE(set.findFirstMatch(*Location::memOf(Binary::get(
+                 opMinus, Location::memOf(r24->clone()), Const::get(8)))),
+             2);
+}
+
+
+void ExpPatternTest::testSearchReplace()
+{
+    // r24 + m[r24 + 4]
+    SharedExp exp = Binary::get(opPlus, Location::regOf(REG_X86_EAX),
+                                Location::memOf(Binary::get(opPlus, Location::regOf(REG_X86_EAX),
+                                                            Const::get(4))));
+
+    std::list<SharedExp> results;
+    QVERIFY(exp->searchAll(ExpPattern(*Terminal::get(opWildRegOf)), results));
+    QCOMPARE(results.size(), static_cast<size_t>(2));
+
+    SharedExp result;
+    QVERIFY(exp->search(ExpPattern(*Terminal::get(opWildIntConst)), result));
+    QCOMPARE(*result, *Const::get(4));
+
+    // Replacing a subexpression invalidates the normal form of its parent
+    exp->setNormalForm(true);
+    bool change = false;
+    exp = exp->searchReplaceAll(*Location::regOf(REG_X86_EAX), Location::regOf(REG_X86_ECX),
+                                change);
+    QVERIFY(change);
+    QVERIFY(!exp->isNormalForm());
+    QCOMPARE(exp->toString(), QString("r25 + m[r25 + 4]"));
+}
+
+
+QTEST_GUILESS_MAIN(ExpPatternTest)
@@ -0,0 +1,35 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+/**
+ * Test the ExpPattern and ExpPatternSet classes
+ */
+class ExpPatternTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    /// Test matching patterns with and without wildcards
+    void testMatches();
+
+    /// Test matching while ignoring subscripts
+    void testMatchesNoSubscript();
+
+    /// Test finding the first matching pattern of a set
+    void testFindFirstMatch();
+
+    /// Test searching and replacing using compiled patterns
+    void testSearchReplace();
+};
@@ -11,6 +11,7 @@
 
 
 #include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/ExpPattern.h"
 #include "boomerang/ssl/exp/Location.h"
 #include "boomerang/ssl/exp/Ternary.h"
 #include "boomerang/ssl/type/IntegerType.h"
@@ -193,6 +194,19 @@ void AssignTest::testSearchAndReplace()
         QVERIFY(asgn1->searchAndReplace(*Location::regOf(REG_X86_EAX), Location::regOf(REG_X86_ECX)));
         QCOMPARE(asgn1->toString(), asgn2->toString());
     }
+
+    {
+        // the same compiled pattern for several statements
+        const ExpPattern pattern(Location::regOf(REG_X86_EAX));
+        std::shared_ptr<Assign> asgn1(new Assign(Location::regOf(REG_X86_EAX), Location::regOf(REG_X86_EDX)));
+        std::shared_ptr<Assign> asgn2(new Assign(Location::regOf(REG_X86_EDX), Location::regOf(REG_X86_EAX)));
+
+        QVERIFY(asgn1->searchAndReplace(pattern, Location::regOf(REG_X86_ECX)));
+        QVERIFY(asgn2->searchAndReplace(pattern, Location::regOf(REG_X86_ECX)));
+        QVERIFY(!asgn2->searchAndReplace(pattern, Location::regOf(REG_X86_ECX)));
+        QCOMPARE(asgn1->toString(), Assign(Location::regOf(REG_X86_ECX), Location::regOf(REG_X86_EDX)).toString());
+        QCOMPARE(asgn2->toString(), Assign(Location::regOf(REG_X86_EDX), Location::regOf(REG_X86_ECX)).toString());
+    }
 }
 
 
@@ -0,0 +1,117 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "StackFrameLayoutTest.h"
+
+
+#include "boomerang/type/StackFrameLayout.h"
+#include "boomerang/ssl/type/ArrayType.h"
+#include "boomerang/ssl/type/CompoundType.h"
+#include "boomerang/ssl/type/IntegerType.h"
+
+
+void StackFrameLayoutTest::testIsClear()
+{
+    StackFrameLayout layout;
+
+    QVERIFY(layout.isClear(-16, 16));
+
+    layout.insertSlot(-8, "first", IntegerType::get(32, Sign::Signed));
+
+    QVERIFY(layout.isClear(-12, 4));
+    QVERIFY(!layout.isClear(-10, 4));
+    QVERIFY(!layout.isClear(-8, 4));
+    QVERIFY(!layout.isClear(-6, 8));
+    QVERIFY(layout.isClear(-4, 4));
+
+    // variable ending at sp{0}
+    layout.insertSlot(-4, "second", IntegerType::get(32, Sign::Signed));
+    QVERIFY(!layout.isClear(-4, 4));
+    QVERIFY(layout.isClear(0, 4));
+}
+
+
+void StackFrameLayoutTest::testFind()
+{
+    StackFrameLayout layout;
+
+    QVERIFY(layout.find(-8) == nullptr);
+
+    layout.insertSlot(-8, "first", IntegerType::get(32, Sign::Signed));
+    layout.insertSlot(-16, "second", IntegerType::get(16, Sign::Signed));
+
+    QVERIFY(layout.find(-9) == nullptr);
+    QVERIFY(layout.find(-4) == nullptr);
+    QVERIFY(layout.find(-14) == nullptr);
+
+    QVERIFY(layout.find(-8) != nullptr);
+    QCOMPARE(layout.find(-8)->name, QString("first"));
+    QCOMPARE(layout.find(-5)->name, QString("first"));
+    QCOMPARE(layout.find(-15)->name, QString("second"));
+
+    // slots are sorted by offset
+    QCOMPARE(layout.begin()->name, QString("second"));
+}
+
+
+void StackFrameLayoutTest::testInsert()
+{
+    StackFrameLayout layout;
+
+    const FrameSlot *slot = layout.insertSlot(-8, "first", IntegerType::get(32, Sign::Signed));
+    QVERIFY(slot != nullptr);
+    QCOMPARE(slot->offset, -8);
+    QCOMPARE(slot->size, Type::Size(4));
+    QCOMPARE(slot->name, QString("first"));
+    QCOMPARE(slot->type->toString(), IntegerType::get(32, Sign::Signed)->toString());
+
+    // same variable again -> types are met
+    QVERIFY(layout.insertSlot(-8, "first", IntegerType::get(32, Sign::Unknown)) != nullptr);
+    QCOMPARE(layout.getNumSlots(), 1);
+
+    // overlapped non-forced
+    QVERIFY(layout.insertSlot(-6, "second", IntegerType::get(32, Sign::Signed)) == nullptr);
+    QCOMPARE(layout.toString(), QString("-8..-4 first int\n"));
+
+    // overlapped forced
+    QVERIFY(layout.insertSlot(-6, "second", IntegerType::get(32, Sign::Signed), true) != nullptr);
+    QCOMPARE(layout.toString(), QString("-6..-2 second int\n"));
+}
+
+
+void StackFrameLayoutTest::testInsertCompound()
+{
+    StackFrameLayout layout;
+
+    layout.insertSlot(-4, "b", IntegerType::get(32, Sign::Signed));
+
+    // a structure containing an existing variable replaces it
+    std::shared_ptr<CompoundType> ty = CompoundType::get();
+    ty->addMember(IntegerType::get(32, Sign::Signed), "a");
+    ty->addMember(IntegerType::get(32, Sign::Signed), "b");
+
+    const FrameSlot *slot = layout.insertSlot(-8, "s", ty);
+    QVERIFY(slot != nullptr);
+    QCOMPARE(layout.getNumSlots(), 1);
+    QCOMPARE(slot->name, QString("s"));
+    QCOMPARE(slot->size, Type::Size(8));
+
+    // a member of an existing structure does not create a new variable
+    QVERIFY(layout.insertSlot(-8, "a", IntegerType::get(32, Sign::Signed)) != nullptr);
+    QCOMPARE(layout.getNumSlots(), 1);
+
+    // same for array elements
+    layout.insertSlot(-24, "arr", ArrayType::get(IntegerType::get(32, Sign::Signed), 4));
+    QVERIFY(layout.insertSlot(-20, "elem", IntegerType::get(32, Sign::Signed)) != nullptr);
+    QCOMPARE(layout.getNumSlots(), 2);
+    QCOMPARE(layout.find(-20)->name, QString("arr"));
+}
+
+
+QTEST_GUILESS_MAIN(StackFrameLayoutTest)
@@ -0,0 +1,121 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "AsyncLogWriterTest.h"
+
+
+#include "boomerang/util/log/AsyncLogWriter.h"
+
+#include <thread>
+
+
+static LogRecord makeRecord(int line, const QString &msg)
+{
+    LogRecord record;
+    record.file = __FILE__;
+    record.line = line;
+    record.msg  = msg;
+    return record;
+}
+
+
+void AsyncLogWriterTest::testRingBuffer()
+{
+    LogRingBuffer buffer(3);
+    QCOMPARE(buffer.getCapacity(), std::size_t(4));
+    QVERIFY(buffer.isEmpty());
+
+    for (int i = 0; i < 4; i++) {
+        LogRecord record = makeRecord(i, "foo");
+        QVERIFY(buffer.tryPush(record));
+    }
+
+    // full; the record must not be consumed
+    LogRecord record = makeRecord(4, "bar");
+    QVERIFY(!buffer.tryPush(record));
+    QCOMPARE(record.msg, QString("bar"));
+
+    LogRecord popped;
+    QVERIFY(buffer.tryPop(popped));
+    QCOMPARE(popped.line, 0);
+    QVERIFY(buffer.tryPush(record));
+
+    for (int i = 1; i < 5; i++) {
+        QVERIFY(buffer.tryPop(popped));
+        QCOMPARE(popped.line, i);
+    }
+
+    QVERIFY(buffer.isEmpty());
+    QVERIFY(!buffer.tryPop(popped));
+}
+
+
+void AsyncLogWriterTest::testFlush()
+{
+    std::vector<int> lines;
+    int numIdle = 0;
+
+    {
+        AsyncLogWriter writer([&lines](const LogRecord &record) { lines.push_back(record.line); },
+                              [&numIdle]() { numIdle++; }, 16);
+
+        for (int i = 0; i < 1000; i++) {
+            writer.push(makeRecord(i, "msg"), false);
+        }
+
+        writer.flush();
+        QCOMPARE(lines.size(), std::size_t(1000));
+        QVERIFY(numIdle > 0);
+        QCOMPARE(writer.getNumDropped(), 0);
+
+        for (int i = 0; i < 1000; i++) {
+            QCOMPARE(lines[i], i);
+        }
+
+        writer.push(makeRecord(1000, "last"), false);
+    }
+
+    // destroying the writer writes pending records
+    QCOMPARE(lines.size(), std::size_t(1001));
+}
+
+
+void AsyncLogWriterTest::testMultipleThreads()
+{
+    const int numRecords = 500;
+    std::vector<int> lines[2];
+
+    AsyncLogWriter writer(
+        [&lines](const LogRecord &record) { lines[record.msg.toInt()].push_back(record.line); },
+        nullptr, 8);
+
+    auto producer = [&writer](int id) {
+        for (int i = 0; i < numRecords; i++) {
+            writer.push(makeRecord(i, QString::number(id)), false);
+        }
+    };
+
+    std::thread t0(producer, 0);
+    std::thread t1(producer, 1);
+    t0.join();
+    t1.join();
+    writer.flush();
+
+    // Records of a single thread are written in order
+    for (int id = 0; id < 2; id++) {
+        QCOMPARE(lines[id].size(), std::size_t(numRecords));
+
+        for (int i = 0; i < numRecords; i++) {
+            QCOMPARE(lines[id][i], i);
+        }
+    }
+}
+
+
+QTEST_GUILESS_MAIN(AsyncLogWriterTest)
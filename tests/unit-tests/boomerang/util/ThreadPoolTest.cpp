@@ -0,0 +1,102 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ThreadPoolTest.h"
+
+
+#include "boomerang/util/ThreadPool.h"
+
+#include <atomic>
+#include <stdexcept>
+
+
+void ThreadPoolTest::testSerial()
+{
+    ThreadPool pool(1);
+    QCOMPARE(pool.getNumThreads(), 1);
+
+    // tasks are run in order on the calling thread
+    std::vector<std::size_t> order;
+    const std::thread::id caller = std::this_thread::get_id();
+    bool sameThread              = true;
+
+    pool.forEach(5, [&](std::size_t i) {
+        order.push_back(i);
+        sameThread = sameThread && std::this_thread::get_id() == caller;
+    });
+
+    QCOMPARE(order, std::vector<std::size_t>({ 0, 1, 2, 3, 4 }));
+    QVERIFY(sameThread);
+}
+
+
+void ThreadPoolTest::testForEach()
+{
+    ThreadPool pool(4);
+    QCOMPARE(pool.getNumThreads(), 4);
+
+    std::vector<int> results(1000, -1);
+    pool.forEach(results.size(),
+                 [&results](std::size_t i) { results[i] = static_cast<int>(i * i); });
+
+    for (std::size_t i = 0; i < results.size(); i++) {
+        QCOMPARE(results[i], static_cast<int>(i * i));
+    }
+
+    // no tasks at all
+    pool.forEach(0, [](std::size_t) { QFAIL("No task must be run"); });
+}
+
+
+void ThreadPoolTest::testManyBatches()
+{
+    ThreadPool pool(3);
+    std::atomic<int> numRun{ 0 };
+    int expected = 0;
+
+    for (int batch = 0; batch < 500; batch++) {
+        const std::size_t numTasks = batch % 7;
+        pool.forEach(numTasks, [&numRun](std::size_t) { numRun++; });
+
+        expected += static_cast<int>(numTasks);
+        QCOMPARE(numRun.load(), expected);
+    }
+}
+
+
+void ThreadPoolTest::testException()
+{
+    ThreadPool pool(4);
+    std::atomic<int> numRun{ 0 };
+
+    // the exception is rethrown on the calling thread, wherever it was thrown
+    bool caught = false;
+    try {
+        pool.forEach(1000, [&numRun](std::size_t i) {
+            numRun++;
+            if (i == 10) {
+                throw std::runtime_error("task failed");
+            }
+        });
+    }
+    catch (const std::runtime_error &err) {
+        caught = QString(err.what()) == "task failed";
+    }
+
+    QVERIFY(caught);
+    QVERIFY(numRun.load() <= 1000);
+
+    // the pool is still usable afterwards
+    numRun = 0;
+    pool.forEach(100, [&numRun](std::size_t) { numRun++; });
+    QCOMPARE(numRun.load(), 100);
+}
+
+
+QTEST_GUILESS_MAIN(ThreadPoolTest)
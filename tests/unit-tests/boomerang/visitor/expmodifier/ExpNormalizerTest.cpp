@@ -0,0 +1,110 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ExpNormalizerTest.h"
+
+
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/visitor/expmodifier/ExpNormalizer.h"
+
+
+void ExpNormalizerTest::testNormalize()
+{
+    // ((r24 + 4) + 8) - 0 -> r24 + 12
+    SharedExp sum = Binary::get(opPlus, Location::regOf(REG_X86_EAX), Const::get(4));
+    SharedExp exp = Binary::get(opMinus, Binary::get(opPlus, sum, Const::get(8)), Const::get(0));
+
+    SharedExp result = ExpNormalizer().normalize(exp);
+    QCOMPARE(result->toString(), QString("r24 + 12"));
+
+    // 5 * (r24 << 2) -> r24 * 4 * 5 -> r24 * 20 (constant on the RHS)
+    exp = Binary::get(opMult, Const::get(5),
+                      Binary::get(opShL, Location::regOf(REG_X86_EAX), Const::get(2)));
+    result = ExpNormalizer().normalize(exp);
+    QCOMPARE(result->toString(), QString("r24 * 20"));
+}
+
+
+void ExpNormalizerTest::testNormalForm()
+{
+    SharedExp exp = Binary::get(opPlus, Location::regOf(REG_X86_EAX),
+                                Binary::get(opMult, Location::regOf(REG_X86_ECX), Const::get(4)));
+
+    QVERIFY(!exp->isNormalForm());
+    exp = exp->simplify();
+
+    QVERIFY(exp->isNormalForm());
+    QVERIFY(exp->getSubExp1()->isNormalForm());
+    QVERIFY(exp->getSubExp2()->isNormalForm());
+    QVERIFY(exp->access<Exp, 2, 2>()->isNormalForm());
+
+    // Simplifying again does not apply any rules
+    ExpNormalizer::resetStatistics();
+    {
+        SharedExp same = ExpNormalizer().normalize(exp);
+        QVERIFY(same == exp);
+    }
+
+    QCOMPARE(ExpNormalizer::getNumRuleChecks(), uint64(0));
+    QVERIFY(ExpNormalizer::getNumSkipped() > 0);
+}
+
+
+void ExpNormalizerTest::testMutation()
+{
+    SharedExp exp = Binary::get(opPlus, Location::regOf(REG_X86_EAX),
+                                Binary::get(opMult, Location::regOf(REG_X86_ECX), Const::get(4)));
+    exp = exp->simplify();
+    QVERIFY(exp->isNormalForm());
+
+    // Mutating a subexpression in place must make the parent be looked at again
+    exp->access<Const, 2, 2>()->setInt(0);
+    QVERIFY(!exp->access<Exp, 2, 2>()->isNormalForm());
+    QVERIFY(exp->isNormalForm());
+
+    exp = exp->simplify();
+    QCOMPARE(exp->toString(), QString("r24"));
+    QVERIFY(exp->isNormalForm());
+
+    // Replacing a subexpression by another normalized expression
+    SharedExp sum = Binary::get(opPlus, Location::regOf(REG_X86_EAX),
+                                Location::regOf(REG_X86_ECX));
+    sum            = sum->simplify();
+    SharedExp zero = Const::get(0)->simplify();
+    QVERIFY(sum->isNormalForm() && zero->isNormalForm());
+
+    sum->setSubExp2(zero);
+    QVERIFY(!sum->isNormalForm());
+    QCOMPARE(sum->simplify()->toString(), QString("r24"));
+
+    // setOper
+    SharedExp cmp = Binary::get(opEquals, Location::regOf(REG_X86_EAX), Const::get(1))->simplify();
+    QVERIFY(cmp->isNormalForm());
+    cmp->setOper(opLessUns);
+    QVERIFY(!cmp->isNormalForm());
+}
+
+
+void ExpNormalizerTest::testRuleHits()
+{
+    ExpNormalizer::resetStatistics();
+
+    {
+        SharedExp exp = Binary::get(opPlus, Const::get(2), Const::get(3));
+        QCOMPARE(ExpNormalizer().normalize(exp)->toString(), QString("5"));
+    }
+
+    QCOMPARE(ExpNormalizer::getNumRuleHits(opPlus), uint64(1));
+    QCOMPARE(ExpNormalizer::getNumRuleHits(opMinus), uint64(0));
+    QCOMPARE(ExpNormalizer::getNumRuleChecks(), uint64(1));
+}
+
+
+QTEST_GUILESS_MAIN(ExpNormalizerTest)